@@ -49,6 +49,7 @@ OBJ_GUI_EXTRA = \
 	$(BUILD_DIR)/img_vst_logo.o
 
 UPGRADE_PATCH = $(BUILD_DIR)/upgrade-patch-$(SUFFIX)
+RENDER = $(BUILD_DIR)/js80p-render-$(SUFFIX)
 
 $(LIB_PATH): | $(BUILD_DIR)
 	$(MKDIR) $@
@@ -121,10 +122,14 @@ TARGET_PLATFORM_LFLAGS = \
     -lxcb \
     -lxcb-render
 
+STARTUP_BENCHMARK_LFLAGS = -ldl
+RENDER_LFLAGS = -pthread
+
 LINK_FST = $(LINK_SO)
 LINK_VST3 = $(LINK_SO)
 LINK_GUI_PLAYGROUND = $(LINK_EXE)
 LINK_UPGRADE_PATCH = $(LINK_EXE)
+LINK_RENDER = $(LINK_EXE)
 
 TARGET_PLATFORM_CXXFLAGS = \
     $(ARCH_CXXFLAGS) \
@@ -41,6 +41,7 @@ $(OBJ_GUI_EXTRA): src/gui/gui.rc $(GUI_IMAGES) | $(BUILD_DIR)
 	$(WINDRES) -i $< --input-format=rc -o $@ -O coff
 
 UPGRADE_PATCH = $(BUILD_DIR)/upgrade-patch-$(SUFFIX).exe
+RENDER = $(BUILD_DIR)/js80p-render-$(SUFFIX).exe
 
 VALGRIND ?=
 
@@ -51,7 +52,11 @@ TARGET_PLATFORM_LFLAGS = -lgdi32 -luser32 -lkernel32 -municode -lcomdlg32 -lole3
 LINK_DLL = $(CPP_TARGET_PLATFORM) -Wall -shared -static
 LINK_EXE = $(CPP_TARGET_PLATFORM) -Wall -static
 
+STARTUP_BENCHMARK_LFLAGS =
+RENDER_LFLAGS =
+
 LINK_FST = $(LINK_DLL)
 LINK_VST3 = $(LINK_DLL)
 LINK_GUI_PLAYGROUND = $(LINK_EXE)
 LINK_UPGRADE_PATCH = $(LINK_EXE)
+LINK_RENDER = $(LINK_EXE)
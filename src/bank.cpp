@@ -22,6 +22,7 @@
 
 #include <algorithm>
 #include <cstring>
+#include <utility>
 
 #include "bank.hpp"
 
@@ -35,7 +36,13 @@ Bank::Program::Program(
         std::string const& name,
         std::string const& default_name,
         std::string const& serialized
-) : name(""), short_name(""), default_name(""), serialized(""), params_start(0)
+) : name(""),
+    short_name(""),
+    default_name(""),
+    serialized(""),
+    params_start(0),
+    is_compiled(false),
+    is_serialized(true)
 {
     this->default_name = truncate(sanitize_name(default_name), NAME_MAX_LENGTH);
     import_without_update(serialized);
@@ -144,7 +151,9 @@ Bank::Program::Program()
     : name(""),
     default_name(""),
     serialized(""),
-    params_start(0)
+    params_start(0),
+    is_compiled(false),
+    is_serialized(true)
 {
     update();
 }
@@ -170,6 +179,10 @@ std::string const& Bank::Program::serialize() const
 
 bool Bank::Program::is_blank() const
 {
+    if (!is_serialized) {
+        return compiled_messages.empty();
+    }
+
     return params_start == serialized.length();
 }
 
@@ -181,6 +194,110 @@ void Bank::Program::import(std::string const& serialized)
 }
 
 
+void Bank::Program::import(Synth const& synth)
+{
+    capture(synth);
+    serialize_captured(synth);
+}
+
+
+void Bank::Program::capture(Synth const& synth)
+{
+    if (compiled_messages.capacity() < Synth::ParamId::MAX_PARAM_ID) {
+        compiled_messages.reserve(Synth::ParamId::MAX_PARAM_ID);
+    }
+
+    Serializer::compile_patch(synth, compiled_messages);
+    is_compiled = true;
+    is_serialized = false;
+}
+
+
+void Bank::Program::import(Serializer::BinaryProgram& program)
+{
+    compiled_messages.swap(program.messages);
+
+    if (compiled_messages.capacity() < Synth::ParamId::MAX_PARAM_ID) {
+        compiled_messages.reserve(Synth::ParamId::MAX_PARAM_ID);
+    }
+
+    is_compiled = true;
+    is_serialized = false;
+    serialized.erase(params_start);
+    set_name(program.name);
+}
+
+
+void Bank::Program::serialize_captured(Synth const& synth)
+{
+    if (is_serialized) {
+        return;
+    }
+
+    std::string const patch = Serializer::serialize(synth, compiled_messages);
+    std::string::size_type const header_end = patch.find(Serializer::LINE_END);
+
+    serialized.erase(params_start);
+
+    if (header_end != std::string::npos) {
+        serialized.append(patch, header_end + Serializer::LINE_END.length());
+    }
+
+    is_serialized = true;
+}
+
+
+void Bank::Program::compile(Synth const& synth)
+{
+    if (is_compiled) {
+        return;
+    }
+
+    Serializer::compile_patch(synth, serialized, compiled_messages);
+
+    /* Make room for importing the synth's state without allocation. */
+    if (compiled_messages.capacity() < Synth::ParamId::MAX_PARAM_ID) {
+        compiled_messages.reserve(Synth::ParamId::MAX_PARAM_ID);
+    }
+
+    is_compiled = true;
+}
+
+
+Serializer::Messages const* Bank::Program::get_compiled_messages() const
+{
+    return is_compiled ? &compiled_messages : NULL;
+}
+
+
+std::string Bank::Program::serialize_binary(Synth const& synth) const
+{
+    std::string serialized;
+
+    Serializer::serialize_binary_header(synth, 1, serialized);
+    serialize_binary(synth, serialized);
+
+    return serialized;
+}
+
+
+void Bank::Program::serialize_binary(
+        Synth const& synth,
+        std::string& serialized
+) const {
+    if (is_compiled) {
+        Serializer::serialize_binary_program(name, compiled_messages, serialized);
+
+        return;
+    }
+
+    Serializer::Messages messages;
+
+    Serializer::compile_patch(synth, this->serialized, messages);
+    Serializer::serialize_binary_program(name, messages, serialized);
+}
+
+
 void Bank::Program::import_without_update(std::string const& serialized)
 {
     Serializer::Lines* lines = Serializer::parse_lines(serialized);
@@ -205,6 +322,9 @@ void Bank::Program::import_without_update(
         Serializer::Lines::const_iterator& it,
         Serializer::Lines::const_iterator const& end
 ) {
+    is_compiled = false;
+    is_serialized = true;
+
     std::string program_name("");
     std::string serialized_params("");
     char section_name[8];
@@ -346,6 +466,22 @@ void Bank::set_current_program_index(size_t const new_index)
 }
 
 
+void Bank::compile(Synth const& synth)
+{
+    for (size_t i = 0; i != NUMBER_OF_PROGRAMS; ++i) {
+        programs[i].compile(synth);
+    }
+}
+
+
+void Bank::swap_programs(Bank& other) noexcept
+{
+    for (size_t i = 0; i != NUMBER_OF_PROGRAMS; ++i) {
+        std::swap(programs[i], other.programs[i]);
+    }
+}
+
+
 void Bank::import(std::string const& serialized_bank)
 {
     Serializer::Lines* lines = Serializer::parse_lines(serialized_bank);
@@ -363,8 +499,61 @@ void Bank::import(std::string const& serialized_bank)
 }
 
 
+void Bank::import(Synth const& synth, std::string const& serialized_bank)
+{
+    if (!Serializer::is_binary(serialized_bank)) {
+        import(serialized_bank);
+        compile(synth);
+
+        return;
+    }
+
+    Serializer::BinaryPrograms binary_programs;
+
+    Serializer::parse_binary(synth, serialized_bank, binary_programs);
+
+    size_t const imported_programs = (
+        std::min(binary_programs.size(), NUMBER_OF_PROGRAMS)
+    );
+
+    for (size_t i = 0; i != imported_programs; ++i) {
+        programs[i].import(binary_programs[i]);
+    }
+
+    generate_empty_programs(imported_programs);
+    compile(synth);
+}
+
+
+void Bank::serialize_captured_programs(Synth const& synth)
+{
+    for (size_t i = 0; i != NUMBER_OF_PROGRAMS; ++i) {
+        programs[i].serialize_captured(synth);
+    }
+}
+
+
 void Bank::import_names(std::string const& serialized_bank)
 {
+    if (Serializer::is_binary(serialized_bank)) {
+        Serializer::BinaryPrograms binary_programs;
+
+        Serializer::parse_binary_names(serialized_bank, binary_programs);
+
+        size_t const imported_programs = (
+            std::min(binary_programs.size(), NUMBER_OF_PROGRAMS)
+        );
+
+        for (size_t i = 0; i != imported_programs; ++i) {
+            programs[i].import("");
+            programs[i].set_name(binary_programs[i].name);
+        }
+
+        generate_empty_programs(imported_programs);
+
+        return;
+    }
+
     Serializer::Lines* lines = Serializer::parse_lines(serialized_bank);
     Serializer::Lines::const_iterator it = lines->begin();
     Serializer::Lines::const_iterator end = lines->end();
@@ -408,6 +597,20 @@ std::string Bank::serialize() const
     return result;
 }
 
+
+std::string Bank::serialize_binary(Synth const& synth) const
+{
+    std::string result;
+
+    Serializer::serialize_binary_header(synth, (uint32_t)NUMBER_OF_PROGRAMS, result);
+
+    for (size_t i = 0; i != NUMBER_OF_PROGRAMS; ++i) {
+        programs[i].serialize_binary(synth, result);
+    }
+
+    return result;
+}
+
 }
 
 #endif
@@ -25,6 +25,7 @@
 
 #include "js80p.hpp"
 #include "serializer.hpp"
+#include "synth.hpp"
 
 
 namespace JS80P
@@ -68,6 +69,68 @@ class Bank
                     Serializer::Lines::const_iterator const& end
                 );
 
+                /**
+                 * \brief Import the current state of the synth, and also keep
+                 *        it compiled (see compile()).
+                 */
+                void import(Synth const& synth);
+
+                /**
+                 * \brief Capture the current state of the synth as compiled
+                 *        messages only, without serializing it, so that it
+                 *        can be done in the audio thread. Does not allocate
+                 *        memory once compile() or capture() has made room for
+                 *        the messages. The text form (see serialize()) is
+                 *        brought up to date by serialize_captured().
+                 */
+                void capture(Synth const& synth);
+
+                /**
+                 * \brief Import a program from a binary patch or bank (see
+                 *        Serializer::parse_binary()) by taking over its
+                 *        messages, so that it is compiled right away. The
+                 *        text form (see serialize()) is brought up to date
+                 *        by serialize_captured().
+                 */
+                void import(Serializer::BinaryProgram& program);
+
+                /**
+                 * \brief Regenerate the text form of the program from the
+                 *        messages that were captured with capture(), without
+                 *        parsing. Does nothing if nothing was captured since
+                 *        the text form was last updated.
+                 */
+                void serialize_captured(Synth const& synth);
+
+                /**
+                 * \brief Parse the program into messages in advance, so that
+                 *        it can be loaded in the audio thread without parsing
+                 *        or allocating memory. Must not be called from the
+                 *        audio thread.
+                 */
+                void compile(Synth const& synth);
+
+                /**
+                 * \brief Returns \c NULL if the program has been changed since
+                 *        it was last compiled.
+                 */
+                Serializer::Messages const* get_compiled_messages() const;
+
+                /**
+                 * \brief Serialize the program into a binary patch, see
+                 *        Serializer::serialize_binary().
+                 */
+                std::string serialize_binary(Synth const& synth) const;
+
+                /**
+                 * \brief Append the program to a binary patch or bank, see
+                 *        Serializer::serialize_binary_header().
+                 */
+                void serialize_binary(
+                    Synth const& synth,
+                    std::string& serialized
+                ) const;
+
             private:
                 std::string sanitize_name(std::string const& name) const;
 
@@ -94,6 +157,9 @@ class Bank
                 std::string default_name;
                 std::string serialized;
                 std::string::size_type params_start;
+                Serializer::Messages compiled_messages;
+                bool is_compiled;
+                bool is_serialized;
         };
 
         static constexpr size_t NUMBER_OF_PROGRAMS = 128;
@@ -114,9 +180,42 @@ class Bank
         void set_current_program_index(size_t const new_index);
 
         void import(std::string const& serialized_bank);
+
+        /**
+         * \brief Import a bank which is either in the text format, or in the
+         *        binary format (see Serializer::serialize_binary_header()),
+         *        and compile all its programs (see Program::compile()).
+         */
+        void import(Synth const& synth, std::string const& serialized_bank);
+
+        /**
+         * \brief Call Program::serialize_captured() for all programs.
+         */
+        void serialize_captured_programs(Synth const& synth);
+
         void import_names(std::string const& serialized_bank);
+
+        /**
+         * \brief Compile all programs, see Program::compile().
+         */
+        void compile(Synth const& synth);
+
+        /**
+         * \brief Exchange the programs of the two banks (but not their current
+         *        program indices) without copying them or allocating memory,
+         *        so that a bank which was imported and compiled outside the
+         *        audio thread can be loaded in the audio thread.
+         */
+        void swap_programs(Bank& other) noexcept;
+
         std::string serialize() const;
 
+        /**
+         * \brief Serialize all programs into a binary bank without going
+         *        through their text form.
+         */
+        std::string serialize_binary(Synth const& synth) const;
+
     private:
         static size_t const NUMBER_OF_BUILT_IN_PROGRAMS;
         static Program const BUILT_IN_PROGRAMS[];
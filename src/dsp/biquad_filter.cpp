@@ -43,6 +43,194 @@ BiquadFilterSharedCache::BiquadFilterSharedCache()
 }
 
 
+BiquadFilterBank::BiquadFilterBank() noexcept
+    : interleaved(NULL),
+    block_size(0),
+    sample_count(0),
+    lanes_count(0)
+{
+}
+
+
+BiquadFilterBank::~BiquadFilterBank()
+{
+    delete[] interleaved;
+}
+
+
+void BiquadFilterBank::set_block_size(Integer const new_block_size) noexcept
+{
+    if (new_block_size == block_size) {
+        return;
+    }
+
+    flush();
+
+    delete[] interleaved;
+
+    block_size = new_block_size;
+    interleaved = new SampleVector[block_size];
+}
+
+
+template<class InputSignalProducerClass>
+void BiquadFilterBank::produce(
+        BiquadFilter<InputSignalProducerClass>& filter,
+        Integer const round,
+        Integer const sample_count
+) noexcept {
+    Integer const count = filter.sample_count_or_block_size(sample_count);
+
+    /*
+    Filters which need to be rendered in multiple chunks due to their own
+    events are left to render themselves.
+    */
+    if (count > block_size || filter.has_upcoming_events(count)) {
+        SignalProducer::produce< BiquadFilter<InputSignalProducerClass> >(
+            filter, round, sample_count
+        );
+
+        return;
+    }
+
+    filter.bank = this;
+    SignalProducer::produce< BiquadFilter<InputSignalProducerClass> >(
+        filter, round, sample_count
+    );
+    filter.bank = NULL;
+}
+
+
+template<class InputSignalProducerClass>
+void BiquadFilterBank::add_lanes(
+        BiquadFilter<InputSignalProducerClass>& filter,
+        Integer const sample_count,
+        Sample** buffer
+) noexcept {
+    if (sample_count != this->sample_count) {
+        flush();
+        this->sample_count = sample_count;
+    }
+
+    BiquadFilterSharedCache const* const shared_cache = (
+        filter.can_use_shared_coefficients ? filter.shared_cache : NULL
+    );
+
+    for (Integer c = 0; c != filter.channels; ++c) {
+        Lane& lane = lanes[lanes_count];
+
+        lane.input = filter.input_buffer[c];
+        lane.output = buffer[c];
+        lane.x_n_m1 = &filter.x_n_m1[c];
+        lane.x_n_m2 = &filter.x_n_m2[c];
+        lane.y_n_m1 = &filter.y_n_m1[c];
+        lane.y_n_m2 = &filter.y_n_m2[c];
+
+        if (shared_cache != NULL) {
+            lane.b0 = shared_cache->b0_buffer[0];
+            lane.b1 = shared_cache->b1_buffer[0];
+            lane.b2 = shared_cache->b2_buffer[0];
+            lane.a1 = shared_cache->a1_buffer[0];
+            lane.a2 = shared_cache->a2_buffer[0];
+        } else {
+            lane.b0 = filter.b0_buffer[0];
+            lane.b1 = filter.b1_buffer[0];
+            lane.b2 = filter.b2_buffer[0];
+            lane.a1 = filter.a1_buffer[0];
+            lane.a2 = filter.a2_buffer[0];
+        }
+
+        ++lanes_count;
+
+        if (lanes_count == LANES) {
+            flush();
+        }
+    }
+}
+
+
+void BiquadFilterBank::flush() noexcept
+{
+    if (lanes_count == 0) {
+        return;
+    }
+
+    render_lanes();
+
+    lanes_count = 0;
+}
+
+
+void BiquadFilterBank::render_lanes() noexcept
+{
+    Integer const sample_count = this->sample_count;
+    Integer const lanes_count = this->lanes_count;
+    SampleVector* const interleaved = this->interleaved;
+
+    /* Unused lanes run on silence, and their results are thrown away. */
+    SampleVector b0 = {};
+    SampleVector b1 = {};
+    SampleVector b2 = {};
+    SampleVector a1 = {};
+    SampleVector a2 = {};
+    SampleVector x_n_m1 = {};
+    SampleVector x_n_m2 = {};
+    SampleVector y_n_m1 = {};
+    SampleVector y_n_m2 = {};
+
+    for (Integer i = 0; i != sample_count; ++i) {
+        interleaved[i] = SampleVector{};
+    }
+
+    for (Integer l = 0; l != lanes_count; ++l) {
+        Lane const& lane = lanes[l];
+        Sample const* const input = lane.input;
+
+        b0[l] = lane.b0;
+        b1[l] = lane.b1;
+        b2[l] = lane.b2;
+        a1[l] = lane.a1;
+        a2[l] = lane.a2;
+        x_n_m1[l] = *lane.x_n_m1;
+        x_n_m2[l] = *lane.x_n_m2;
+        y_n_m1[l] = *lane.y_n_m1;
+        y_n_m2[l] = *lane.y_n_m2;
+
+        for (Integer i = 0; i != sample_count; ++i) {
+            interleaved[i][l] = input[i];
+        }
+    }
+
+    for (Integer i = 0; i != sample_count; ++i) {
+        SampleVector const x_n = interleaved[i];
+        SampleVector const y_n = (
+            b0 * x_n + b1 * x_n_m1 + b2 * x_n_m2 - a1 * y_n_m1 - a2 * y_n_m2
+        );
+
+        interleaved[i] = y_n;
+
+        x_n_m2 = x_n_m1;
+        x_n_m1 = x_n;
+        y_n_m2 = y_n_m1;
+        y_n_m1 = y_n;
+    }
+
+    for (Integer l = 0; l != lanes_count; ++l) {
+        Lane const& lane = lanes[l];
+        Sample* const output = lane.output;
+
+        for (Integer i = 0; i != sample_count; ++i) {
+            output[i] = interleaved[i][l];
+        }
+
+        *lane.x_n_m1 = x_n_m1[l];
+        *lane.x_n_m2 = x_n_m2[l];
+        *lane.y_n_m1 = y_n_m1[l];
+        *lane.y_n_m2 = y_n_m2[l];
+    }
+}
+
+
 template<class InputSignalProducerClass>
 BiquadFilter<InputSignalProducerClass>::TypeParam::TypeParam(
         std::string const name
@@ -97,6 +285,8 @@ void BiquadFilter<InputSignalProducerClass>::initialize_instance() noexcept
     y_n_m1 = new Sample[this->channels];
     y_n_m2 = new Sample[this->channels];
 
+    bank = NULL;
+
     reset();
     update_helper_variables();
 }
@@ -285,65 +475,94 @@ Sample const* const* BiquadFilter<InputSignalProducerClass>::initialize_renderin
         );
     }
 
-    bool is_no_op = false;
+    bool const is_no_op = initialize_coefficients(round, sample_count);
+
+    if (can_use_shared_coefficients) {
+        shared_cache->round = round;
+        shared_cache->are_coefficients_constant = are_coefficients_constant;
+        shared_cache->is_no_op = is_no_op;
+        shared_cache->is_silent = is_silent_;
+        shared_cache->b0_buffer = b0_buffer;
+        shared_cache->b1_buffer = b1_buffer;
+        shared_cache->b2_buffer = b2_buffer;
+        shared_cache->a1_buffer = a1_buffer;
+        shared_cache->a2_buffer = a2_buffer;
+    }
+
+    if (is_no_op) {
+        return initialize_rendering_no_op(round, sample_count);
+    }
+
+    if (UNLIKELY(is_silent_)) {
+        update_state_for_silent_round(round, sample_count);
+    }
+
+    return NULL;
+}
+
 
+template<class InputSignalProducerClass>
+bool BiquadFilter<InputSignalProducerClass>::initialize_coefficients(
+        Integer const round,
+        Integer const sample_count
+) noexcept {
     is_silent_ = false;
 
     switch (type.get_value()) {
         case LOW_PASS:
-            is_no_op = initialize_low_pass_rendering(round, sample_count);
-            break;
+            return initialize_low_pass_rendering(round, sample_count);
 
         case HIGH_PASS:
-            is_no_op = initialize_high_pass_rendering(round, sample_count);
-            break;
+            return initialize_high_pass_rendering(round, sample_count);
 
         case BAND_PASS:
-            is_no_op = initialize_band_pass_rendering(round, sample_count);
-            break;
+            return initialize_band_pass_rendering(round, sample_count);
 
         case NOTCH:
-            is_no_op = initialize_notch_rendering(round, sample_count);
-            break;
+            return initialize_notch_rendering(round, sample_count);
 
         case PEAKING:
-            is_no_op = initialize_peaking_rendering(round, sample_count);
-            break;
+            return initialize_peaking_rendering(round, sample_count);
 
         case LOW_SHELF:
-            is_no_op = initialize_low_shelf_rendering(round, sample_count);
-            break;
+            return initialize_low_shelf_rendering(round, sample_count);
 
         case HIGH_SHELF:
-            is_no_op = initialize_high_shelf_rendering(round, sample_count);
-            break;
+            return initialize_high_shelf_rendering(round, sample_count);
 
         default:
-            is_no_op = true;
-            break;
+            return true;
     }
+}
 
-    if (can_use_shared_coefficients) {
-        shared_cache->round = round;
-        shared_cache->are_coefficients_constant = are_coefficients_constant;
-        shared_cache->is_no_op = is_no_op;
-        shared_cache->is_silent = is_silent_;
-        shared_cache->b0_buffer = b0_buffer;
-        shared_cache->b1_buffer = b1_buffer;
-        shared_cache->b2_buffer = b2_buffer;
-        shared_cache->a1_buffer = a1_buffer;
-        shared_cache->a2_buffer = a2_buffer;
-    }
 
-    if (is_no_op) {
-        return initialize_rendering_no_op(round, sample_count);
+template<class InputSignalProducerClass>
+bool BiquadFilter<InputSignalProducerClass>::update_coefficients(
+        Integer const round,
+        Integer const sample_count,
+        Coefficients& coefficients
+) noexcept {
+    can_use_shared_coefficients = false;
+
+    if (initialize_coefficients(round, sample_count)) {
+        FloatParamS::produce_if_not_constant(frequency, round, sample_count);
+        FloatParamS::produce_if_not_constant(q, round, sample_count);
+        FloatParamS::produce_if_not_constant(gain, round, sample_count);
+
+        store_no_op_coefficient_samples(0);
+        are_coefficients_constant = true;
+    } else if (UNLIKELY(is_silent_)) {
+        store_silent_coefficient_samples(0);
+        are_coefficients_constant = true;
     }
 
-    if (UNLIKELY(is_silent_)) {
-        update_state_for_silent_round(round, sample_count);
-    }
+    coefficients.b0 = b0_buffer;
+    coefficients.b1 = b1_buffer;
+    coefficients.b2 = b2_buffer;
+    coefficients.a1 = a1_buffer;
+    coefficients.a2 = a2_buffer;
 
-    return NULL;
+    return are_coefficients_constant;
 }
 
 
@@ -1273,6 +1492,17 @@ void BiquadFilter<InputSignalProducerClass>::render(
         return;
     }
 
+    /*
+    BiquadFilter doesn't do anything in finalize_rendering(), so it doesn't
+    matter that the lanes may still be waiting for the next flush() of the
+    bank when SignalProducer::produce() finishes.
+    */
+    if (bank != NULL && are_coefficients_constant && first_sample_index == 0) {
+        bank->add_lanes(*this, last_sample_index, buffer);
+
+        return;
+    }
+
     Integer const channels = this->channels;
     Sample const* const* const input_buffer = this->input_buffer;
 
@@ -55,9 +55,84 @@ class BiquadFilterSharedCache
 };
 
 
+/**
+ * \brief Render multiple \c BiquadFilter objects side by side, so that a
+ *        single SIMD register can advance the recursion of
+ *        \c BiquadFilterBank::LANES channels at once.
+ *
+ * \note Only filters which have constant coefficients for the whole block are
+ *       rendered as lanes of the bank, e.g. voices which share the
+ *       coefficients via a \c BiquadFilterSharedCache. Other filters are
+ *       rendered right away, and the result is the same in either case.
+ *
+ * \warning The rendering of the queued lanes is completed only when the bank
+ *          is flushed, so it must be flushed before anything reads the output
+ *          of the added filters.
+ */
+class BiquadFilterBank
+{
+    template<class InputSignalProducerClass>
+    friend class BiquadFilter;
+
+    public:
+        typedef Sample SampleVector __attribute__((vector_size(32)));
+
+        static constexpr Integer LANES = (
+            (Integer)(sizeof(SampleVector) / sizeof(Sample))
+        );
+
+        BiquadFilterBank() noexcept;
+        ~BiquadFilterBank();
+
+        void set_block_size(Integer const new_block_size) noexcept;
+
+        template<class InputSignalProducerClass>
+        void produce(
+            BiquadFilter<InputSignalProducerClass>& filter,
+            Integer const round,
+            Integer const sample_count = -1
+        ) noexcept;
+
+        void flush() noexcept;
+
+    private:
+        class Lane
+        {
+            public:
+                Sample const* input;
+                Sample* output;
+                Sample* x_n_m1;
+                Sample* x_n_m2;
+                Sample* y_n_m1;
+                Sample* y_n_m2;
+                Sample b0;
+                Sample b1;
+                Sample b2;
+                Sample a1;
+                Sample a2;
+        };
+
+        template<class InputSignalProducerClass>
+        void add_lanes(
+            BiquadFilter<InputSignalProducerClass>& filter,
+            Integer const sample_count,
+            Sample** buffer
+        ) noexcept;
+
+        void render_lanes() noexcept;
+
+        Lane lanes[LANES];
+        SampleVector* interleaved;
+        Integer block_size;
+        Integer sample_count;
+        Integer lanes_count;
+};
+
+
 template<class InputSignalProducerClass>
 class BiquadFilter : public Filter<InputSignalProducerClass>
 {
+    friend class BiquadFilterBank;
     friend class SignalProducer;
 
     public:
@@ -71,6 +146,16 @@ class BiquadFilter : public Filter<InputSignalProducerClass>
         static constexpr Type LOW_SHELF = 5;
         static constexpr Type HIGH_SHELF = 6;
 
+        class Coefficients
+        {
+            public:
+                Sample const* b0;
+                Sample const* b1;
+                Sample const* b2;
+                Sample const* a1;
+                Sample const* a2;
+        };
+
         class TypeParam : public Param<Type, ParamEvaluation::BLOCK>
         {
             public:
@@ -110,6 +195,21 @@ class BiquadFilter : public Filter<InputSignalProducerClass>
 
         void set_shared_cache(BiquadFilterSharedCache* shared_cache) noexcept;
 
+        /**
+         * \brief Compute the coefficients for the given round without
+         *        rendering anything, for effects which apply the filter
+         *        inline, on signals of their own.
+         *
+         * \return                  Whether the coefficients are the same for
+         *                          the whole round. If so, then only the first
+         *                          element of each buffer is set.
+         */
+        bool update_coefficients(
+            Integer const round,
+            Integer const sample_count,
+            Coefficients& coefficients
+        ) noexcept;
+
         FloatParamS frequency;
         FloatParamS q;
         FloatParamS gain;
@@ -148,6 +248,11 @@ class BiquadFilter : public Filter<InputSignalProducerClass>
             Integer const sample_count
         ) noexcept;
 
+        bool initialize_coefficients(
+            Integer const round,
+            Integer const sample_count
+        ) noexcept;
+
         void update_state_for_no_op_round(Integer const sample_count) noexcept;
         void update_state_for_silent_round(
             Integer const round,
@@ -249,6 +354,7 @@ class BiquadFilter : public Filter<InputSignalProducerClass>
         void store_silent_coefficient_samples(Integer const index) noexcept;
 
         BiquadFilterSharedCache* shared_cache;
+        BiquadFilterBank* bank;
 
         /*
         Notation:
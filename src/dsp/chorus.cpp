@@ -224,6 +224,42 @@ void Chorus<InputSignalProducerClass>::skip_round_for_lfos(
 }
 
 
+template<class InputSignalProducerClass>
+void Chorus<InputSignalProducerClass>::produce_lfos(
+        Integer const round,
+        Integer const sample_count
+) noexcept {
+    /* See Effect::initialize_rendering(). */
+    bool const is_bypassed = (
+        this->wet.is_constant_until(sample_count)
+        && this->wet.get_value() < 0.000001
+        && this->dry.is_constant_until(sample_count)
+        && this->dry.get_value() > 0.99999
+    );
+
+    if (is_bypassed) {
+        return;
+    }
+
+    for (size_t i = 0; i != VOICES; ++i) {
+        SignalProducer::produce<LFO>(lfos[i], round, sample_count);
+    }
+}
+
+
+template<class InputSignalProducerClass>
+bool Chorus<InputSignalProducerClass>::is_tail_silent() const noexcept
+{
+    for (size_t i = 0; i != VOICES; ++i) {
+        if (!comb_filters[i].delay.is_delay_buffer_silent()) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
 template<class InputSignalProducerClass>
 Sample const* const* Chorus<InputSignalProducerClass>::initialize_rendering(
         Integer const round,
@@ -80,6 +80,21 @@ class Chorus : public Effect<InputSignalProducerClass>
             Integer const sample_count
         ) noexcept;
 
+        /**
+         * \brief Keep the LFOs running in a round when the chorus itself is
+         *        not rendered, unless they would be skipped anyway because
+         *        the chorus is bypassed.
+         */
+        void produce_lfos(
+            Integer const round,
+            Integer const sample_count
+        ) noexcept;
+
+        /**
+         * \brief Tell whether the delay lines are drained.
+         */
+        bool is_tail_silent() const noexcept;
+
         TypeParam type;
 
         FloatParamS delay_time;
@@ -535,30 +535,37 @@ void Delay<InputSignalProducerClass>::render(
     );
 
     if (time_buffer == NULL) {
-        Number const time_value = time.get_value() * time_scale;
-
-        for (Integer c = 0; c != channels; ++c) {
-            Sample const* const delay_channel = delay_buffer[c];
-            Number read_index = read_index_float - time_value;
-
-            for (Integer i = first_sample_index; i != last_sample_index; ++i) {
-                if constexpr (need_gain) {
-                    if constexpr (is_gain_constant) {
-                        buffer[c][i] = gain * Math::lookup_periodic(
-                            delay_channel, delay_buffer_size, read_index
-                        );
-                    } else {
-                        buffer[c][i] = gain_buffer[i] * Math::lookup_periodic(
-                            delay_channel, delay_buffer_size, read_index
-                        );
-                    }
-                } else {
-                    buffer[c][i] = Math::lookup_periodic(
-                        delay_channel, delay_buffer_size, read_index
-                    );
-                }
-
-                read_index += 1.0;
+        Number const index = read_index_float - time.get_value() * time_scale;
+        Number const rounded_index = std::round(index);
+
+        if (std::fabs(index - rounded_index) < INTEGER_DELAY_THRESHOLD) {
+            Integer const before_index = wrap_delay_buffer_index(rounded_index);
+
+            for (Integer c = 0; c != channels; ++c) {
+                render_with_integer_delay<need_gain, is_gain_constant>(
+                    delay_buffer[c],
+                    before_index,
+                    first_sample_index,
+                    last_sample_index,
+                    buffer[c],
+                    gain
+                );
+            }
+        } else {
+            Number const floor_index = std::floor(index);
+            Sample const after_weight = (Sample)(index - floor_index);
+            Integer const before_index = wrap_delay_buffer_index(floor_index);
+
+            for (Integer c = 0; c != channels; ++c) {
+                render_with_fractional_delay<need_gain, is_gain_constant>(
+                    delay_buffer[c],
+                    before_index,
+                    after_weight,
+                    first_sample_index,
+                    last_sample_index,
+                    buffer[c],
+                    gain
+                );
             }
         }
     } else {
@@ -596,6 +603,133 @@ void Delay<InputSignalProducerClass>::render(
 }
 
 
+template<class InputSignalProducerClass>
+Integer Delay<InputSignalProducerClass>::wrap_delay_buffer_index(
+        Number const index
+) const noexcept {
+    Integer const delay_buffer_size = this->delay_buffer_size;
+    Integer wrapped_index = (Integer)index;
+
+    if (wrapped_index < 0) {
+        wrapped_index -= (wrapped_index / delay_buffer_size - 1) * delay_buffer_size;
+    }
+
+    if (wrapped_index >= delay_buffer_size) {
+        wrapped_index %= delay_buffer_size;
+    }
+
+    return wrapped_index;
+}
+
+
+template<class InputSignalProducerClass>
+template<bool need_gain, bool is_gain_constant>
+void Delay<InputSignalProducerClass>::render_with_integer_delay(
+        Sample const* const delay_channel,
+        Integer before_index,
+        Integer const first_sample_index,
+        Integer const last_sample_index,
+        Sample* const buffer,
+        Sample const gain
+) const noexcept {
+    Integer const delay_buffer_size = this->delay_buffer_size;
+    Sample const* const gain_buffer = this->gain_buffer;
+    Integer i = first_sample_index;
+
+    /* Copy the contiguous spans between the wraparounds of the delay buffer. */
+    while (i != last_sample_index) {
+        Integer const end = std::min(
+            last_sample_index, i + delay_buffer_size - before_index
+        );
+        Integer const offset = before_index - i;
+
+        for (; i != end; ++i) {
+            if constexpr (need_gain) {
+                if constexpr (is_gain_constant) {
+                    buffer[i] = gain * delay_channel[i + offset];
+                } else {
+                    buffer[i] = gain_buffer[i] * delay_channel[i + offset];
+                }
+            } else {
+                buffer[i] = delay_channel[i + offset];
+            }
+        }
+
+        before_index = 0;
+    }
+}
+
+
+template<class InputSignalProducerClass>
+template<bool need_gain, bool is_gain_constant>
+void Delay<InputSignalProducerClass>::render_with_fractional_delay(
+        Sample const* const delay_channel,
+        Integer before_index,
+        Sample const after_weight,
+        Integer const first_sample_index,
+        Integer const last_sample_index,
+        Sample* const buffer,
+        Sample const gain
+) const noexcept {
+    Integer const last_index = this->delay_buffer_size - 1;
+    Sample const* const gain_buffer = this->gain_buffer;
+    Integer i = first_sample_index;
+
+    /*
+    The after sample of the last element of the delay buffer is at the
+    beginning, so only the spans before that need no wraparound.
+    */
+    while (i != last_sample_index) {
+        Sample sample;
+
+        if (UNLIKELY(before_index == last_index)) {
+            sample = (
+                after_weight * (delay_channel[0] - delay_channel[last_index])
+                + delay_channel[last_index]
+            );
+
+            if constexpr (need_gain) {
+                if constexpr (is_gain_constant) {
+                    buffer[i] = gain * sample;
+                } else {
+                    buffer[i] = gain_buffer[i] * sample;
+                }
+            } else {
+                buffer[i] = sample;
+            }
+
+            before_index = 0;
+            ++i;
+
+            continue;
+        }
+
+        Integer const end = std::min(
+            last_sample_index, i + last_index - before_index
+        );
+        Integer const offset = before_index - i;
+
+        for (; i != end; ++i) {
+            Sample const before = delay_channel[i + offset];
+
+            sample = after_weight * (delay_channel[i + offset + 1] - before) + before;
+
+            if constexpr (need_gain) {
+                if constexpr (is_gain_constant) {
+                    buffer[i] = gain * sample;
+                } else {
+                    buffer[i] = gain_buffer[i] * sample;
+                }
+            } else {
+                buffer[i] = sample;
+            }
+        }
+
+        before_index = i + offset;
+    }
+}
+
+
 template<class InputSignalProducerClass, class FilterInputClass>
 PannedDelay<InputSignalProducerClass, FilterInputClass>::PannedDelay(
         InputSignalProducerClass& input,
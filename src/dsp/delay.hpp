@@ -95,6 +95,12 @@ class Delay : public Filter<InputSignalProducerClass>
             Delay<InputSignalProducerClass> const& shared_buffer_owner
         ) noexcept;
 
+        /**
+         * \brief Tell whether both the input and the feedback have been silent
+         *        for long enough to flush everything out of the delay buffer.
+         */
+        bool is_delay_buffer_silent() const noexcept;
+
         ToggleParam const* const tempo_sync;
 
         FloatParamS gain;
@@ -114,6 +120,12 @@ class Delay : public Filter<InputSignalProducerClass>
         ) noexcept;
 
     private:
+        /*
+        Delays which are this close to a whole number of samples are read
+        without interpolation.
+        */
+        static constexpr Number INTEGER_DELAY_THRESHOLD = 0.000001;
+
         enum DelayBufferWritingMode {
             CLEAR = 0,
             ADD = 1,
@@ -149,8 +161,6 @@ class Delay : public Filter<InputSignalProducerClass>
             Integer const increment
         ) const noexcept;
 
-        bool is_delay_buffer_silent() const noexcept;
-
         template<bool need_gain, bool is_gain_constant>
         void render(
             Integer const round,
@@ -160,6 +170,29 @@ class Delay : public Filter<InputSignalProducerClass>
             Sample const gain
         ) noexcept;
 
+        Integer wrap_delay_buffer_index(Number const index) const noexcept;
+
+        template<bool need_gain, bool is_gain_constant>
+        void render_with_integer_delay(
+            Sample const* const delay_channel,
+            Integer before_index,
+            Integer const first_sample_index,
+            Integer const last_sample_index,
+            Sample* const buffer,
+            Sample const gain
+        ) const noexcept;
+
+        template<bool need_gain, bool is_gain_constant>
+        void render_with_fractional_delay(
+            Sample const* const delay_channel,
+            Integer before_index,
+            Sample const after_weight,
+            Integer const first_sample_index,
+            Integer const last_sample_index,
+            Sample* const buffer,
+            Sample const gain
+        ) const noexcept;
+
         Integer const delay_buffer_oversize;
         bool const is_gain_constant_1;
 
@@ -29,17 +29,17 @@
 namespace JS80P
 {
 
-template<class InputSignalProducerClass>
-Distortion<InputSignalProducerClass>::Distortion(
-        std::string const name,
-        Number const steepness,
-        InputSignalProducerClass& input
-) noexcept
-    : Filter<InputSignalProducerClass>(input, 1),
-    level(name + "G", 0.0, 1.0, 0.0)
+DistortionTables const& DistortionTables::get(Shape const shape) noexcept
 {
-    this->register_child(level);
+    static DistortionTables const tanh_3(3.0);
+    static DistortionTables const tanh_10(10.0);
+
+    return shape == TANH_3 ? tanh_3 : tanh_10;
+}
 
+
+DistortionTables::DistortionTables(Number const steepness) noexcept
+{
     Sample const table_size_inv = 1.0 / (Sample)TABLE_SIZE;
     Sample const steepness_inv_double = 2.0 / steepness;
 
@@ -50,6 +50,56 @@ Distortion<InputSignalProducerClass>::Distortion(
             x + steepness_inv_double * std::log(std::exp(-steepness * x) + 1.0)
         );
     }
+}
+
+
+Sample DistortionTables::f(Sample const x) const noexcept
+{
+    if (x < 0.0) {
+        return -lookup(f_table, -x);
+    } else {
+        return lookup(f_table, x);
+    }
+}
+
+
+Sample DistortionTables::F0(Sample const x) const noexcept
+{
+    if (x < 0.0) {
+        if (x < INPUT_MIN) {
+            return -x;
+        }
+
+        return lookup(F0_table, -x);
+    } else {
+        if (x > INPUT_MAX) {
+            return x;
+        }
+
+        return lookup(F0_table, x);
+    }
+}
+
+
+Sample DistortionTables::lookup(
+        Sample const* const table,
+        Sample const x
+) const noexcept {
+    return Math::lookup(table, MAX_INDEX, x * SCALE);
+}
+
+
+template<class InputSignalProducerClass>
+Distortion<InputSignalProducerClass>::Distortion(
+        std::string const name,
+        DistortionTables::Shape const shape,
+        InputSignalProducerClass& input
+) noexcept
+    : Filter<InputSignalProducerClass>(input, 1),
+    level(name + "G", 0.0, 1.0, 0.0),
+    tables(DistortionTables::get(shape))
+{
+    this->register_child(level);
 
     if (this->channels > 0) {
         previous_input_sample = new Sample[this->channels];
@@ -57,7 +107,7 @@ Distortion<InputSignalProducerClass>::Distortion(
 
         for (Integer c = 0; c != this->channels; ++c) {
             previous_input_sample[c] = 0.0;
-            F0_previous_input_sample[c] = F0(0.0);
+            F0_previous_input_sample[c] = tables.F0(0.0);
         }
     } else {
         previous_input_sample = NULL;
@@ -86,7 +136,7 @@ void Distortion<InputSignalProducerClass>::reset() noexcept
 
     for (Integer c = 0; c != this->channels; ++c) {
         previous_input_sample[c] = 0.0;
-        F0_previous_input_sample[c] = F0(0.0);
+        F0_previous_input_sample[c] = tables.F0(0.0);
     }
 }
 
@@ -127,7 +177,6 @@ void Distortion<InputSignalProducerClass>::render(
     Integer const channels = this->channels;
     Sample const* const level_buffer = this->level_buffer;
     Sample const* const* const input_buffer = this->input_buffer;
-
     Sample* previous_input_sample = this->previous_input_sample;
     Sample* F0_previous_input_sample = this->F0_previous_input_sample;
 
@@ -177,7 +226,7 @@ Sample Distortion<InputSignalProducerClass>::distort(
 
     if (UNLIKELY(std::fabs(delta) < 0.00000001)) {
         previous_input_sample = input_sample;
-        F0_previous_input_sample = F0(input_sample);
+        F0_previous_input_sample = tables.F0(input_sample);
 
         /*
         We're supposed to calculate the average of the current and the previous
@@ -185,10 +234,10 @@ Sample Distortion<InputSignalProducerClass>::distort(
         very small or zero, we can probably get away with just using one of
         them.
         */
-        return f(input_sample);
+        return tables.f(input_sample);
     }
 
-    Sample const F0_input_sample = F0(input_sample);
+    Sample const F0_input_sample = tables.F0(input_sample);
     Sample const ret = (F0_input_sample - F0_previous_input_sample) / delta;
 
     previous_input_sample = input_sample;
@@ -197,45 +246,6 @@ Sample Distortion<InputSignalProducerClass>::distort(
     return ret;
 }
 
-
-template<class InputSignalProducerClass>
-Sample Distortion<InputSignalProducerClass>::f(Sample const x) const noexcept
-{
-    if (x < 0.0) {
-        return -lookup(f_table, -x);
-    } else {
-        return lookup(f_table, x);
-    }
-}
-
-
-template<class InputSignalProducerClass>
-Sample Distortion<InputSignalProducerClass>::F0(Sample const x) const noexcept
-{
-    if (x < 0.0) {
-        if (x < INPUT_MIN) {
-            return -x;
-        }
-
-        return lookup(F0_table, -x);
-    } else {
-        if (x > INPUT_MAX) {
-            return x;
-        }
-
-        return lookup(F0_table, x);
-    }
-}
-
-
-template<class InputSignalProducerClass>
-Sample Distortion<InputSignalProducerClass>::lookup(
-        Sample const* const table,
-        Sample const x
-) const noexcept {
-    return Math::lookup(table, MAX_INDEX, x * SCALE);
-}
-
 }
 
 #endif
@@ -31,12 +31,55 @@
 namespace JS80P
 {
 
+/**
+ * \brief Lookup tables of a \c tanh() based waveshaper and its antiderivative.
+ *        The tables depend only on the shape, so all \c Distortion objects
+ *        with the same shape share a single, read-only copy.
+ */
+class DistortionTables
+{
+    public:
+        typedef Byte Shape;
+
+        static constexpr Shape TANH_3 = 0;      ///< \c tanh(1.5 * x)
+        static constexpr Shape TANH_10 = 1;     ///< \c tanh(5.0 * x)
+
+        static constexpr int TABLE_SIZE = 0x2000;
+        static constexpr int MAX_INDEX = TABLE_SIZE - 1;
+
+        static constexpr Sample INPUT_MAX = 3.0;
+        static constexpr Sample INPUT_MIN = -3.0;
+
+        static DistortionTables const& get(Shape const shape) noexcept;
+
+        Sample f(Sample const x) const noexcept;
+        Sample F0(Sample const x) const noexcept;
+
+    private:
+        static constexpr Sample INPUT_MAX_INV = 1.0 / INPUT_MAX;
+        static constexpr Sample TABLE_SIZE_FLOAT = (Sample)TABLE_SIZE;
+        static constexpr Sample SCALE = TABLE_SIZE_FLOAT * INPUT_MAX_INV;
+
+        DistortionTables(Number const steepness) noexcept;
+
+        Sample lookup(Sample const* const table, Sample const x) const noexcept;
+
+        Sample f_table[TABLE_SIZE];
+        Sample F0_table[TABLE_SIZE];
+};
+
+
 /**
  * \brief Antialiased waveshaper based distortion, using Antiderivative
  *        Antialiasing (ADAA). See:
  *        <a href="https://www.dafx.de/paper-archive/2016/dafxpapers/20-DAFx-16_paper_41-PN.pdf">
  *        Reducing the Aliasing of Nonlinear Waveshaping Using Continuous-Time Convolution
  *        (Parker, J., Zavalishin, V., & Bivic, E.L. - 2016)</a>.
+ *
+ * \note The waveshaper runs at the host's sample rate, ADAA is the only
+ *       antialiasing measure. Oversampling is not supported: it would add
+ *       latency which all the bypass paths would have to match, and which
+ *       the plugins would have to report to the host.
  */
 template<class InputSignalProducerClass>
 class Distortion : public Filter<InputSignalProducerClass>
@@ -46,7 +89,7 @@ class Distortion : public Filter<InputSignalProducerClass>
     public:
         Distortion(
             std::string const name,
-            Number const steepness,
+            DistortionTables::Shape const shape,
             InputSignalProducerClass& input
         ) noexcept;
 
@@ -70,28 +113,13 @@ class Distortion : public Filter<InputSignalProducerClass>
         ) noexcept;
 
     private:
-        static constexpr int TABLE_SIZE = 0x2000;
-        static constexpr int MAX_INDEX = TABLE_SIZE - 1;
-
-        static constexpr Sample INPUT_MAX = 3.0;
-        static constexpr Sample INPUT_MIN = -3.0;
-        static constexpr Sample INPUT_MAX_INV = 1.0 / INPUT_MAX;
-        static constexpr Sample TABLE_SIZE_FLOAT = (Sample)TABLE_SIZE;
-        static constexpr Sample SCALE = TABLE_SIZE_FLOAT * INPUT_MAX_INV;
-
         Sample distort(
             Sample const input_sample,
             Sample& previous_input_sample,
             Sample& F0_previous_input_sample
         ) noexcept;
 
-        Sample f(Sample const x) const noexcept;
-        Sample F0(Sample const x) const noexcept;
-
-        Sample lookup(Sample const* const table, Sample const x) const noexcept;
-
-        Sample f_table[TABLE_SIZE];
-        Sample F0_table[TABLE_SIZE];
+        DistortionTables const& tables;
 
         Sample const* level_buffer;
         Sample* previous_input_sample;
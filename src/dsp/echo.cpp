@@ -19,6 +19,9 @@
 #ifndef JS80P__DSP__ECHO_CPP
 #define JS80P__DSP__ECHO_CPP
 
+#include <algorithm>
+#include <cmath>
+
 #include "dsp/echo.hpp"
 
 #include "dsp/math.hpp"
@@ -139,6 +142,50 @@ Echo<InputSignalProducerClass>::Echo(
 }
 
 
+template<class InputSignalProducerClass>
+bool Echo<InputSignalProducerClass>::is_tail_silent() const noexcept
+{
+    return (
+        comb_filter_1.delay.is_delay_buffer_silent()
+        && comb_filter_2.delay.is_delay_buffer_silent()
+    );
+}
+
+
+template<class InputSignalProducerClass>
+Seconds Echo<InputSignalProducerClass>::get_tail_length() const noexcept
+{
+    if (this->wet.get_value() < 0.000001) {
+        return 0.0;
+    }
+
+    Seconds const delay = (
+        tempo_sync.get_value() == ToggleParam::ON
+            ? (
+                delay_time.get_value()
+                * Delay<HighPassedInput>::ONE_MINUTE
+                / std::max(Delay<HighPassedInput>::BPM_MIN, this->get_bpm())
+            )
+            : delay_time.get_value()
+    );
+    Number const feedback = this->feedback.get_value();
+
+    if (feedback < SignalProducer::SILENCE_THRESHOLD) {
+        return delay;
+    }
+
+    /*
+    Damping can only make the repetitions decay faster, so this is an upper
+    bound.
+    */
+    Number const repetitions = std::ceil(
+        std::log(SignalProducer::SILENCE_THRESHOLD) / std::log(feedback)
+    );
+
+    return delay * (1.0 + repetitions);
+}
+
+
 template<class InputSignalProducerClass>
 Sample const* const* Echo<InputSignalProducerClass>::initialize_rendering(
         Integer const round,
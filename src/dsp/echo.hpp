@@ -43,6 +43,18 @@ class Echo : public SideChainCompressableEffect<InputSignalProducerClass>
 
         Echo(std::string const name, InputSignalProducerClass& input);
 
+        /**
+         * \brief Tell whether the delay lines are drained.
+         */
+        bool is_tail_silent() const noexcept;
+
+        /**
+         * \brief Estimate how long it takes for a full scale echo to decay
+         *        below \c SignalProducer::SILENCE_THRESHOLD with the current
+         *        settings.
+         */
+        Seconds get_tail_length() const noexcept;
+
         FloatParamS delay_time;
         FloatParamS feedback;
         FloatParamS damping_frequency;
@@ -34,8 +34,8 @@ Effects<InputSignalProducerClass>::Effects(
     volume_2_gain(name + "V2V", 0.0, 1.0, 1.0),
     volume_3_gain(name + "V3V", 0.0, 1.0, 1.0),
     volume_1(input, volume_1_gain),
-    overdrive(name + "O", 3.0, volume_1),
-    distortion(name + "D", 10.0, overdrive),
+    overdrive(name + "O", DistortionTables::TANH_3, volume_1),
+    distortion(name + "D", DistortionTables::TANH_10, overdrive),
     filter_1_type(name + "F1TYP"),
     filter_2_type(name + "F2TYP"),
     filter_1_log_scale(name + "F1LOG", ToggleParam::OFF),
@@ -67,6 +67,25 @@ Effects<InputSignalProducerClass>::Effects(
     this->register_child(volume_3);
 }
 
+
+template<class InputSignalProducerClass>
+bool Effects<InputSignalProducerClass>::is_tail_silent() const noexcept
+{
+    return (
+        chorus.is_tail_silent()
+        && echo.is_tail_silent()
+        && reverb.is_tail_silent()
+    );
+}
+
+
+template<class InputSignalProducerClass>
+Seconds Effects<InputSignalProducerClass>::get_tail_length() const noexcept
+{
+    /* The reverb is fed by the echo, so their tails add up. */
+    return echo.get_tail_length() + reverb.get_tail_length();
+}
+
 } }
 
 #endif
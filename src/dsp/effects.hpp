@@ -72,6 +72,18 @@ class Effects : public Filter< Volume3<InputSignalProducerClass> >
     public:
         Effects(std::string const name, InputSignalProducerClass& input);
 
+        /**
+         * \brief Tell whether the delay lines of the chorus, the echo, and
+         *        the reverb are all drained.
+         */
+        bool is_tail_silent() const noexcept;
+
+        /**
+         * \brief Estimate how long the echo and the reverb may keep ringing
+         *        after their input becomes silent.
+         */
+        Seconds get_tail_length() const noexcept;
+
         FloatParamS volume_1_gain;
         FloatParamS volume_2_gain;
         FloatParamS volume_3_gain;
@@ -56,6 +56,11 @@ Envelope::Envelope(std::string const name) noexcept
 
 void Envelope::update() noexcept
 {
+    /*
+    Voices may be rendered on multiple threads, but all envelopes are brought
+    up to date before that (see Synth::initialize_rendering()), so concurrent
+    calls will only read the change indices, and nothing will be written.
+    */
     bool is_dirty;
 
     is_dirty = update_change_index(delay_time, delay_time_change_index);
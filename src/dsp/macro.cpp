@@ -46,12 +46,15 @@ Macro::Macro(std::string const name) noexcept
 
 void Macro::update() noexcept
 {
-    if (is_updating) {
+    /*
+    Voices may be rendered on multiple threads, but all macros are brought up
+    to date before that, so any concurrent call will find nothing to update,
+    and the guard only needs to be free of data races.
+    */
+    if (is_updating.exchange(true)) {
         return;
     }
 
-    is_updating = true;
-
     if (!update_change_indices()) {
         is_updating = false;
 
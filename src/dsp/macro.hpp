@@ -19,6 +19,7 @@
 #ifndef JS80P__DSP__MACRO_HPP
 #define JS80P__DSP__MACRO_HPP
 
+#include <atomic>
 #include <string>
 
 #include "js80p.hpp"
@@ -61,7 +62,7 @@ class Macro : public MidiController
         Integer amount_change_index;
         Integer distortion_change_index;
         Integer randomness_change_index;
-        bool is_updating;
+        std::atomic<bool> is_updating;
 };
 
 }
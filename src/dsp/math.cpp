@@ -19,7 +19,11 @@
 #ifndef JS80P__DSP__MATH_CPP
 #define JS80P__DSP__MATH_CPP
 
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
 #include <limits>
+#include <type_traits>
 
 #include "dsp/math.hpp"
 
@@ -186,9 +190,20 @@ Number Math::trig(Number const* const table, Number const x) const noexcept
 }
 
 
-void Math::sincos(Number const x, Number& sin, Number& cos) noexcept
+template<typename NumberType>
+void Math::sincos(Number const x, NumberType& sin, NumberType& cos) noexcept
 {
-    math.sincos_impl(x, sin, cos);
+    if constexpr (std::is_same<NumberType, Number>::value) {
+        math.sincos_impl(x, sin, cos);
+    } else {
+        Number sin_number;
+        Number cos_number;
+
+        math.sincos_impl(x, sin_number, cos_number);
+
+        sin = (NumberType)sin_number;
+        cos = (NumberType)cos_number;
+    }
 }
 
 
@@ -288,6 +303,156 @@ Frequency Math::detune(Frequency const frequency, Number const cents) noexcept
 }
 
 
+Number Math::exp2(Number const x) noexcept
+{
+    Number shifted;
+    Number const e_to_y = exp2_fraction(x, shifted);
+
+    return exp2_scale(e_to_y, shifted);
+}
+
+
+Number Math::exp2_fraction(Number const x, Number& shifted) noexcept
+{
+    /*
+    2^x = 2^n * e^(f * ln(2)) where n = round(x) and -0.5 <= f <= 0.5, so the
+    Taylor series of e^y needs to be good for |y| <= ln(2) / 2 only, where
+    the 12th term is already below 1e-14.
+    */
+    constexpr Number c2 = 1.0 / 2.0;
+    constexpr Number c3 = c2 / 3.0;
+    constexpr Number c4 = c3 / 4.0;
+    constexpr Number c5 = c4 / 5.0;
+    constexpr Number c6 = c5 / 6.0;
+    constexpr Number c7 = c6 / 7.0;
+    constexpr Number c8 = c7 / 8.0;
+    constexpr Number c9 = c8 / 9.0;
+    constexpr Number c10 = c9 / 10.0;
+    constexpr Number c11 = c10 / 11.0;
+
+    /*
+    Adding 1.5 * 2^52 to an integer valued number makes its lowest bits hold
+    the same integer in two's complement, which is vectorizable, unlike
+    converting it to an integer type.
+    */
+    constexpr Number integer_magic = 6755399441055744.0;
+
+    /* Out of range exponents would overflow into the sign bit of 2^n. */
+    Number const clamped_x = std::min(EXP2_MAX, std::max(EXP2_MIN, x));
+    Number const n = std::floor(clamped_x + 0.5);
+    Number const y = (clamped_x - n) * LN_OF_2;
+
+    shifted = n + integer_magic;
+
+    return 1.0 + y * (
+        1.0 + y * (
+            c2 + y * (
+                c3 + y * (
+                    c4 + y * (
+                        c5 + y * (
+                            c6 + y * (
+                                c7 + y * (
+                                    c8 + y * (
+                                        c9 + y * (c10 + y * c11)
+                                    )
+                                )
+                            )
+                        )
+                    )
+                )
+            )
+        )
+    );
+}
+
+
+Number Math::exp2_scale(Number const e_to_y, Number const shifted) noexcept
+{
+    /* Construct 2^n directly from its exponent bits. */
+    uint64_t shifted_bits;
+    Number two_to_n;
+
+    memcpy(&shifted_bits, &shifted, sizeof(shifted_bits));
+
+    uint64_t const two_to_n_bits = (shifted_bits + 1023) << 52;
+
+    memcpy(&two_to_n, &two_to_n_bits, sizeof(two_to_n));
+
+    return two_to_n * e_to_y;
+}
+
+
+void Math::detune_ratios(Frequency* const buffer, Integer const size) noexcept
+{
+    constexpr Number scale = DETUNE_CENTS_TO_POWER_OF_2_SCALE;
+    constexpr Integer anchor_distance = DETUNE_RAMP_ANCHOR_DISTANCE;
+
+    Number delta;
+
+    if (size < 2 * anchor_distance || !is_linear_ramp(buffer, size, delta)) {
+        /*
+        The polynomial part vectorizes with full width floating point
+        registers, but the integer part would drag it down to half width
+        without AVX2, so the two are done in separate passes.
+        */
+        Number shifted[EXP2_CHUNK_SIZE];
+
+        for (Integer chunk = 0; chunk < size; chunk += EXP2_CHUNK_SIZE) {
+            Integer const count = std::min(EXP2_CHUNK_SIZE, size - chunk);
+            Frequency* const ratios = &buffer[chunk];
+
+            for (Integer i = 0; i != count; ++i) {
+                ratios[i] = exp2_fraction(scale * ratios[i], shifted[i]);
+            }
+
+            for (Integer i = 0; i != count; ++i) {
+                ratios[i] = exp2_scale(ratios[i], shifted[i]);
+            }
+        }
+
+        return;
+    }
+
+    Number const first = scale * buffer[0];
+    Number const step = scale * delta;
+    Number steps[anchor_distance];
+
+    for (Integer i = 0; i != anchor_distance; ++i) {
+        steps[i] = exp2(step * (Number)i);
+    }
+
+    for (Integer anchor = 0; anchor < size; anchor += anchor_distance) {
+        Number const anchor_ratio = exp2(first + step * (Number)anchor);
+        Integer const count = std::min(anchor_distance, size - anchor);
+        Frequency* const segment = &buffer[anchor];
+
+        for (Integer i = 0; i != count; ++i) {
+            segment[i] = anchor_ratio * steps[i];
+        }
+    }
+}
+
+
+bool Math::is_linear_ramp(
+        Number const* const buffer,
+        Integer const size,
+        Number& delta
+) noexcept {
+    Number const first = buffer[0];
+    Number max_error = 0.0;
+
+    delta = (buffer[size - 1] - first) / (Number)(size - 1);
+
+    for (Integer i = 1; i != size; ++i) {
+        max_error = std::max(
+            max_error, std::fabs(first + delta * (Number)i - buffer[i])
+        );
+    }
+
+    return max_error < DETUNE_RAMP_TOLERANCE_CENTS;
+}
+
+
 void Math::compute_statistics(
         std::vector<Number> const& numbers,
         Statistics& statistics
@@ -418,8 +583,9 @@ Number Math::randomize_centered_lfo(Number const level, Number const number) noe
 }
 
 
+template<typename NumberType>
 Number Math::lookup(
-        Number const* const table,
+        NumberType const* const table,
         int const max_index,
         Number const index
 ) noexcept {
@@ -436,8 +602,9 @@ Number Math::lookup(
 }
 
 
+template<typename NumberType>
 Number Math::lookup_periodic(
-        Number const* table,
+        NumberType const* table,
         int const table_size,
         Number const index
 ) noexcept {
@@ -463,8 +630,9 @@ Number Math::lookup_periodic(
 }
 
 
+template<typename NumberType>
 Number Math::lookup_periodic_2(
-        Number const* table,
+        NumberType const* table,
         int const table_size,
         int const table_mask,
         Number const index
@@ -23,6 +23,11 @@
 #include <algorithm>
 #include <vector>
 
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define JS80P_HAS_MXCSR
+#include <xmmintrin.h>
+#endif
+
 #include "js80p.hpp"
 
 
@@ -88,6 +93,11 @@ class Math
             (Number)LOG_BIQUAD_FILTER_FREQ_TABLE_MAX_INDEX
         );
 
+        static constexpr Number EXP2_MIN = -1022.0;
+        static constexpr Number EXP2_MAX = 1023.0;
+
+        static constexpr Integer DETUNE_RAMP_ANCHOR_DISTANCE = 16;
+
         static constexpr Number DB_MIN = -120.0;
         static constexpr Number LINEAR_TO_DB_MIN = 0.000001;
         static constexpr Number LINEAR_TO_DB_MAX = 5.0;
@@ -108,7 +118,12 @@ class Math
          * \warning Negative numbers close to multiples of PI are not handled
          *          very well with regards to precision.
          */
-        static void sincos(Number const x, Number& sin, Number& cos) noexcept;
+        template<typename NumberType>
+        static void sincos(
+            Number const x,
+            NumberType& sin,
+            NumberType& cos
+        ) noexcept;
 
         static Number exp(Number const x) noexcept;
         static Number pow_10(Number const x) noexcept;
@@ -131,6 +146,30 @@ class Math
             Number const cents
         ) noexcept;
 
+        /**
+         * \brief Replace a block of detune values (in cents) with the
+         *        corresponding frequency ratios, without calling \c std::pow()
+         *        for each sample.
+         *
+         * \note The error of each ratio stays below \c 1e-9 cents (roughly
+         *       \c 1e-12 relative error), so oscillators don't drift out of
+         *       phase. A linear ramp of detune values (e.g. a detune or fine
+         *       detune param being ramped to a new value) is computed with
+         *       multiplicative steps, and each
+         *       \c DETUNE_RAMP_ANCHOR_DISTANCE long segment starts from an
+         *       exact value, so errors can't pile up.
+         */
+        static void detune_ratios(Frequency* const buffer, Integer const size) noexcept;
+
+        /**
+         * \brief Compute 2 to the power of \c x, using a polynomial
+         *        approximation which can be vectorized.
+         *
+         * \note \c x is clamped between \c EXP2_MIN and \c EXP2_MAX, so
+         *       that the result stays a normal, finite number.
+         */
+        static Number exp2(Number const x) noexcept;
+
         /**
          * \brief Compute a_weight * a + (1.0 - a_weight) * b
          */
@@ -172,8 +211,9 @@ class Math
          *        than or equal to \c max_index, then the last element of the
          *        table is returned.
          */
+        template<typename NumberType>
         static Number lookup(
-            Number const* const table,
+            NumberType const* const table,
             int const max_index,
             Number const index
         ) noexcept;
@@ -184,8 +224,9 @@ class Math
          *        is greater than or equal to the specified \c table_size, then
          *        it wraps around.
          */
+        template<typename NumberType>
         static Number lookup_periodic(
-            Number const* table,
+            NumberType const* table,
             int const table_size,
             Number const index
         ) noexcept;
@@ -194,8 +235,9 @@ class Math
          * \brief Same as \c lookup_periodic() but for tables that have a size
          *        that is a power of 2.
          */
+        template<typename NumberType>
         static Number lookup_periodic_2(
-            Number const* table,
+            NumberType const* table,
             int const table_size,
             int const table_mask,
             Number const index
@@ -237,6 +279,14 @@ class Math
 
         static constexpr Number DETUNE_CENTS_TO_POWER_OF_2_SCALE = 1.0 / 1200.0;
 
+        /*
+        Deviating from a straight line by less than this is considered to be
+        due to rounding errors in the param buffer.
+        */
+        static constexpr Number DETUNE_RAMP_TOLERANCE_CENTS = 0.000001;
+
+        static constexpr Integer EXP2_CHUNK_SIZE = 32;
+
         static constexpr int LINEAR_TO_DB_TABLE_SIZE = 0x0800;
         static constexpr int LINEAR_TO_DB_TABLE_MAX_INDEX = LINEAR_TO_DB_TABLE_SIZE - 1;
         static constexpr Number LINEAR_TO_DB_GAIN_SCALE = 20.0;
@@ -251,6 +301,19 @@ class Math
 
         static Number iterate_exp(Number const x, Number const scale) noexcept;
 
+        static Number exp2_fraction(Number const x, Number& shifted) noexcept;
+
+        static Number exp2_scale(
+            Number const e_to_y,
+            Number const shifted
+        ) noexcept;
+
+        static bool is_linear_ramp(
+            Number const* const buffer,
+            Integer const size,
+            Number& delta
+        ) noexcept;
+
         Math() noexcept;
 
         void init_sines() noexcept;
@@ -274,6 +337,61 @@ class Math
         Number linear_to_dbs[LINEAR_TO_DB_TABLE_SIZE];
 };
 
+
+/**
+ * \brief Make the current thread flush denormal numbers to zero (FTZ) and
+ *        treat denormal inputs as zero (DAZ) while the object is alive, then
+ *        restore the previous mode.
+ *
+ * \note Decaying feedback and filter states would otherwise make the CPU fall
+ *       back to much slower microcode paths exactly when the signal is about
+ *       to fade out. Hosts don't necessarily enable these flags for the audio
+ *       thread, and they are not inherited by threads which we start.
+ *
+ * \note This is a no-op on platforms other than x86.
+ */
+class ScopedFlushToZero
+{
+    public:
+        ScopedFlushToZero() noexcept
+#ifdef JS80P_HAS_MXCSR
+            : previous_mode(_mm_getcsr())
+        {
+            if ((previous_mode & FLUSH_TO_ZERO_AND_DENORMALS_ARE_ZERO)
+                    != FLUSH_TO_ZERO_AND_DENORMALS_ARE_ZERO
+            ) {
+                _mm_setcsr(previous_mode | FLUSH_TO_ZERO_AND_DENORMALS_ARE_ZERO);
+            }
+        }
+#else
+        {
+        }
+#endif
+
+        ~ScopedFlushToZero()
+        {
+#ifdef JS80P_HAS_MXCSR
+            if ((previous_mode & FLUSH_TO_ZERO_AND_DENORMALS_ARE_ZERO)
+                    != FLUSH_TO_ZERO_AND_DENORMALS_ARE_ZERO
+            ) {
+                _mm_setcsr(previous_mode);
+            }
+#endif
+        }
+
+        ScopedFlushToZero(ScopedFlushToZero const& scope) = delete;
+        ScopedFlushToZero& operator=(ScopedFlushToZero const& scope) = delete;
+
+    private:
+#ifdef JS80P_HAS_MXCSR
+        static constexpr unsigned int FLUSH_TO_ZERO_AND_DENORMALS_ARE_ZERO = (
+            0x8000 | 0x0040
+        );
+
+        unsigned int const previous_mode;
+#endif
+};
+
 }
 
 #endif
@@ -19,6 +19,8 @@
 #ifndef JS80P__DSP__MIDI_CONTROLLER_CPP
 #define JS80P__DSP__MIDI_CONTROLLER_CPP
 
+#include <algorithm>
+
 #include "dsp/midi_controller.hpp"
 
 
@@ -28,7 +30,14 @@ namespace JS80P
 MidiController::MidiController() noexcept
     : change_index(0),
     assignments(0),
+    discrete_assignments(0),
     value(0.5),
+    coalescing_tolerance(0.0),
+    segment_start_time_offset(0.0),
+    segment_start_value(0.0),
+    segment_min_slope(0.0),
+    segment_max_slope(0.0),
+    is_segment_started(false),
     events(events_rw)
 {
 }
@@ -40,11 +49,94 @@ void MidiController::change(
 ) noexcept {
     SignalProducer::Event event(EVT_CHANGE, time_offset, 0, new_value, 0.0);
 
+    if (is_on_segment(time_offset, new_value)) {
+        /*
+        The line between the start of the segment and the new change passes
+        close enough to the previous change, so the latter can be replaced.
+        */
+        events_rw.drop(events_rw.length() - 1);
+        narrow_segment(time_offset, new_value);
+    } else {
+        start_segment(time_offset, new_value);
+    }
+
     events_rw.push(event);
     change(new_value);
 }
 
 
+void MidiController::set_coalescing_tolerance(Number const tolerance) noexcept
+{
+    coalescing_tolerance = std::max(0.0, tolerance);
+    is_segment_started = false;
+}
+
+
+bool MidiController::is_on_segment(
+        Seconds const time_offset,
+        Number const new_value
+) const noexcept {
+    if (!is_segment_started || time_offset <= segment_start_time_offset) {
+        return false;
+    }
+
+    Number const slope = (
+        (new_value - segment_start_value)
+        / (time_offset - segment_start_time_offset)
+    );
+
+    return segment_min_slope <= slope && slope <= segment_max_slope;
+}
+
+
+void MidiController::start_segment(
+        Seconds const time_offset,
+        Number const new_value
+) noexcept {
+    is_segment_started = (
+        coalescing_tolerance > 0.0
+        && discrete_assignments == 0
+        && !events_rw.is_empty()
+        && time_offset > events_rw.back().time_offset
+    );
+
+    if (!is_segment_started) {
+        return;
+    }
+
+    SignalProducer::Event const& last_event = events_rw.back();
+
+    segment_start_time_offset = last_event.time_offset;
+    segment_start_value = last_event.number_param_1;
+
+    Seconds const duration = time_offset - segment_start_time_offset;
+
+    segment_min_slope = (
+        (new_value - coalescing_tolerance - segment_start_value) / duration
+    );
+    segment_max_slope = (
+        (new_value + coalescing_tolerance - segment_start_value) / duration
+    );
+}
+
+
+void MidiController::narrow_segment(
+        Seconds const time_offset,
+        Number const new_value
+) noexcept {
+    Seconds const duration = time_offset - segment_start_time_offset;
+
+    segment_min_slope = std::max(
+        segment_min_slope,
+        (new_value - coalescing_tolerance - segment_start_value) / duration
+    );
+    segment_max_slope = std::min(
+        segment_max_slope,
+        (new_value + coalescing_tolerance - segment_start_value) / duration
+    );
+}
+
+
 Integer MidiController::get_change_index() const noexcept
 {
     return change_index;
@@ -68,20 +160,30 @@ Number MidiController::get_value() const noexcept
 void MidiController::clear() noexcept
 {
     events_rw.drop(0);
+    is_segment_started = false;
 }
 
 
-void MidiController::assigned() noexcept
+void MidiController::assigned(bool const is_discrete) noexcept
 {
     ++assignments;
+
+    if (is_discrete) {
+        ++discrete_assignments;
+        is_segment_started = false;
+    }
 }
 
 
-void MidiController::released() noexcept
+void MidiController::released(bool const is_discrete) noexcept
 {
     if (is_assigned()) {
         --assignments;
     }
+
+    if (is_discrete && discrete_assignments != 0) {
+        --discrete_assignments;
+    }
 }
 
 
@@ -43,22 +43,64 @@ class MidiController
          *        an event with a time offset for sample-exact parameters.
          */
         void change(Seconds const time_offset, Number const new_value) noexcept;
+
+        /**
+         * \brief Keep only the endpoints of those runs of changes which lie
+         *        within \c tolerance of a straight line (e.g. dense host
+         *        automation), so that parameters which follow the controller
+         *        have fewer events to handle. Zero disables coalescing.
+         *
+         * \note Coalescing is suspended while the controller is assigned to
+         *       a discrete parameter (see assigned()), because those turn
+         *       each change into a step instead of a ramp, so dropping a
+         *       change would skip a step.
+         */
+        void set_coalescing_tolerance(Number const tolerance) noexcept;
+
         Integer get_change_index() const noexcept;
         Number get_value() const noexcept;
         void clear() noexcept;
 
-        void assigned() noexcept;
-        void released() noexcept;
+        void assigned(bool const is_discrete = false) noexcept;
+        void released(bool const is_discrete = false) noexcept;
         Integer is_assigned() const noexcept;
 
     protected:
         void change(Number const new_value) noexcept;
 
     private:
+        bool is_on_segment(
+            Seconds const time_offset,
+            Number const new_value
+        ) const noexcept;
+
+        void start_segment(
+            Seconds const time_offset,
+            Number const new_value
+        ) noexcept;
+
+        void narrow_segment(
+            Seconds const time_offset,
+            Number const new_value
+        ) noexcept;
+
         Queue<SignalProducer::Event> events_rw;
         Integer change_index;
         Integer assignments;
+        Integer discrete_assignments;
         Number value;
+        Number coalescing_tolerance;
+
+        /*
+        Swing door compression: a segment starts at the last event which is
+        kept, and the slopes of the lines from there which pass close enough
+        to all the subsequent changes so far are between the min and max.
+        */
+        Seconds segment_start_time_offset;
+        Number segment_start_value;
+        Number segment_min_slope;
+        Number segment_max_slope;
+        bool is_segment_started;
 
     public:
         Queue<SignalProducer::Event> const& events;
@@ -29,6 +29,165 @@
 namespace JS80P
 {
 
+CustomWaveform::CustomWaveform(
+        FloatParamB& harmonic_0,
+        FloatParamB& harmonic_1,
+        FloatParamB& harmonic_2,
+        FloatParamB& harmonic_3,
+        FloatParamB& harmonic_4,
+        FloatParamB& harmonic_5,
+        FloatParamB& harmonic_6,
+        FloatParamB& harmonic_7,
+        FloatParamB& harmonic_8,
+        FloatParamB& harmonic_9
+) noexcept
+    : published_wavetable(NULL),
+    wavetable_in_use(NULL),
+    requested_version(0),
+    wavetable(NULL),
+    built_version(0),
+    round(-1),
+    is_building_in_background(false)
+{
+    Number coefficients[HARMONICS];
+
+    params[0] = &harmonic_0;
+    params[1] = &harmonic_1;
+    params[2] = &harmonic_2;
+    params[3] = &harmonic_3;
+    params[4] = &harmonic_4;
+    params[5] = &harmonic_5;
+    params[6] = &harmonic_6;
+    params[7] = &harmonic_7;
+    params[8] = &harmonic_8;
+    params[9] = &harmonic_9;
+
+    for (Integer i = 0; i != HARMONICS; ++i) {
+        coefficients[i] = 0.0;
+        requested_coefficients[i].store(0.0);
+        change_indices[i] = -1;
+    }
+
+    for (Integer i = 0; i != WAVETABLES; ++i) {
+        wavetables[i] = new Wavetable(coefficients, HARMONICS);
+    }
+
+    wavetable = wavetables[0];
+    published_wavetable.store(wavetable);
+    wavetable_in_use.store(wavetable);
+}
+
+
+CustomWaveform::~CustomWaveform()
+{
+    for (Integer i = 0; i != WAVETABLES; ++i) {
+        delete wavetables[i];
+        wavetables[i] = NULL;
+    }
+
+    wavetable = NULL;
+}
+
+
+void CustomWaveform::set_background_building(bool const is_enabled) noexcept
+{
+    is_building_in_background = is_enabled;
+
+    if (!is_enabled) {
+        build();
+    }
+}
+
+
+void CustomWaveform::update(Integer const round) noexcept
+{
+    if (round == this->round) {
+        return;
+    }
+
+    this->round = round;
+
+    bool has_changed = false;
+
+    for (Integer i = 0; i != HARMONICS; ++i) {
+        Integer const param_change_idx = params[i]->get_change_index();
+
+        if (change_indices[i] != param_change_idx) {
+            change_indices[i] = param_change_idx;
+            has_changed = true;
+        }
+    }
+
+    if (has_changed) {
+        /* An odd version number means that the request is being written. */
+        requested_version.fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        for (Integer i = 0; i != HARMONICS; ++i) {
+            requested_coefficients[i].store(
+                params[i]->get_value(), std::memory_order_relaxed
+            );
+        }
+
+        requested_version.fetch_add(1, std::memory_order_release);
+
+        if (!is_building_in_background) {
+            build();
+        }
+    }
+
+    wavetable = published_wavetable.load(std::memory_order_acquire);
+    wavetable_in_use.store(wavetable, std::memory_order_release);
+}
+
+
+void CustomWaveform::build() noexcept
+{
+    Integer const version = requested_version.load(std::memory_order_acquire);
+
+    if ((version & 1) != 0 || version == built_version) {
+        return;
+    }
+
+    Number coefficients[HARMONICS];
+
+    for (Integer i = 0; i != HARMONICS; ++i) {
+        coefficients[i] = requested_coefficients[i].load(std::memory_order_relaxed);
+    }
+
+    /*
+    If a new request has been written while copying, then the coefficients may
+    be a mix of the two requests, so the next call will take care of it.
+    */
+    std::atomic_thread_fence(std::memory_order_acquire);
+
+    if (version != requested_version.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    Wavetable* const published = published_wavetable.load(std::memory_order_relaxed);
+    Wavetable* const in_use = wavetable_in_use.load(std::memory_order_acquire);
+    Wavetable* spare = NULL;
+
+    for (Integer i = 0; i != WAVETABLES; ++i) {
+        if (wavetables[i] != published && wavetables[i] != in_use) {
+            spare = wavetables[i];
+            break;
+        }
+    }
+
+    spare->update_coefficients(coefficients);
+    published_wavetable.store(spare, std::memory_order_release);
+    built_version = version;
+}
+
+
+Wavetable const* CustomWaveform::get_wavetable() const noexcept
+{
+    return wavetable;
+}
+
+
 template<class ModulatorSignalProducerClass, bool is_lfo>
 FloatParamS Oscillator<ModulatorSignalProducerClass, is_lfo>::dummy_param("", 0.0, 0.0, 0.0);
 
@@ -105,7 +264,8 @@ Oscillator<ModulatorSignalProducerClass, is_lfo>::Oscillator(
     harmonic_8("", -1.0, 1.0, 0.0),
     harmonic_9("", -1.0, 1.0, 0.0),
     tempo_sync(tempo_sync),
-    center(center)
+    center(center),
+    shared_custom_waveform(NULL)
 {
     initialize_instance();
 }
@@ -160,10 +320,6 @@ void Oscillator<ModulatorSignalProducerClass, is_lfo>::initialize_instance() noe
         custom_waveform_change_indices[i] = -1;
     }
 
-    custom_waveform = new Wavetable(
-        custom_waveform_coefficients, CUSTOM_WAVEFORM_HARMONICS
-    );
-
     wavetables[SINE] = StandardWaveforms::sine();
     wavetables[SAWTOOTH] = StandardWaveforms::sawtooth();
     wavetables[SOFT_SAWTOOTH] = StandardWaveforms::soft_sawtooth();
@@ -173,6 +329,9 @@ void Oscillator<ModulatorSignalProducerClass, is_lfo>::initialize_instance() noe
     wavetables[SOFT_TRIANGLE] = StandardWaveforms::soft_triangle();
     wavetables[SQUARE] = StandardWaveforms::square();
     wavetables[SOFT_SQUARE] = StandardWaveforms::soft_square();
+    custom_waveform = new Wavetable(
+        custom_waveform_coefficients, CUSTOM_WAVEFORM_HARMONICS
+    );
     wavetables[CUSTOM] = custom_waveform;
 
     allocate_buffers(block_size);
@@ -217,7 +376,8 @@ Oscillator<ModulatorSignalProducerClass, is_lfo>::Oscillator(
     harmonic_8("", -1.0, 1.0, 0.0),
     harmonic_9("", -1.0, 1.0, 0.0),
     tempo_sync(tempo_sync),
-    center(center)
+    center(center),
+    shared_custom_waveform(NULL)
 {
     initialize_instance();
 }
@@ -242,7 +402,8 @@ Oscillator<ModulatorSignalProducerClass, is_lfo>::Oscillator(
         ModulatorSignalProducerClass* modulator,
         FloatParamS& amplitude_modulation_level_leader,
         FloatParamS& frequency_modulation_level_leader,
-        FloatParamS& phase_modulation_level_leader
+        FloatParamS& phase_modulation_level_leader,
+        CustomWaveform* shared_custom_waveform
 ) noexcept
     : SignalProducer(1, NUMBER_OF_CHILDREN),
     waveform(waveform),
@@ -284,7 +445,8 @@ Oscillator<ModulatorSignalProducerClass, is_lfo>::Oscillator(
     harmonic_8(harmonic_8_leader),
     harmonic_9(harmonic_9_leader),
     tempo_sync(dummy_toggle),
-    center(dummy_toggle)
+    center(dummy_toggle),
+    shared_custom_waveform(shared_custom_waveform)
 {
     initialize_instance();
 }
@@ -439,37 +601,82 @@ Sample const* const* Oscillator<ModulatorSignalProducerClass, is_lfo>::initializ
     Waveform const waveform = this->waveform.get_value();
 
     if (waveform == CUSTOM) {
-        bool has_changed = false;
+        wavetable = update_custom_waveform(round, sample_count);
+    } else {
+        wavetable = wavetables[waveform];
+    }
 
-        for (Integer i = 0; i != CUSTOM_WAVEFORM_HARMONICS; ++i) {
-            Integer const param_change_idx = (
-                custom_waveform_params[i]->get_change_index()
-            );
+    compute_amplitude_buffer(round, sample_count);
+    compute_frequency_buffer(round, sample_count);
+    compute_phase_buffer(round, sample_count);
 
-            if (custom_waveform_change_indices[i] != param_change_idx) {
-                custom_waveform_coefficients[i] = (
-                    custom_waveform_params[i]->get_value()
-                );
-                custom_waveform_change_indices[i] = param_change_idx;
-                has_changed = true;
-            }
+    return NULL;
+}
+
+
+template<class ModulatorSignalProducerClass, bool is_lfo>
+bool Oscillator<ModulatorSignalProducerClass, is_lfo>::can_use_shared_custom_waveform() const noexcept
+{
+    if (shared_custom_waveform == NULL) {
+        return false;
+    }
+
+    /*
+    When a harmonic is controlled by an envelope, then each voice may have a
+    different value for it, so they need their own wavetable.
+    */
+    for (Integer i = 0; i != CUSTOM_WAVEFORM_HARMONICS; ++i) {
+        if (!custom_waveform_params[i]->is_following_leader()) {
+            return false;
+        }
+    }
+
+    return true;
+}
 
+
+template<class ModulatorSignalProducerClass, bool is_lfo>
+Wavetable const* Oscillator<ModulatorSignalProducerClass, is_lfo>::update_custom_waveform(
+        Integer const round,
+        Integer const sample_count
+) noexcept {
+    if (can_use_shared_custom_waveform()) {
+        for (Integer i = 0; i != CUSTOM_WAVEFORM_HARMONICS; ++i) {
             FloatParamB::produce_if_not_constant(
                 *custom_waveform_params[i], round, sample_count
             );
         }
 
-        if (has_changed) {
-            custom_waveform->update_coefficients(custom_waveform_coefficients);
+        shared_custom_waveform->update(round);
+
+        return shared_custom_waveform->get_wavetable();
+    }
+
+    bool has_changed = false;
+
+    for (Integer i = 0; i != CUSTOM_WAVEFORM_HARMONICS; ++i) {
+        Integer const param_change_idx = (
+            custom_waveform_params[i]->get_change_index()
+        );
+
+        if (custom_waveform_change_indices[i] != param_change_idx) {
+            custom_waveform_coefficients[i] = (
+                custom_waveform_params[i]->get_value()
+            );
+            custom_waveform_change_indices[i] = param_change_idx;
+            has_changed = true;
         }
+
+        FloatParamB::produce_if_not_constant(
+            *custom_waveform_params[i], round, sample_count
+        );
     }
 
-    wavetable = wavetables[waveform];
-    compute_amplitude_buffer(round, sample_count);
-    compute_frequency_buffer(round, sample_count);
-    compute_phase_buffer(round, sample_count);
+    if (has_changed) {
+        custom_waveform->update_coefficients(custom_waveform_coefficients);
+    }
 
-    return NULL;
+    return custom_waveform;
 }
 
 
@@ -546,12 +753,6 @@ void Oscillator<ModulatorSignalProducerClass, is_lfo>::compute_frequency_buffer(
         Integer const round,
         Integer const sample_count
 ) noexcept {
-    constexpr Byte NONE = 0;
-    constexpr Byte FREQUENCY = 1;
-    constexpr Byte DETUNE = 2;
-    constexpr Byte FINE_DETUNE = 4;
-    constexpr Byte ALL = FREQUENCY | DETUNE | FINE_DETUNE;
-
     Sample const* const frequency_buffer = (
         FloatParamS::produce_if_not_constant<ModulatedFloatParam>(
             frequency, round, sample_count
@@ -563,145 +764,69 @@ void Oscillator<ModulatorSignalProducerClass, is_lfo>::compute_frequency_buffer(
     Sample const* const fine_detune_buffer = (
         FloatParamS::produce_if_not_constant(fine_detune, round, sample_count)
     );
+    Frequency* const computed_frequency_buffer = this->computed_frequency_buffer;
 
-    Byte const_param_flags = (
-        frequency_buffer == NULL ? FREQUENCY : NONE
-    );
-
-    if (detune_buffer == NULL) {
-        const_param_flags |= DETUNE;
-    }
-
-    if (fine_detune_buffer == NULL) {
-        const_param_flags |= FINE_DETUNE;
-    }
-
-    switch (const_param_flags) {
-        case NONE: {
-            computed_frequency_is_constant = false;
-
-            for (Integer i = 0; i != sample_count; ++i) {
-                computed_frequency_buffer[i] = compute_frequency(
-                    (Number)frequency_buffer[i],
-                    (Number)detune_buffer[i],
-                    (Number)fine_detune_buffer[i]
-                );
-            }
-
-            break;
-        }
-
-        case FREQUENCY: {
-            Number const frequency_value = frequency.get_value();
-
-            computed_frequency_is_constant = false;
-
-            for (Integer i = 0; i != sample_count; ++i) {
-                computed_frequency_buffer[i] = compute_frequency(
-                    frequency_value,
-                    (Number)detune_buffer[i],
-                    (Number)fine_detune_buffer[i]
-                );
-            }
+    if (detune_buffer == NULL && fine_detune_buffer == NULL) {
+        if (frequency_buffer == NULL) {
+            computed_frequency_is_constant = true;
+            computed_frequency_value = compute_frequency(
+                frequency.get_value(), detune.get_value(), fine_detune.get_value()
+            );
 
-            break;
+            return;
         }
 
-        case DETUNE: {
-            Number const detune_value = detune.get_value();
+        Frequency const ratio = compute_frequency(
+            1.0, detune.get_value(), fine_detune.get_value()
+        );
 
-            computed_frequency_is_constant = false;
+        computed_frequency_is_constant = false;
 
-            for (Integer i = 0; i != sample_count; ++i) {
-                computed_frequency_buffer[i] = compute_frequency(
-                    (Number)frequency_buffer[i],
-                    detune_value,
-                    (Number)fine_detune_buffer[i]
-                );
-            }
-
-            break;
+        for (Integer i = 0; i != sample_count; ++i) {
+            computed_frequency_buffer[i] = (Frequency)frequency_buffer[i] * ratio;
         }
 
-        case FREQUENCY | DETUNE: {
-            Number const frequency_value = frequency.get_value();
-            Number const detune_value = detune.get_value();
+        return;
+    }
 
-            computed_frequency_is_constant = false;
+    computed_frequency_is_constant = false;
 
-            for (Integer i = 0; i != sample_count; ++i) {
-                computed_frequency_buffer[i] = compute_frequency(
-                    frequency_value,
-                    detune_value,
-                    (Number)fine_detune_buffer[i]
-                );
-            }
+    /*
+    The sum of the detune values goes into the buffer first, then it is
+    turned into frequency ratios block-wise, so that std::pow() doesn't need
+    to be called for every sample.
+    */
+    if (detune_buffer == NULL) {
+        Number const detune_value = detune.get_value();
 
-            break;
+        for (Integer i = 0; i != sample_count; ++i) {
+            computed_frequency_buffer[i] = detune_value + (Number)fine_detune_buffer[i];
         }
+    } else if (fine_detune_buffer == NULL) {
+        Number const fine_detune_value = fine_detune.get_value();
 
-        case FINE_DETUNE: {
-            Number const fine_detune_value = fine_detune.get_value();
-
-            computed_frequency_is_constant = false;
-
-            for (Integer i = 0; i != sample_count; ++i) {
-                computed_frequency_buffer[i] = compute_frequency(
-                    (Number)frequency_buffer[i],
-                    (Number)detune_buffer[i],
-                    fine_detune_value
-                );
-            }
-
-            break;
+        for (Integer i = 0; i != sample_count; ++i) {
+            computed_frequency_buffer[i] = (Number)detune_buffer[i] + fine_detune_value;
         }
-
-        case FREQUENCY | FINE_DETUNE: {
-            Number const frequency_value = frequency.get_value();
-            Number const fine_detune_value = fine_detune.get_value();
-
-            computed_frequency_is_constant = false;
-
-            for (Integer i = 0; i != sample_count; ++i) {
-                computed_frequency_buffer[i] = compute_frequency(
-                    frequency_value,
-                    (Number)detune_buffer[i],
-                    fine_detune_value
-                );
-            }
-
-            break;
+    } else {
+        for (Integer i = 0; i != sample_count; ++i) {
+            computed_frequency_buffer[i] = (
+                (Number)detune_buffer[i] + (Number)fine_detune_buffer[i]
+            );
         }
+    }
 
-        case DETUNE | FINE_DETUNE: {
-            Number const detune_value = detune.get_value();
-            Number const fine_detune_value = fine_detune.get_value();
-
-            computed_frequency_is_constant = false;
+    Math::detune_ratios(computed_frequency_buffer, sample_count);
 
-            for (Integer i = 0; i != sample_count; ++i) {
-                computed_frequency_buffer[i] = compute_frequency(
-                    (Number)frequency_buffer[i],
-                    detune_value,
-                    fine_detune_value
-                );
-            }
+    if (frequency_buffer == NULL) {
+        Frequency const frequency_value = frequency.get_value();
 
-            break;
+        for (Integer i = 0; i != sample_count; ++i) {
+            computed_frequency_buffer[i] *= frequency_value;
         }
-
-        default:
-        case ALL: {
-            Number const frequency_value = frequency.get_value();
-            Number const detune_value = detune.get_value();
-            Number const fine_detune_value = fine_detune.get_value();
-
-            computed_frequency_is_constant = true;
-            computed_frequency_value = compute_frequency(
-                frequency_value, detune_value, fine_detune_value
-            );
-
-            break;
+    } else {
+        for (Integer i = 0; i != sample_count; ++i) {
+            computed_frequency_buffer[i] *= (Frequency)frequency_buffer[i];
         }
     }
 }
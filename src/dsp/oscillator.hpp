@@ -19,6 +19,7 @@
 #ifndef JS80P__DSP__OSCILLATOR_HPP
 #define JS80P__DSP__OSCILLATOR_HPP
 
+#include <atomic>
 #include <string>
 #include <type_traits>
 
@@ -36,6 +37,87 @@ template<class ModulatorSignalProducerClass, bool is_lfo>
 class Oscillator;
 
 
+/**
+ * \brief Custom waveform which is built from a set of harmonic leader params,
+ *        so that oscillators which follow the same leaders can share it, and
+ *        it needs to be rebuilt only once per change, instead of once in each
+ *        oscillator.
+ *
+ * \note The wavetable can be rebuilt either in the audio thread, or in a
+ *       background thread (see set_background_building()), in which case the
+ *       new wavetable is built into a spare buffer, and it is swapped in at
+ *       the first update() after it's ready.
+ */
+class CustomWaveform
+{
+    public:
+        static constexpr Integer HARMONICS = 10;
+
+        CustomWaveform(
+            FloatParamB& harmonic_0,
+            FloatParamB& harmonic_1,
+            FloatParamB& harmonic_2,
+            FloatParamB& harmonic_3,
+            FloatParamB& harmonic_4,
+            FloatParamB& harmonic_5,
+            FloatParamB& harmonic_6,
+            FloatParamB& harmonic_7,
+            FloatParamB& harmonic_8,
+            FloatParamB& harmonic_9
+        ) noexcept;
+
+        ~CustomWaveform();
+
+        /**
+         * \warning This method must not be called while rendering is in
+         *          progress.
+         */
+        void set_background_building(bool const is_enabled) noexcept;
+
+        /**
+         * \brief Check if any of the harmonics have changed since the last
+         *        update, and request a new wavetable if so. Unless background
+         *        building is enabled, the new wavetable is built right away.
+         *        Multiple calls in the same round are no-ops.
+         *
+         * \warning When oscillators which share the waveform are rendered
+         *          on multiple threads, then this must be called before they
+         *          are rendered.
+         */
+        void update(Integer const round) noexcept;
+
+        /**
+         * \brief Build the most recently requested wavetable if it hasn't been
+         *        built yet. When background building is enabled, then this
+         *        must be called periodically from a single thread other than
+         *        the audio thread.
+         */
+        void build() noexcept;
+
+        Wavetable const* get_wavetable() const noexcept;
+
+    private:
+        /*
+        One wavetable is published for the audio thread, another one may still
+        be in use by the audio thread until its next update(), and the third
+        one is the spare into which the next wavetable is built.
+        */
+        static constexpr Integer WAVETABLES = 3;
+
+        FloatParamB* params[HARMONICS];
+        Integer change_indices[HARMONICS];
+        std::atomic<Number> requested_coefficients[HARMONICS];
+        Wavetable* wavetables[WAVETABLES];
+        std::atomic<Wavetable*> published_wavetable;
+        std::atomic<Wavetable*> wavetable_in_use;
+        std::atomic<Integer> requested_version;
+        Wavetable* wavetable;
+        Integer built_version;
+        Integer round;
+        bool is_building_in_background;
+};
+
+
 typedef Oscillator<SignalProducer, false> SimpleOscillator;
 
 
@@ -114,7 +196,8 @@ class Oscillator : public SignalProducer
             ModulatorSignalProducerClass* modulator = NULL,
             FloatParamS& amplitude_modulation_level_leader = dummy_param,
             FloatParamS& frequency_modulation_level_leader = dummy_param,
-            FloatParamS& phase_modulation_level_leader = dummy_param
+            FloatParamS& phase_modulation_level_leader = dummy_param,
+            CustomWaveform* shared_custom_waveform = NULL
         ) noexcept;
 
         ~Oscillator() override;
@@ -172,7 +255,7 @@ class Oscillator : public SignalProducer
 
         static constexpr Integer NUMBER_OF_CHILDREN = 17;
 
-        static constexpr Integer CUSTOM_WAVEFORM_HARMONICS = 10;
+        static constexpr Integer CUSTOM_WAVEFORM_HARMONICS = CustomWaveform::HARMONICS;
 
         void initialize_instance() noexcept;
         void allocate_buffers(Integer const size) noexcept;
@@ -180,6 +263,13 @@ class Oscillator : public SignalProducer
 
         void apply_toggle_params(Number const bpm) noexcept;
 
+        bool can_use_shared_custom_waveform() const noexcept;
+
+        Wavetable const* update_custom_waveform(
+            Integer const round,
+            Integer const sample_count
+        ) noexcept;
+
         void compute_amplitude_buffer(
             Integer const round,
             Integer const sample_count
@@ -234,6 +324,7 @@ class Oscillator : public SignalProducer
 
         ToggleParam& tempo_sync;
         ToggleParam& center;
+        CustomWaveform* const shared_custom_waveform;
         WavetableState wavetable_state;
         Wavetable const* wavetables[WAVEFORMS];
         Wavetable const* wavetable;
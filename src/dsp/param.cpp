@@ -205,12 +205,13 @@ template<typename NumberType, ParamEvaluation evaluation>
 template<class ParamClass>
 void Param<NumberType, evaluation>::set_midi_controller(
         ParamClass& param,
-        MidiController* midi_controller
+        MidiController* midi_controller,
+        bool const is_discrete
 ) noexcept {
     MidiController* old_midi_controller = param.get_midi_controller();
 
     if (old_midi_controller != NULL) {
-        old_midi_controller->released();
+        old_midi_controller->released(is_discrete);
 
         if (midi_controller == NULL) {
             param.set_value(
@@ -220,7 +221,7 @@ void Param<NumberType, evaluation>::set_midi_controller(
     }
 
     if (midi_controller != NULL) {
-        midi_controller->assigned();
+        midi_controller->assigned(is_discrete);
         param.set_value(param.ratio_to_value(midi_controller->get_value()));
     }
 
@@ -638,7 +639,11 @@ bool FloatParam<evaluation>::is_constant_until(
 
     Integer const last_sample_idx = sample_count - 1;
 
-    if (latest_event_type == EVT_LINEAR_RAMP || this->has_upcoming_events(last_sample_idx)) {
+    if (
+            latest_event_type == EVT_LINEAR_RAMP
+            || is_rendering_envelope_dahds()
+            || this->has_upcoming_events(last_sample_idx)
+    ) {
         return false;
     }
 
@@ -722,7 +727,7 @@ void FloatParam<evaluation>::schedule_linear_ramp(
     }
 
     this->schedule(
-        EVT_SET_VALUE, last_event_time_offset + duration, 0, 0.0, target_value
+        EVT_RAMP_END, last_event_time_offset + duration, 0, 0.0, target_value
     );
 }
 
@@ -733,12 +738,24 @@ void FloatParam<evaluation>::handle_event(
 ) noexcept {
     Param<Number, evaluation>::handle_event(event);
 
+    /*
+    Any event which interrupts a directly rendered envelope needs to take
+    over from the envelope's value at the current time.
+    */
+    if (latest_event_type == EVT_ENVELOPE_START) {
+        this->store_new_value(
+            ratio_to_value(dahds_state.get_ratio_at(dahds_state.position))
+        );
+        latest_event_type = EVT_SET_VALUE;
+    }
+
     switch (event.type) {
         case SignalProducer::EVT_CANCEL:
             handle_cancel_event(event);
             break;
 
         case EVT_SET_VALUE:
+        case EVT_RAMP_END:
             handle_set_value_event(event);
             break;
 
@@ -768,6 +785,26 @@ void FloatParam<evaluation>::handle_event(
 }
 
 
+/*
+The ramp handlers compensate for being late by calculating how many samples
+of the ramp have already been done, so only the beginning of a ramp gets
+delayed, not its end, and by the time a late ramp end event is handled, the
+ramp has already reached its target. Everything else (e.g. setting a value
+when a note is started, or starting an envelope) must happen at the exact
+sample.
+*/
+template<ParamEvaluation evaluation>
+bool FloatParam<evaluation>::is_event_time_critical(
+        SignalProducer::Event::Type const type
+) const noexcept {
+    return (
+        type != EVT_LINEAR_RAMP
+        && type != EVT_LOG_RAMP
+        && type != EVT_RAMP_END
+    );
+}
+
+
 template<ParamEvaluation evaluation>
 void FloatParam<evaluation>::handle_set_value_event(
         SignalProducer::Event const& event
@@ -858,6 +895,12 @@ void FloatParam<evaluation>::handle_envelope_start_event(
 ) noexcept {
     envelope_stage = EnvelopeStage::DAHDS;
     envelope_position = this->current_time - event.time_offset;
+
+    if (event.int_param != 0) {
+        dahds_state = scheduled_dahds_state;
+        dahds_state.position = envelope_position;
+        latest_event_type = EVT_ENVELOPE_START;
+    }
 }
 
 
@@ -899,7 +942,13 @@ template<ParamEvaluation evaluation>
 void FloatParam<evaluation>::set_midi_controller(
         MidiController* midi_controller
 ) noexcept {
-    Param<Number, evaluation>::template set_midi_controller< FloatParam<evaluation> >(*this, midi_controller);
+    /*
+    Rounded params turn controller changes into steps, so the controller must
+    not coalesce its changes while it is assigned to one of them.
+    */
+    Param<Number, evaluation>::template set_midi_controller< FloatParam<evaluation> >(
+        *this, midi_controller, should_round
+    );
 }
 
 
@@ -961,9 +1010,28 @@ void FloatParam<evaluation>::start_envelope(Seconds const time_offset) noexcept
 
     this->cancel_events_after(time_offset);
 
-    this->schedule(EVT_ENVELOPE_START, time_offset);
+    /*
+    There is only one snapshot of the envelope for the directly rendered DAHDS,
+    so if an earlier start is still waiting for it, then this one has to go
+    with the events.
+    */
+    bool const is_direct = (
+        is_dahds_rendered_directly() && !has_pending_direct_envelope_start()
+    );
+
+    this->schedule(EVT_ENVELOPE_START, time_offset, is_direct ? 1 : 0);
 
     Number const amount = envelope->amount.get_value();
+
+    envelope_final_value = amount * envelope->final_value.get_value();
+    envelope_release_time = (Seconds)envelope->release_time.get_value();
+
+    if (is_direct) {
+        scheduled_dahds_state.init(*envelope);
+
+        return;
+    }
+
     next_value = ratio_to_value(amount * envelope->initial_value.get_value());
 
     schedule_value(time_offset, next_value);
@@ -983,9 +1051,51 @@ void FloatParam<evaluation>::start_envelope(Seconds const time_offset) noexcept
         (Seconds)envelope->decay_time.get_value(),
         ratio_to_value(amount * envelope->sustain_value.get_value())
     );
+}
 
-    envelope_final_value = amount * envelope->final_value.get_value();
-    envelope_release_time = (Seconds)envelope->release_time.get_value();
+
+/*
+Parameters which are evaluated once per block are not rendered at all, and
+rounding would make the rendered values differ from the scheduled ones, so
+these need the events.
+*/
+template<ParamEvaluation evaluation>
+bool FloatParam<evaluation>::is_dahds_rendered_directly() const noexcept
+{
+    return evaluation == ParamEvaluation::SAMPLE && !should_round;
+}
+
+
+template<ParamEvaluation evaluation>
+bool FloatParam<evaluation>::has_pending_direct_envelope_start() const noexcept
+{
+    for (
+            Queue<SignalProducer::Event>::SizeType i = 0, l = this->events.length();
+            i != l;
+            ++i
+    ) {
+        SignalProducer::Event const& event = this->events[i];
+
+        if (event.type == EVT_ENVELOPE_START && event.int_param != 0) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+template<ParamEvaluation evaluation>
+bool FloatParam<evaluation>::is_rendering_envelope_dahds() const noexcept
+{
+    return latest_event_type == EVT_ENVELOPE_START && !dahds_state.is_done();
+}
+
+
+template<ParamEvaluation evaluation>
+bool FloatParam<evaluation>::is_envelope_releasing() const noexcept
+{
+    return envelope_stage == EnvelopeStage::R;
 }
 
 
@@ -1374,6 +1484,8 @@ void FloatParam<evaluation>::render(
             render_with_lfo(round, first_sample_index, last_sample_index, buffer);
         } else if (latest_event_type == EVT_LINEAR_RAMP) {
             render_linear_ramp(round, first_sample_index, last_sample_index, buffer);
+        } else if (latest_event_type == EVT_ENVELOPE_START) {
+            render_dahds(round, first_sample_index, last_sample_index, buffer);
         } else {
             Param<Number, evaluation>::render(
                 round, first_sample_index, last_sample_index, buffer
@@ -1437,6 +1549,115 @@ void FloatParam<evaluation>::render_linear_ramp(
 }
 
 
+template<ParamEvaluation evaluation>
+void FloatParam<evaluation>::render_dahds(
+        Integer const round,
+        Integer const first_sample_index,
+        Integer const last_sample_index,
+        Sample** buffer
+) noexcept {
+    if (last_sample_index == first_sample_index) {
+        return;
+    }
+
+    Sample* const samples = buffer[0];
+    Seconds const position = dahds_state.position;
+    Frequency const sample_rate = this->sample_rate;
+    Integer i = first_sample_index;
+
+    i = render_dahds_segment(
+        samples, first_sample_index, i, last_sample_index, position, sample_rate,
+        0.0, dahds_state.delay_end,
+        dahds_state.initial_ratio, dahds_state.initial_ratio
+    );
+    i = render_dahds_segment(
+        samples, first_sample_index, i, last_sample_index, position, sample_rate,
+        dahds_state.delay_end, dahds_state.attack_end,
+        dahds_state.initial_ratio, dahds_state.peak_ratio
+    );
+    i = render_dahds_segment(
+        samples, first_sample_index, i, last_sample_index, position, sample_rate,
+        dahds_state.attack_end, dahds_state.hold_end,
+        dahds_state.peak_ratio, dahds_state.peak_ratio
+    );
+    i = render_dahds_segment(
+        samples, first_sample_index, i, last_sample_index, position, sample_rate,
+        dahds_state.hold_end, dahds_state.decay_end,
+        dahds_state.peak_ratio, dahds_state.sustain_ratio
+    );
+
+    for (; i != last_sample_index; ++i) {
+        samples[i] = (Sample)dahds_state.sustain_ratio;
+    }
+
+    if (is_logarithmic()) {
+        for (i = first_sample_index; i != last_sample_index; ++i) {
+            samples[i] = (Sample)ratio_to_value_log((Number)samples[i]);
+        }
+    } else if (!is_ratio_same_as_value) {
+        for (i = first_sample_index; i != last_sample_index; ++i) {
+            samples[i] = (Sample)ratio_to_value_raw((Number)samples[i]);
+        }
+    }
+
+    this->store_new_value((Number)samples[last_sample_index - 1]);
+
+    dahds_state.position += this->sample_count_to_relative_time_offset(
+        last_sample_index - first_sample_index
+    );
+}
+
+
+/*
+Fill the samples whose position is before the end of the segment with a
+linear interpolation between the start and end ratios, and return the index
+of the first sample that belongs to a later segment.
+*/
+template<ParamEvaluation evaluation>
+Integer FloatParam<evaluation>::render_dahds_segment(
+        Sample* const buffer,
+        Integer const first_sample_index,
+        Integer const next_sample_index,
+        Integer const last_sample_index,
+        Seconds const start_position,
+        Frequency const sample_rate,
+        Seconds const segment_start,
+        Seconds const segment_end,
+        Number const segment_start_ratio,
+        Number const segment_end_ratio
+) noexcept {
+    Integer const end = std::min(
+        last_sample_index,
+        first_sample_index + (Integer)std::ceil(
+            (segment_end - start_position) * (Seconds)sample_rate
+        )
+    );
+
+    if (end <= next_sample_index) {
+        return next_sample_index;
+    }
+
+    Seconds const duration = segment_end - segment_start;
+    Number const delta_per_sample = (
+        (segment_end_ratio - segment_start_ratio)
+        / ((Number)duration * (Number)sample_rate)
+    );
+    Number const ratio_at_first_sample = (
+        segment_start_ratio
+        + (Number)(start_position - segment_start) * (Number)sample_rate
+            * delta_per_sample
+    );
+
+    for (Integer i = next_sample_index; i != end; ++i) {
+        buffer[i] = (Sample)(
+            ratio_at_first_sample + (Number)(i - first_sample_index) * delta_per_sample
+        );
+    }
+
+    return end;
+}
+
+
 template<ParamEvaluation evaluation>
 void FloatParam<evaluation>::advance_envelope(
         Integer const first_sample_index,
@@ -1486,7 +1707,8 @@ void FloatParam<evaluation>::LinearRampState::init(
 ) noexcept {
     this->is_logarithmic = is_logarithmic;
 
-    if (duration_in_samples > 0.0) {
+    /* A ramp which is handled late might have already been completed. */
+    if (duration_in_samples > done_samples) {
         is_done = false;
 
         this->start_time_offset = start_time_offset;
@@ -1536,6 +1758,69 @@ Number FloatParam<evaluation>::LinearRampState::get_value_at(
 }
 
 
+template<ParamEvaluation evaluation>
+FloatParam<evaluation>::DahdsState::DahdsState() noexcept
+    : position(0.0),
+    delay_end(0.0),
+    attack_end(0.0),
+    hold_end(0.0),
+    decay_end(0.0),
+    initial_ratio(0.0),
+    peak_ratio(0.0),
+    sustain_ratio(0.0)
+{
+}
+
+
+template<ParamEvaluation evaluation>
+void FloatParam<evaluation>::DahdsState::init(Envelope const& envelope) noexcept
+{
+    Number const amount = envelope.amount.get_value();
+
+    position = 0.0;
+    delay_end = (Seconds)envelope.delay_time.get_value();
+    attack_end = delay_end + (Seconds)envelope.attack_time.get_value();
+    hold_end = attack_end + (Seconds)envelope.hold_time.get_value();
+    decay_end = hold_end + (Seconds)envelope.decay_time.get_value();
+    initial_ratio = amount * envelope.initial_value.get_value();
+    peak_ratio = amount * envelope.peak_value.get_value();
+    sustain_ratio = amount * envelope.sustain_value.get_value();
+}
+
+
+template<ParamEvaluation evaluation>
+Number FloatParam<evaluation>::DahdsState::get_ratio_at(
+        Seconds const position
+) const noexcept {
+    if (position < delay_end) {
+        return initial_ratio;
+    } else if (position < attack_end) {
+        return (
+            initial_ratio
+            + (peak_ratio - initial_ratio)
+                * (Number)((position - delay_end) / (attack_end - delay_end))
+        );
+    } else if (position < hold_end) {
+        return peak_ratio;
+    } else if (position < decay_end) {
+        return (
+            peak_ratio
+            + (sustain_ratio - peak_ratio)
+                * (Number)((position - hold_end) / (decay_end - hold_end))
+        );
+    }
+
+    return sustain_ratio;
+}
+
+
+template<ParamEvaluation evaluation>
+bool FloatParam<evaluation>::DahdsState::is_done() const noexcept
+{
+    return position >= decay_end;
+}
+
+
 template<class ModulatorSignalProducerClass>
 ModulatableFloatParam<ModulatorSignalProducerClass>::ModulatableFloatParam(
         ModulatorSignalProducerClass* const modulator,
@@ -97,7 +97,8 @@ class Param : public SignalProducer
         template<class ParamClass>
         static void set_midi_controller(
             ParamClass& param,
-            MidiController* midi_controller
+            MidiController* midi_controller,
+            bool const is_discrete = false
         ) noexcept;
 
         template<class ParamClass>
@@ -173,6 +174,7 @@ class FloatParam : public Param<Number, evaluation>
         static constexpr SignalProducer::Event::Type EVT_ENVELOPE_START = 4;
         static constexpr SignalProducer::Event::Type EVT_ENVELOPE_END = 5;
         static constexpr SignalProducer::Event::Type EVT_ENVELOPE_CANCEL = 6;
+        static constexpr SignalProducer::Event::Type EVT_RAMP_END = 7;
 
         /*
         Some MIDI controllers seem to send multiple changes of the same value with
@@ -256,6 +258,8 @@ class FloatParam : public Param<Number, evaluation>
 
         Integer get_change_index() const noexcept;
 
+        bool is_following_leader() const noexcept;
+
         bool is_constant_in_next_round(
             Integer const round, Integer const sample_count
         ) noexcept;
@@ -284,6 +288,18 @@ class FloatParam : public Param<Number, evaluation>
         void cancel_envelope(Seconds const time_offset, Seconds const duration) noexcept;
         void update_envelope(Seconds const time_offset) noexcept;
 
+        /**
+         * \brief Tell whether the DAHDS stages of the envelope are still being
+         *        rendered without events (i.e. the value will keep changing
+         *        even though there are no events ahead).
+         */
+        bool is_rendering_envelope_dahds() const noexcept;
+
+        /**
+         * \brief Tell whether the release stage of the envelope has begun.
+         */
+        bool is_envelope_releasing() const noexcept;
+
         void set_lfo(LFO* lfo) noexcept;
         LFO const* get_lfo() const noexcept;
 
@@ -302,6 +318,10 @@ class FloatParam : public Param<Number, evaluation>
 
         void handle_event(SignalProducer::Event const& event) noexcept;
 
+        bool is_event_time_critical(
+            SignalProducer::Event::Type const type
+        ) const noexcept;
+
     private:
         enum EnvelopeStage {
             NONE = 0,
@@ -339,6 +359,47 @@ class FloatParam : public Param<Number, evaluation>
                 bool is_done;
         };
 
+        /*
+        The delay, attack, hold, and decay stages of an envelope are piecewise
+        linear, so they can be rendered directly from the time that has passed
+        since the envelope was started, without going through the event queue
+        segment by segment.
+        */
+        class DahdsState
+        {
+            public:
+                DahdsState() noexcept;
+
+                void init(Envelope const& envelope) noexcept;
+                Number get_ratio_at(Seconds const position) const noexcept;
+                bool is_done() const noexcept;
+
+                Seconds position;
+                Seconds delay_end;
+                Seconds attack_end;
+                Seconds hold_end;
+                Seconds decay_end;
+                Number initial_ratio;
+                Number peak_ratio;
+                Number sustain_ratio;
+        };
+
+        static Integer render_dahds_segment(
+            Sample* const buffer,
+            Integer const first_sample_index,
+            Integer const next_sample_index,
+            Integer const last_sample_index,
+            Seconds const start_position,
+            Frequency const sample_rate,
+            Seconds const segment_start,
+            Seconds const segment_end,
+            Number const segment_start_ratio,
+            Number const segment_end_ratio
+        ) noexcept;
+
+        bool is_dahds_rendered_directly() const noexcept;
+        bool has_pending_direct_envelope_start() const noexcept;
+
         Number round_value(Number const value) const noexcept;
         Number ratio_to_value_log(Number const ratio) const noexcept;
         Number ratio_to_value_raw(Number const ratio) const noexcept;
@@ -351,8 +412,6 @@ class FloatParam : public Param<Number, evaluation>
         void handle_envelope_end_event() noexcept;
         void handle_envelope_cancel_event() noexcept;
 
-        bool is_following_leader() const noexcept;
-
         Sample const* const* process_lfo(
             Integer const round,
             Integer const sample_count
@@ -385,6 +444,13 @@ class FloatParam : public Param<Number, evaluation>
             Sample** buffer
         ) noexcept;
 
+        void render_dahds(
+            Integer const round,
+            Integer const first_sample_index,
+            Integer const last_sample_index,
+            Sample** buffer
+        ) noexcept;
+
         void advance_envelope(
                 Integer const first_sample_index,
                 Integer const last_sample_index
@@ -432,6 +498,8 @@ class FloatParam : public Param<Number, evaluation>
         Number const round_to_inv;
 
         LinearRampState linear_ramp_state;
+        DahdsState scheduled_dahds_state;
+        DahdsState dahds_state;
         Integer constantness_round;
         bool constantness;
         SignalProducer::Event::Type latest_event_type;
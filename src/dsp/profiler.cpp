@@ -0,0 +1,374 @@
+/*
+ * This file is part of JS80P, a synthesizer plugin.
+ * Copyright (C) 2023  Attila M. Magyar
+ *
+ * JS80P is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * JS80P is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef JS80P__DSP__PROFILER_CPP
+#define JS80P__DSP__PROFILER_CPP
+
+#include "dsp/profiler.hpp"
+
+#ifdef JS80P_PROFILING
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define JS80P_PROFILER_RDTSC
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+
+#endif
+
+#ifdef __GNUG__
+#include <cxxabi.h>
+#endif
+
+
+namespace JS80P
+{
+
+thread_local Profiler::ThreadState Profiler::thread_state;
+
+Profiler::RingBuffer Profiler::ring_buffer;
+
+std::atomic<Integer> Profiler::node_types(0);
+
+std::atomic<Integer> Profiler::dropped_records(0);
+
+char const* Profiler::node_type_names[MAX_NODE_TYPES] = {NULL};
+
+Profiler::Record Profiler::totals[MAX_NODE_TYPES];
+
+
+Profiler::Record::Record() noexcept
+    : node_type(0),
+    calls(0),
+    cache_hits(0),
+    samples(0),
+    cycles(0)
+{
+}
+
+
+void Profiler::Record::clear() noexcept
+{
+    calls = 0;
+    cache_hits = 0;
+    samples = 0;
+    cycles = 0;
+}
+
+
+Profiler::Probe::Probe(Integer const node_type) noexcept
+    : start(now()),
+    outer_children_cycles(thread_state.children_cycles),
+    node_type(node_type),
+    sample_count(0),
+    is_cache_hit(false)
+{
+    thread_state.children_cycles = 0;
+}
+
+
+Profiler::Probe::~Probe()
+{
+    ThreadState& thread_state = Profiler::thread_state;
+    uint64_t const elapsed = now() - start;
+    Record& record = thread_state.records[node_type];
+
+    ++record.calls;
+    record.samples += sample_count;
+    record.cycles += elapsed - std::min(elapsed, thread_state.children_cycles);
+
+    if (is_cache_hit) {
+        ++record.cache_hits;
+    }
+
+    thread_state.children_cycles = outer_children_cycles + elapsed;
+}
+
+
+void Profiler::Probe::cache_hit() noexcept
+{
+    is_cache_hit = true;
+}
+
+
+void Profiler::Probe::set_sample_count(Integer const sample_count) noexcept
+{
+    this->sample_count = sample_count;
+}
+
+
+template<class SignalProducerClass>
+Integer Profiler::get_node_type() noexcept
+{
+    static Integer const node_type = register_node_type(
+        typeid(SignalProducerClass).name()
+    );
+
+    return node_type;
+}
+
+
+Integer Profiler::register_node_type(char const* const name) noexcept
+{
+    Integer const node_type = node_types.fetch_add(1);
+
+    if (node_type >= MAX_NODE_TYPES - 1) {
+        node_types.store(MAX_NODE_TYPES);
+        node_type_names[MAX_NODE_TYPES - 1] = "(other)";
+
+        return MAX_NODE_TYPES - 1;
+    }
+
+    node_type_names[node_type] = name;
+
+    return node_type;
+}
+
+
+char const* Profiler::get_node_type_name(Integer const node_type) noexcept
+{
+    if (node_type < 0 || node_type >= MAX_NODE_TYPES) {
+        return NULL;
+    }
+
+    return node_type_names[node_type];
+}
+
+
+void Profiler::flush() noexcept
+{
+    ThreadState& thread_state = Profiler::thread_state;
+    Integer const node_types = std::min(
+        MAX_NODE_TYPES, Profiler::node_types.load()
+    );
+
+    for (Integer node_type = 0; node_type != node_types; ++node_type) {
+        Record& record = thread_state.records[node_type];
+
+        if (record.calls == 0) {
+            continue;
+        }
+
+        record.node_type = node_type;
+
+        if (!ring_buffer.push(record)) {
+            dropped_records.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        record.clear();
+    }
+}
+
+
+bool Profiler::pop(Record& record) noexcept
+{
+    return ring_buffer.pop(record);
+}
+
+
+Integer Profiler::get_dropped_records() noexcept
+{
+    return dropped_records.load(std::memory_order_relaxed);
+}
+
+
+void Profiler::collect() noexcept
+{
+    Record record;
+
+    while (pop(record)) {
+        Record& total = totals[record.node_type];
+
+        total.calls += record.calls;
+        total.cache_hits += record.cache_hits;
+        total.samples += record.samples;
+        total.cycles += record.cycles;
+    }
+}
+
+
+void Profiler::dump(FILE* const file) noexcept
+{
+    Integer order[MAX_NODE_TYPES];
+
+    collect();
+
+    for (Integer i = 0; i != MAX_NODE_TYPES; ++i) {
+        order[i] = i;
+    }
+
+    std::sort(
+        &order[0],
+        &order[MAX_NODE_TYPES],
+        [](Integer const a, Integer const b) {
+            return totals[a].cycles > totals[b].cycles;
+        }
+    );
+
+    fprintf(
+        file,
+        "%16s %12s %12s %14s %10s  %s\n",
+        "cycles",
+        "calls",
+        "cache hits",
+        "samples",
+        "cyc/smp",
+        "node type"
+    );
+
+    for (Integer i = 0; i != MAX_NODE_TYPES; ++i) {
+        Record const& total = totals[order[i]];
+
+        if (total.calls == 0) {
+            continue;
+        }
+
+        char const* const name = get_node_type_name(order[i]);
+        char* demangled = NULL;
+
+#ifdef __GNUG__
+        int status = 0;
+        demangled = abi::__cxa_demangle(name, NULL, NULL, &status);
+#endif
+
+        fprintf(
+            file,
+            "%16llu %12lld %12lld %14lld %10.2f  %s\n",
+            (unsigned long long)total.cycles,
+            (long long)total.calls,
+            (long long)total.cache_hits,
+            (long long)total.samples,
+            (
+                total.samples > 0
+                    ? (double)total.cycles / (double)total.samples
+                    : 0.0
+            ),
+            demangled != NULL ? demangled : name
+        );
+
+        free(demangled);
+    }
+
+    fprintf(file, "dropped records: %lld\n", (long long)get_dropped_records());
+}
+
+
+uint64_t Profiler::now() noexcept
+{
+#ifdef JS80P_PROFILER_RDTSC
+    return (uint64_t)__rdtsc();
+#else
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()
+    ).count();
+#endif
+}
+
+
+Profiler::ThreadState::ThreadState() noexcept : children_cycles(0)
+{
+}
+
+
+Profiler::RingBuffer::RingBuffer() noexcept
+    : next_push(0),
+    next_pop(0)
+{
+    for (size_t i = 0; i != RING_BUFFER_SIZE; ++i) {
+        cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+
+bool Profiler::RingBuffer::push(Record const& record) noexcept
+{
+    size_t position = next_push.load(std::memory_order_relaxed);
+    Cell* cell;
+
+    while (true) {
+        cell = &cells[position & MASK];
+
+        size_t const sequence = cell->sequence.load(std::memory_order_acquire);
+        intptr_t const diff = (intptr_t)sequence - (intptr_t)position;
+
+        if (diff == 0) {
+            if (
+                    next_push.compare_exchange_weak(
+                        position, position + 1, std::memory_order_relaxed
+                    )
+            ) {
+                break;
+            }
+        } else if (diff < 0) {
+            return false;
+        } else {
+            position = next_push.load(std::memory_order_relaxed);
+        }
+    }
+
+    cell->record = record;
+    cell->sequence.store(position + 1, std::memory_order_release);
+
+    return true;
+}
+
+
+bool Profiler::RingBuffer::pop(Record& record) noexcept
+{
+    size_t position = next_pop.load(std::memory_order_relaxed);
+    Cell* cell;
+
+    while (true) {
+        cell = &cells[position & MASK];
+
+        size_t const sequence = cell->sequence.load(std::memory_order_acquire);
+        intptr_t const diff = (intptr_t)sequence - (intptr_t)(position + 1);
+
+        if (diff == 0) {
+            if (
+                    next_pop.compare_exchange_weak(
+                        position, position + 1, std::memory_order_relaxed
+                    )
+            ) {
+                break;
+            }
+        } else if (diff < 0) {
+            return false;
+        } else {
+            position = next_pop.load(std::memory_order_relaxed);
+        }
+    }
+
+    record = cell->record;
+    cell->sequence.store(position + MASK + 1, std::memory_order_release);
+
+    return true;
+}
+
+}
+
+#endif
+
+#endif
@@ -0,0 +1,181 @@
+/*
+ * This file is part of JS80P, a synthesizer plugin.
+ * Copyright (C) 2023  Attila M. Magyar
+ *
+ * JS80P is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * JS80P is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef JS80P__DSP__PROFILER_HPP
+#define JS80P__DSP__PROFILER_HPP
+
+/*
+The profiler is compiled only when JS80P_PROFILING is defined (see the
+PROFILING option in the Makefile), otherwise SignalProducer::produce() has no
+instrumentation at all.
+*/
+#ifdef JS80P_PROFILING
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <typeinfo>
+
+#include "js80p.hpp"
+
+
+namespace JS80P
+{
+
+/**
+ * \brief Collect per \c SignalProducer class statistics about rendering:
+ *        number of \c produce() calls, how many of them were served from
+ *        the cache of the current round, number of rendered samples, and
+ *        CPU cycles spent in the class itself (excluding the time spent in
+ *        rendering other \c SignalProducer objects).
+ *
+ * \note Statistics are accumulated in thread-local tables, and each
+ *       rendering thread publishes its own table into a lockless ring buffer
+ *       when it calls \c flush(). A non-audio thread can retrieve them with
+ *       \c pop() or \c dump().
+ */
+class Profiler
+{
+    public:
+        static constexpr Integer MAX_NODE_TYPES = 128;
+        static constexpr size_t RING_BUFFER_SIZE = 4096;
+
+        class Record
+        {
+            public:
+                Record() noexcept;
+
+                void clear() noexcept;
+
+                Integer node_type;
+                Integer calls;
+                Integer cache_hits;
+                Integer samples;
+                uint64_t cycles;
+        };
+
+        class Probe
+        {
+            public:
+                Probe(Integer const node_type) noexcept;
+                ~Probe();
+
+                void cache_hit() noexcept;
+                void set_sample_count(Integer const sample_count) noexcept;
+
+            private:
+                uint64_t const start;
+                uint64_t const outer_children_cycles;
+                Integer const node_type;
+                Integer sample_count;
+                bool is_cache_hit;
+        };
+
+        template<class SignalProducerClass>
+        static Integer get_node_type() noexcept;
+
+        static char const* get_node_type_name(Integer const node_type) noexcept;
+
+        /**
+         * \brief Publish the statistics of the calling thread, and start
+         *        collecting new ones. (Should be called by the rendering
+         *        threads, e.g. at the end of each round.)
+         */
+        static void flush() noexcept;
+
+        /**
+         * \brief Retrieve a record which was published by \c flush().
+         *        (Should be called by a single, non-audio thread.)
+         */
+        static bool pop(Record& record) noexcept;
+
+        /**
+         * \brief Number of records which were lost because the ring buffer
+         *        was full.
+         */
+        static Integer get_dropped_records() noexcept;
+
+        /**
+         * \brief Drain the ring buffer into the totals. (Should be called
+         *        regularly by the same thread which calls \c dump().)
+         */
+        static void collect() noexcept;
+
+        /**
+         * \brief Collect the remaining records, and print the totals ordered
+         *        by CPU cycles. (Not real-time safe.)
+         */
+        static void dump(FILE* const file) noexcept;
+
+        static uint64_t now() noexcept;
+
+    private:
+        class ThreadState
+        {
+            public:
+                ThreadState() noexcept;
+
+                Record records[MAX_NODE_TYPES];
+                uint64_t children_cycles;
+        };
+
+        /*
+        See Dmitry Vyukov: Bounded MPMC queue
+          https://www.1024cores.net/home/lock-free-algorithms/queues/bounded-mpmc-queue
+        */
+        class RingBuffer
+        {
+            public:
+                RingBuffer() noexcept;
+
+                bool push(Record const& record) noexcept;
+                bool pop(Record& record) noexcept;
+
+            private:
+                static constexpr size_t MASK = RING_BUFFER_SIZE - 1;
+
+                class Cell
+                {
+                    public:
+                        std::atomic<size_t> sequence;
+                        Record record;
+                };
+
+                Cell cells[RING_BUFFER_SIZE];
+
+                alignas(64) std::atomic<size_t> next_push;
+                alignas(64) std::atomic<size_t> next_pop;
+        };
+
+        static Integer register_node_type(char const* const name) noexcept;
+
+        static thread_local ThreadState thread_state;
+
+        static RingBuffer ring_buffer;
+        static std::atomic<Integer> node_types;
+        static std::atomic<Integer> dropped_records;
+        static char const* node_type_names[MAX_NODE_TYPES];
+        static Record totals[MAX_NODE_TYPES];
+};
+
+}
+
+#endif
+
+#endif
@@ -19,6 +19,9 @@
 #ifndef JS80P__DSP__REVERB_CPP
 #define JS80P__DSP__REVERB_CPP
 
+#include <algorithm>
+#include <cmath>
+
 #include "dsp/reverb.hpp"
 
 #include "dsp/math.hpp"
@@ -44,11 +47,7 @@ template<class InputSignalProducerClass>
 Reverb<InputSignalProducerClass>::Reverb(
         std::string const name,
         InputSignalProducerClass& input
-) : SideChainCompressableEffect<InputSignalProducerClass>(
-        name,
-        input,
-        12 + COMB_FILTERS
-    ),
+) : SideChainCompressableEffect<InputSignalProducerClass>(name, input, 14),
     type(name+ "TYP"),
     room_size(name + "RS", 0.0, 0.999, 0.75),
     damping_frequency(
@@ -76,7 +75,6 @@ Reverb<InputSignalProducerClass>::Reverb(
         Math::LOG_BIQUAD_FILTER_FREQ_SCALE
     ),
     log_scale_frequencies(name + "LOG", ToggleParam::OFF),
-    mixer(input.get_channels()),
     high_pass_filter_type(""),
     high_pass_filter_q(
         "",
@@ -90,6 +88,13 @@ Reverb<InputSignalProducerClass>::Reverb(
         Constants::BIQUAD_FILTER_GAIN_MAX,
         0.0
     ),
+    damping_filter_type(""),
+    damping_filter_q(
+        "",
+        Constants::BIQUAD_FILTER_Q_MIN,
+        Constants::BIQUAD_FILTER_Q_MAX,
+        Constants::BIQUAD_FILTER_Q_DEFAULT
+    ),
     high_pass_filter(
         input,
         high_pass_filter_type,
@@ -97,112 +102,23 @@ Reverb<InputSignalProducerClass>::Reverb(
         high_pass_filter_q,
         high_pass_filter_gain
     ),
-    comb_filters{
-        {
-            high_pass_filter,
-            PannedDelayStereoMode::NORMAL,
-            width,
-            room_size,
-            TUNINGS[0][0].delay_time,
-            DELAY_TIME_MAX,
-            damping_frequency,
-            damping_gain
-        },
-        {
-            high_pass_filter,
-            PannedDelayStereoMode::NORMAL,
-            width,
-            room_size,
-            TUNINGS[0][1].delay_time,
-            DELAY_TIME_MAX,
-            damping_frequency,
-            damping_gain
-        },
-        {
-            high_pass_filter,
-            PannedDelayStereoMode::NORMAL,
-            width,
-            room_size,
-            TUNINGS[0][2].delay_time,
-            DELAY_TIME_MAX,
-            damping_frequency,
-            damping_gain
-        },
-        {
-            high_pass_filter,
-            PannedDelayStereoMode::NORMAL,
-            width,
-            room_size,
-            TUNINGS[0][3].delay_time,
-            DELAY_TIME_MAX,
-            damping_frequency,
-            damping_gain
-        },
-        {
-            high_pass_filter,
-            PannedDelayStereoMode::NORMAL,
-            width,
-            room_size,
-            TUNINGS[0][4].delay_time,
-            DELAY_TIME_MAX,
-            damping_frequency,
-            damping_gain
-        },
-        {
-            high_pass_filter,
-            PannedDelayStereoMode::NORMAL,
-            width,
-            room_size,
-            TUNINGS[0][5].delay_time,
-            DELAY_TIME_MAX,
-            damping_frequency,
-            damping_gain
-        },
-        {
-            high_pass_filter,
-            PannedDelayStereoMode::NORMAL,
-            width,
-            room_size,
-            TUNINGS[0][6].delay_time,
-            DELAY_TIME_MAX,
-            damping_frequency,
-            damping_gain
-        },
-        {
-            high_pass_filter,
-            PannedDelayStereoMode::NORMAL,
-            width,
-            room_size,
-            TUNINGS[0][7].delay_time,
-            DELAY_TIME_MAX,
-            damping_frequency,
-            damping_gain
-        },
-        {
-            high_pass_filter,
-            PannedDelayStereoMode::NORMAL,
-            width,
-            room_size,
-            TUNINGS[0][8].delay_time,
-            DELAY_TIME_MAX,
-            damping_frequency,
-            damping_gain
-        },
-        {
-            high_pass_filter,
-            PannedDelayStereoMode::NORMAL,
-            width,
-            room_size,
-            TUNINGS[0][9].delay_time,
-            DELAY_TIME_MAX,
-            damping_frequency,
-            damping_gain
-        },
-    },
+    damping_filter(
+        high_pass_filter,
+        damping_filter_type,
+        damping_frequency,
+        damping_filter_q,
+        damping_gain
+    ),
+    delay_buffer(NULL),
+    lanes_buffer(NULL),
+    room_size_buffer(NULL),
+    width_buffer(NULL),
+    delay_buffer_size(0),
+    delay_buffer_mask(0),
+    lines_count(0),
+    lane_groups(0),
     previous_type(255)
 {
-    this->register_child(mixer);
-
     this->register_child(type);
     this->register_child(room_size);
     this->register_child(damping_frequency);
@@ -215,21 +131,110 @@ Reverb<InputSignalProducerClass>::Reverb(
     this->register_child(high_pass_filter_q);
     this->register_child(high_pass_filter_gain);
 
+    this->register_child(damping_filter_type);
+    this->register_child(damping_filter_q);
+
     this->register_child(high_pass_filter);
+    this->register_child(damping_filter);
 
-    for (size_t i = 0; i != COMB_FILTERS; ++i) {
-        comb_filters[i].delay.set_feedback_signal_producer(
-            &comb_filters[i].high_shelf_filter
-        );
-        comb_filters[i].high_shelf_filter.set_shared_cache(
-            &high_shelf_filter_shared_cache
-        );
+    high_pass_filter_type.set_value(HighPassedInput::HIGH_PASS);
+    damping_filter_type.set_value(DampingFilter::HIGH_SHELF);
+
+    reallocate_buffers();
+    update_tunings(REVERB_1);
+    previous_type = 255;
+}
+
+
+template<class InputSignalProducerClass>
+Reverb<InputSignalProducerClass>::~Reverb()
+{
+    free_buffers();
+}
+
+
+template<class InputSignalProducerClass>
+void Reverb<InputSignalProducerClass>::set_sample_rate(
+        Frequency const new_sample_rate
+) noexcept {
+    SideChainCompressableEffect<InputSignalProducerClass>::set_sample_rate(
+        new_sample_rate
+    );
+
+    reallocate_buffers();
+    update_delay_times();
+}
+
+
+template<class InputSignalProducerClass>
+void Reverb<InputSignalProducerClass>::set_block_size(
+        Integer const new_block_size
+) noexcept {
+    SideChainCompressableEffect<InputSignalProducerClass>::set_block_size(
+        new_block_size
+    );
+
+    reallocate_buffers();
+}
+
+
+template<class InputSignalProducerClass>
+void Reverb<InputSignalProducerClass>::reallocate_buffers() noexcept
+{
+    /*
+    Room for the longest delay, the interpolation, and the feedback of the
+    current block, which is written one block ahead.
+    */
+    Integer const min_size = (
+        (Integer)std::ceil(this->sample_rate * DELAY_TIME_MAX)
+        + 2
+        + 2 * this->block_size
+    );
+    Integer new_delay_buffer_size = 1;
 
-        mixer.add(comb_filters[i]);
-        this->register_child(comb_filters[i]);
+    while (new_delay_buffer_size < min_size) {
+        new_delay_buffer_size <<= 1;
     }
 
-    high_pass_filter_type.set_value(HighPassedInput::HIGH_PASS);
+    free_buffers();
+
+    delay_buffer_size = new_delay_buffer_size;
+    delay_buffer_mask = new_delay_buffer_size - 1;
+    delay_buffer = new Sample[LANES_MAX * delay_buffer_size];
+    lanes_buffer = new SampleVector[LANE_GROUPS_MAX * this->block_size];
+
+    clear_comb_filters();
+}
+
+
+template<class InputSignalProducerClass>
+void Reverb<InputSignalProducerClass>::free_buffers() noexcept
+{
+    if (delay_buffer != NULL) {
+        delete[] delay_buffer;
+
+        delay_buffer = NULL;
+    }
+
+    if (lanes_buffer != NULL) {
+        delete[] lanes_buffer;
+
+        lanes_buffer = NULL;
+    }
+}
+
+
+template<class InputSignalProducerClass>
+void Reverb<InputSignalProducerClass>::clear_comb_filters() noexcept
+{
+    std::fill_n(delay_buffer, LANES_MAX * delay_buffer_size, 0.0);
+    std::fill_n(x_n_m1, LANE_GROUPS_MAX * LANES, 0.0);
+    std::fill_n(x_n_m2, LANE_GROUPS_MAX * LANES, 0.0);
+    std::fill_n(y_n_m1, LANE_GROUPS_MAX * LANES, 0.0);
+    std::fill_n(y_n_m2, LANE_GROUPS_MAX * LANES, 0.0);
+
+    write_index = 0;
+    silent_samples = delay_buffer_size;
 }
 
 
@@ -238,10 +243,90 @@ void Reverb<InputSignalProducerClass>::reset() noexcept
 {
     SideChainCompressableEffect<InputSignalProducerClass>::reset();
 
+    clear_comb_filters();
+
     previous_type = 255;
 }
 
 
+template<class InputSignalProducerClass>
+void Reverb<InputSignalProducerClass>::update_tunings(Type const type) noexcept
+{
+    Tuning const* const tunings = TUNINGS[type];
+
+    lines_count = 0;
+
+    for (size_t i = 0; i != COMB_FILTERS; ++i) {
+        Tuning const& tuning = tunings[i];
+
+        if (tuning.weight < 0.000001) {
+            continue;
+        }
+
+        delay_times[lines_count] = tuning.delay_time;
+        weights[lines_count] = (Sample)tuning.weight;
+        panning_scales[lines_count] = tuning.panning_scale;
+
+        ++lines_count;
+    }
+
+    lane_groups = (lines_count * LINE_CHANNELS + LANES - 1) / LANES;
+
+    update_delay_times();
+    clear_comb_filters();
+}
+
+
+template<class InputSignalProducerClass>
+bool Reverb<InputSignalProducerClass>::is_tail_silent() const noexcept
+{
+    return silent_samples >= delay_buffer_size;
+}
+
+
+template<class InputSignalProducerClass>
+Seconds Reverb<InputSignalProducerClass>::get_tail_length() const noexcept
+{
+    if (this->wet.get_value() < 0.000001) {
+        return 0.0;
+    }
+
+    Seconds longest_delay = 0.0;
+
+    for (Integer l = 0; l != lines_count; ++l) {
+        longest_delay = std::max(longest_delay, delay_times[l]);
+    }
+
+    Number const room_size = this->room_size.get_value();
+
+    if (room_size < SignalProducer::SILENCE_THRESHOLD) {
+        return longest_delay;
+    }
+
+    /*
+    Damping can only make the lines decay faster, so this is an upper bound.
+    */
+    Number const repetitions = std::ceil(
+        std::log(SignalProducer::SILENCE_THRESHOLD) / std::log(room_size)
+    );
+
+    return longest_delay * (1.0 + repetitions);
+}
+
+
+template<class InputSignalProducerClass>
+void Reverb<InputSignalProducerClass>::update_delay_times() noexcept
+{
+    for (Integer l = 0; l != lines_count; ++l) {
+        Number const delay = delay_times[l] * this->sample_rate;
+        Number const delay_floor = std::floor(delay);
+
+        delays[l] = (Integer)delay_floor;
+        delay_fractions[l] = (Sample)(delay - delay_floor);
+    }
+}
+
+
 template<class InputSignalProducerClass>
 Sample const* const* Reverb<InputSignalProducerClass>::initialize_rendering(
         Integer const round,
@@ -265,29 +350,407 @@ Sample const* const* Reverb<InputSignalProducerClass>::initialize_rendering(
         update_tunings(type);
     }
 
-    mixer.set_output_buffer(this->buffer);
-    SignalProducer::produce< Mixer<CombFilter> >(mixer, round, sample_count);
+    Sample const* const* const high_pass_filter_buffer = (
+        SignalProducer::produce<HighPassedInput>(high_pass_filter, round, sample_count)
+    );
+    bool const is_input_silent = high_pass_filter.is_silent(round, sample_count);
+
+    room_size_buffer = FloatParamS::produce_if_not_constant(
+        room_size, round, sample_count
+    );
+    width_buffer = FloatParamS::produce_if_not_constant(
+        width, round, sample_count
+    );
+
+    typename DampingFilter::Coefficients coefficients;
+
+    bool const are_coefficients_constant = damping_filter.update_coefficients(
+        round, sample_count, coefficients
+    );
+
+    Sample** const wet_buffer = this->buffer;
+
+    if (is_input_silent && silent_samples >= delay_buffer_size) {
+        for (Integer c = 0; c != this->channels; ++c) {
+            std::fill_n(wet_buffer[c], sample_count, 0.0);
+        }
+
+        return NULL;
+    }
+
+    if (room_size_buffer == NULL) {
+        read_delay_lines<true>(high_pass_filter_buffer, sample_count);
+    } else {
+        read_delay_lines<false>(high_pass_filter_buffer, sample_count);
+    }
+
+    Sample const feedback_peak = (
+        are_coefficients_constant
+            ? apply_damping<true>(coefficients, sample_count)
+            : apply_damping<false>(coefficients, sample_count)
+    );
+
+    if (feedback_peak < SignalProducer::SILENCE_THRESHOLD) {
+        snap_lanes_to_zero(sample_count);
+    }
+
+    write_feedback(sample_count);
+
+    if (width_buffer == NULL) {
+        mix_lines_with_constant_width(sample_count);
+    } else {
+        mix_lines_with_changing_width(sample_count);
+    }
+
+    write_index = (write_index + sample_count) & delay_buffer_mask;
+
+    if (is_input_silent && feedback_peak < SignalProducer::SILENCE_THRESHOLD) {
+        silent_samples += sample_count;
+
+        if (silent_samples >= delay_buffer_size) {
+            clear_comb_filters();
+        }
+    } else {
+        silent_samples = 0;
+    }
 
     return NULL;
 }
 
 
 template<class InputSignalProducerClass>
-void Reverb<InputSignalProducerClass>::update_tunings(Byte const type) noexcept
-{
-    Tuning const* const tunings = TUNINGS[type];
+template<bool is_room_size_constant>
+void Reverb<InputSignalProducerClass>::read_delay_lines(
+        Sample const* const* input_buffer,
+        Integer const sample_count
+) noexcept {
+    Integer const lanes_count = lines_count * LINE_CHANNELS;
+    Integer const block_size = this->block_size;
+    Integer const delay_buffer_mask = this->delay_buffer_mask;
+    Integer const write_index = this->write_index;
+    Sample const room_size_value = (Sample)room_size.get_value();
+
+    for (Integer g = 0; g != lane_groups; ++g) {
+        SampleVector* const lanes = &lanes_buffer[g * block_size];
+
+        for (Integer i = 0; i != sample_count; ++i) {
+            lanes[i] = SampleVector{};
+        }
+    }
 
-    mixer.reset();
+    for (Integer l = 0; l != lanes_count; ++l) {
+        Integer const line = l / LINE_CHANNELS;
+        Integer const lane = l % LANES;
+        Sample const* const input = input_buffer[l % LINE_CHANNELS];
+        Sample* const delay_line = &delay_buffer[l * delay_buffer_size];
+        Sample* const lanes = (
+            (Sample*)&lanes_buffer[(l / LANES) * block_size] + lane
+        );
+        Integer const delay = delays[line];
+        Sample const after_weight = delay_fractions[line];
+        Sample const before_weight = 1.0 - after_weight;
 
-    for (size_t i = 0; i != COMB_FILTERS; ++i) {
-        Tuning const& tuning = tunings[i];
-        CombFilter& comb_filter = comb_filters[i];
+        /*
+        The feedback for the current block has already been written, so only
+        the input needs to be added.
+        */
+        Integer i = 0;
+        Integer j = write_index;
+
+        while (i != sample_count) {
+            Integer const end = std::min(sample_count, i + delay_buffer_size - j);
+
+            for (; i != end; ++i, ++j) {
+                delay_line[j] += input[i];
+            }
+
+            j = 0;
+        }
+
+        i = 0;
+        j = (write_index - delay) & delay_buffer_mask;
+
+        Sample previous_sample = delay_line[(j - 1) & delay_buffer_mask];
+
+        while (i != sample_count) {
+            Integer const end = std::min(sample_count, i + delay_buffer_size - j);
+
+            for (; i != end; ++i, ++j) {
+                Sample const current_sample = delay_line[j];
+                Sample const sample = (
+                    before_weight * current_sample + after_weight * previous_sample
+                );
+
+                previous_sample = current_sample;
+
+                if constexpr (is_room_size_constant) {
+                    lanes[i * LANES] = room_size_value * sample;
+                } else {
+                    lanes[i * LANES] = room_size_buffer[i] * sample;
+                }
+            }
+
+            j = 0;
+        }
+    }
+}
+
+
+template<class InputSignalProducerClass>
+template<bool are_coefficients_constant>
+Sample Reverb<InputSignalProducerClass>::apply_damping(
+        typename DampingFilter::Coefficients const& coefficients,
+        Integer const sample_count
+) noexcept {
+    Integer const block_size = this->block_size;
+    SampleVector peak = {};
+
+    for (Integer g = 0; g != lane_groups; ++g) {
+        SampleVector* const lanes = &lanes_buffer[g * block_size];
+        Integer const first_lane = g * LANES;
+        SampleVector x_n_m1 = {};
+        SampleVector x_n_m2 = {};
+        SampleVector y_n_m1 = {};
+        SampleVector y_n_m2 = {};
+
+        for (Integer l = 0; l != LANES; ++l) {
+            x_n_m1[l] = this->x_n_m1[first_lane + l];
+            x_n_m2[l] = this->x_n_m2[first_lane + l];
+            y_n_m1[l] = this->y_n_m1[first_lane + l];
+            y_n_m2[l] = this->y_n_m2[first_lane + l];
+        }
+
+        if constexpr (are_coefficients_constant) {
+            Sample const b0 = coefficients.b0[0];
+            Sample const b1 = coefficients.b1[0];
+            Sample const b2 = coefficients.b2[0];
+            Sample const a1 = coefficients.a1[0];
+            Sample const a2 = coefficients.a2[0];
+
+            for (Integer i = 0; i != sample_count; ++i) {
+                SampleVector const x_n = lanes[i];
+                SampleVector const y_n = (
+                    b0 * x_n + b1 * x_n_m1 + b2 * x_n_m2
+                    - a1 * y_n_m1 - a2 * y_n_m2
+                );
+
+                lanes[i] = y_n;
+                peak = peak > y_n ? peak : y_n;
+                peak = peak > -y_n ? peak : -y_n;
+
+                x_n_m2 = x_n_m1;
+                x_n_m1 = x_n;
+                y_n_m2 = y_n_m1;
+                y_n_m1 = y_n;
+            }
+        } else {
+            Sample const* const b0 = coefficients.b0;
+            Sample const* const b1 = coefficients.b1;
+            Sample const* const b2 = coefficients.b2;
+            Sample const* const a1 = coefficients.a1;
+            Sample const* const a2 = coefficients.a2;
+
+            for (Integer i = 0; i != sample_count; ++i) {
+                SampleVector const x_n = lanes[i];
+                SampleVector const y_n = (
+                    b0[i] * x_n + b1[i] * x_n_m1 + b2[i] * x_n_m2
+                    - a1[i] * y_n_m1 - a2[i] * y_n_m2
+                );
+
+                lanes[i] = y_n;
+                peak = peak > y_n ? peak : y_n;
+                peak = peak > -y_n ? peak : -y_n;
+
+                x_n_m2 = x_n_m1;
+                x_n_m1 = x_n;
+                y_n_m2 = y_n_m1;
+                y_n_m1 = y_n;
+            }
+        }
+
+        for (Integer l = 0; l != LANES; ++l) {
+            this->x_n_m1[first_lane + l] = x_n_m1[l];
+            this->x_n_m2[first_lane + l] = x_n_m2[l];
+            this->y_n_m1[first_lane + l] = y_n_m1[l];
+            this->y_n_m2[first_lane + l] = y_n_m2[l];
+        }
+    }
 
-        comb_filter.reset();
-        comb_filter.delay.time.set_value(tuning.delay_time);
-        comb_filter.set_panning_scale(tuning.panning_scale);
+    Sample peak_sample = 0.0;
 
-        mixer.set_weight(i, tuning.weight);
+    for (Integer l = 0; l != LANES; ++l) {
+        peak_sample = std::max(peak_sample, peak[l]);
+    }
+
+    return peak_sample;
+}
+
+
+/*
+Below the silence threshold, the feedback would only keep decaying towards the
+denormal range for a long time, so it's snapped to zero along with the state of
+the damping filter, and the delay lines become silent as soon as their remaining
+contents have been read out.
+*/
+template<class InputSignalProducerClass>
+void Reverb<InputSignalProducerClass>::snap_lanes_to_zero(
+        Integer const sample_count
+) noexcept {
+    Integer const block_size = this->block_size;
+
+    for (Integer g = 0; g != lane_groups; ++g) {
+        SampleVector* const lanes = &lanes_buffer[g * block_size];
+
+        for (Integer i = 0; i != sample_count; ++i) {
+            lanes[i] = SampleVector{};
+        }
+    }
+
+    std::fill_n(x_n_m1, LANE_GROUPS_MAX * LANES, 0.0);
+    std::fill_n(x_n_m2, LANE_GROUPS_MAX * LANES, 0.0);
+    std::fill_n(y_n_m1, LANE_GROUPS_MAX * LANES, 0.0);
+    std::fill_n(y_n_m2, LANE_GROUPS_MAX * LANES, 0.0);
+}
+
+
+template<class InputSignalProducerClass>
+void Reverb<InputSignalProducerClass>::write_feedback(
+        Integer const sample_count
+) noexcept {
+    Integer const lanes_count = lines_count * LINE_CHANNELS;
+    Integer const block_size = this->block_size;
+    Integer const delay_buffer_size = this->delay_buffer_size;
+    Integer const feedback_index = (
+        (this->write_index + block_size) & delay_buffer_mask
+    );
+
+    for (Integer l = 0; l != lanes_count; ++l) {
+        Sample* const delay_line = &delay_buffer[l * delay_buffer_size];
+        Sample const* const lanes = (
+            (Sample const*)&lanes_buffer[(l / LANES) * block_size] + l % LANES
+        );
+        Integer i = 0;
+        Integer j = feedback_index;
+
+        while (i != sample_count) {
+            Integer const end = std::min(sample_count, i + delay_buffer_size - j);
+
+            for (; i != end; ++i, ++j) {
+                delay_line[j] = lanes[i * LANES];
+            }
+
+            j = 0;
+        }
+    }
+}
+
+
+template<class InputSignalProducerClass>
+void Reverb<InputSignalProducerClass>::mix_lines_with_constant_width(
+        Integer const sample_count
+) noexcept {
+    /* https://www.w3.org/TR/webaudio/#stereopanner-algorithm */
+
+    Integer const block_size = this->block_size;
+    Number const width_value = width.get_value();
+    SampleVector left_weights[LANE_GROUPS_MAX] = {};
+    SampleVector right_weights[LANE_GROUPS_MAX] = {};
+
+    for (Integer line = 0; line != lines_count; ++line) {
+        Integer const group = (line * LINE_CHANNELS) / LANES;
+        Integer const left = (line * LINE_CHANNELS) % LANES;
+        Integer const right = left + 1;
+        Number const panning = width_value * panning_scales[line];
+        Number const x = (panning <= 0.0 ? panning + 1.0 : panning) * Math::PI_HALF;
+        Sample const weight = weights[line];
+        Number right_gain;
+        Number left_gain;
+
+        Math::sincos(x, right_gain, left_gain);
+
+        if (panning > 0.0) {
+            left_weights[group][left] = weight * (Sample)left_gain;
+            right_weights[group][left] = weight * (Sample)right_gain;
+            right_weights[group][right] = weight;
+        } else {
+            left_weights[group][left] = weight;
+            left_weights[group][right] = weight * (Sample)left_gain;
+            right_weights[group][right] = weight * (Sample)right_gain;
+        }
+    }
+
+    Sample* const left_buffer = this->buffer[0];
+    Sample* const right_buffer = this->buffer[1];
+
+    for (Integer i = 0; i != sample_count; ++i) {
+        SampleVector left_sum = {};
+        SampleVector right_sum = {};
+
+        for (Integer g = 0; g != lane_groups; ++g) {
+            SampleVector const lanes = lanes_buffer[g * block_size + i];
+
+            left_sum += left_weights[g] * lanes;
+            right_sum += right_weights[g] * lanes;
+        }
+
+        Sample left_sample = 0.0;
+        Sample right_sample = 0.0;
+
+        for (Integer l = 0; l != LANES; ++l) {
+            left_sample += left_sum[l];
+            right_sample += right_sum[l];
+        }
+
+        left_buffer[i] = left_sample;
+        right_buffer[i] = right_sample;
+    }
+}
+
+
+template<class InputSignalProducerClass>
+void Reverb<InputSignalProducerClass>::mix_lines_with_changing_width(
+        Integer const sample_count
+) noexcept {
+    /* https://www.w3.org/TR/webaudio/#stereopanner-algorithm */
+
+    Integer const block_size = this->block_size;
+    Sample* const left_buffer = this->buffer[0];
+    Sample* const right_buffer = this->buffer[1];
+
+    std::fill_n(left_buffer, sample_count, 0.0);
+    std::fill_n(right_buffer, sample_count, 0.0);
+
+    for (Integer line = 0; line != lines_count; ++line) {
+        SampleVector const* const lanes = (
+            &lanes_buffer[((line * LINE_CHANNELS) / LANES) * block_size]
+        );
+        Integer const left = (line * LINE_CHANNELS) % LANES;
+        Integer const right = left + 1;
+        Number const panning_scale = panning_scales[line];
+        Sample const weight = weights[line];
+
+        for (Integer i = 0; i != sample_count; ++i) {
+            Number const panning = width_buffer[i] * panning_scale;
+            Number const x = (panning <= 0.0 ? panning + 1.0 : panning) * Math::PI_HALF;
+            Sample const left_sample = lanes[i][left];
+            Sample const right_sample = lanes[i][right];
+            Number right_gain;
+            Number left_gain;
+
+            Math::sincos(x, right_gain, left_gain);
+
+            if (panning > 0.0) {
+                left_buffer[i] += weight * left_sample * (Sample)left_gain;
+                right_buffer[i] += weight * (
+                    right_sample + left_sample * (Sample)right_gain
+                );
+            } else {
+                left_buffer[i] += weight * (
+                    left_sample + right_sample * (Sample)left_gain
+                );
+                right_buffer[i] += weight * right_sample * (Sample)right_gain;
+            }
+        }
     }
 }
 
@@ -24,8 +24,6 @@
 #include "js80p.hpp"
 
 #include "dsp/biquad_filter.hpp"
-#include "dsp/delay.hpp"
-#include "dsp/mixer.hpp"
 #include "dsp/param.hpp"
 #include "dsp/side_chain_compressable_effect.hpp"
 #include "dsp/signal_producer.hpp"
@@ -43,7 +41,7 @@ class Reverb : public SideChainCompressableEffect<InputSignalProducerClass>
         typedef Byte Type;
 
         typedef BiquadFilter<InputSignalProducerClass> HighPassedInput;
-        typedef HighShelfPannedDelay<HighPassedInput> CombFilter;
+        typedef BiquadFilter<HighPassedInput> DampingFilter;
 
         class TypeParam : public Param<Type, ParamEvaluation::BLOCK>
         {
@@ -62,25 +60,6 @@ class Reverb : public SideChainCompressableEffect<InputSignalProducerClass>
         static constexpr Type REVERB_9  = 8;
         static constexpr Type REVERB_10 = 9;
 
-        Reverb(std::string const name, InputSignalProducerClass& input);
-
-        virtual void reset() noexcept override;
-
-        TypeParam type;
-        FloatParamS room_size;
-        FloatParamS damping_frequency;
-        FloatParamS damping_gain;
-        FloatParamS width;
-        FloatParamS high_pass_frequency;
-        ToggleParam log_scale_frequencies;
-
-    protected:
-        Sample const* const* initialize_rendering(
-            Integer const round,
-            Integer const sample_count
-        ) noexcept;
-
-    private:
         class Tuning
         {
             public:
@@ -248,17 +227,115 @@ class Reverb : public SideChainCompressableEffect<InputSignalProducerClass>
             },
         };
 
-        void update_tunings(Byte const type) noexcept;
+        Reverb(std::string const name, InputSignalProducerClass& input);
+        virtual ~Reverb();
 
-        Mixer<CombFilter> mixer;
+        virtual void set_sample_rate(Frequency const new_sample_rate) noexcept override;
+        virtual void set_block_size(Integer const new_block_size) noexcept override;
+        virtual void reset() noexcept override;
+
+        /**
+         * \brief Tell whether the comb filters are drained.
+         */
+        bool is_tail_silent() const noexcept;
+
+        /**
+         * \brief Estimate how long it takes for a full scale signal to decay
+         *        below \c SignalProducer::SILENCE_THRESHOLD in the longest
+         *        comb filter with the current settings.
+         */
+        Seconds get_tail_length() const noexcept;
+
+        TypeParam type;
+        FloatParamS room_size;
+        FloatParamS damping_frequency;
+        FloatParamS damping_gain;
+        FloatParamS width;
+        FloatParamS high_pass_frequency;
+        ToggleParam log_scale_frequencies;
+
+    protected:
+        Sample const* const* initialize_rendering(
+            Integer const round,
+            Integer const sample_count
+        ) noexcept;
+
+    private:
+        typedef BiquadFilterBank::SampleVector SampleVector;
+
+        static constexpr Integer LANES = BiquadFilterBank::LANES;
+
+        /*
+        Each channel of each comb filter is a lane, and the lanes of the
+        damping filters are processed in groups of LANES.
+        */
+        static constexpr Integer LINE_CHANNELS = 2;
+        static constexpr Integer LANES_MAX = (Integer)COMB_FILTERS * LINE_CHANNELS;
+        static constexpr Integer LANE_GROUPS_MAX = (LANES_MAX + LANES - 1) / LANES;
+
+        void reallocate_buffers() noexcept;
+        void free_buffers() noexcept;
+        void clear_comb_filters() noexcept;
+
+        void update_tunings(Type const type) noexcept;
+        void update_delay_times() noexcept;
+
+        template<bool is_room_size_constant>
+        void read_delay_lines(
+            Sample const* const* input_buffer,
+            Integer const sample_count
+        ) noexcept;
+
+        template<bool are_coefficients_constant>
+        Sample apply_damping(
+            typename DampingFilter::Coefficients const& coefficients,
+            Integer const sample_count
+        ) noexcept;
+
+        void snap_lanes_to_zero(Integer const sample_count) noexcept;
+        void write_feedback(Integer const sample_count) noexcept;
+
+        void mix_lines_with_constant_width(Integer const sample_count) noexcept;
+        void mix_lines_with_changing_width(Integer const sample_count) noexcept;
 
         typename HighPassedInput::TypeParam high_pass_filter_type;
         FloatParamS high_pass_filter_q;
         FloatParamS high_pass_filter_gain;
 
-        BiquadFilterSharedCache high_shelf_filter_shared_cache;
+        typename DampingFilter::TypeParam damping_filter_type;
+        FloatParamS damping_filter_q;
+
         HighPassedInput high_pass_filter;
-        CombFilter comb_filters[COMB_FILTERS];
+        DampingFilter damping_filter;
+
+        /*
+        The delay lines of all the comb filters are kept in a single buffer,
+        one row of delay_buffer_size samples per lane. The feedback of each
+        line is written one block ahead of the input, so the whole block can
+        be read from the delay lines before any of it is filtered.
+        */
+        Sample* delay_buffer;
+        SampleVector* lanes_buffer;
+        Sample const* room_size_buffer;
+        Sample const* width_buffer;
+        Integer delay_buffer_size;
+        Integer delay_buffer_mask;
+        Integer write_index;
+        Integer silent_samples;
+        Integer lines_count;
+        Integer lane_groups;
+
+        Seconds delay_times[COMB_FILTERS];
+        Integer delays[COMB_FILTERS];
+        Sample delay_fractions[COMB_FILTERS];
+        Sample weights[COMB_FILTERS];
+        Number panning_scales[COMB_FILTERS];
+
+        Sample x_n_m1[LANE_GROUPS_MAX * LANES];
+        Sample x_n_m2[LANE_GROUPS_MAX * LANES];
+        Sample y_n_m1[LANE_GROUPS_MAX * LANES];
+        Sample y_n_m2[LANE_GROUPS_MAX * LANES];
+
         Type previous_type;
 };
 
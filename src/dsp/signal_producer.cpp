@@ -23,6 +23,8 @@
 
 #include "dsp/signal_producer.hpp"
 
+#include "dsp/profiler.cpp"
+
 
 namespace JS80P
 {
@@ -33,13 +35,25 @@ Sample const* const* SignalProducer::produce(
         Integer const round,
         Integer const sample_count
 ) noexcept {
+#ifdef JS80P_PROFILING
+    Profiler::Probe probe(Profiler::get_node_type<SignalProducerClass>());
+#endif
+
     if (signal_producer.cached_round == round) {
+#ifdef JS80P_PROFILING
+        probe.cache_hit();
+#endif
+
         return signal_producer.cached_buffer;
     }
 
     Seconds const start_time = signal_producer.current_time;
     Integer const count = signal_producer.sample_count_or_block_size(sample_count);
 
+#ifdef JS80P_PROFILING
+    probe.set_sample_count(count);
+#endif
+
     signal_producer.cached_round = round;
     signal_producer.cached_buffer = signal_producer.initialize_rendering(round, count);
     signal_producer.last_sample_count = count;
@@ -121,6 +135,7 @@ SignalProducer::SignalProducer(
     sampling_period(1.0 / (Seconds)DEFAULT_SAMPLE_RATE),
     nyquist_frequency(DEFAULT_SAMPLE_RATE * 0.5),
     bpm(DEFAULT_BPM),
+    event_grid(1),
     current_time(0.0),
     cached_round(-1),
     cached_buffer(NULL),
@@ -264,6 +279,22 @@ Number SignalProducer::get_bpm() const noexcept
 }
 
 
+void SignalProducer::set_event_grid(Integer const new_event_grid) noexcept
+{
+    event_grid = std::max((Integer)1, new_event_grid);
+
+    for (Children::iterator it = children.begin(); it != children.end(); ++it) {
+        (*it)->set_event_grid(new_event_grid);
+    }
+}
+
+
+Integer SignalProducer::get_event_grid() const noexcept
+{
+    return event_grid;
+}
+
+
 bool SignalProducer::is_silent(
         Integer const round,
         Integer const sample_count
@@ -436,6 +467,12 @@ void SignalProducer::handle_event(Event const& event) noexcept
 }
 
 
+bool SignalProducer::is_event_time_critical(Event::Type const type) const noexcept
+{
+    return true;
+}
+
+
 bool SignalProducer::has_upcoming_events(
         Integer const sample_count
 ) const noexcept {
@@ -513,6 +550,18 @@ void SignalProducer::handle_events(
                 * signal_producer.sample_rate
             );
 
+            Integer const grid = signal_producer.get_event_grid();
+
+            if (
+                    grid > 1
+                    && next_stop < sample_count
+                    && !signal_producer.is_event_time_critical(next_event.type)
+            ) {
+                next_stop = align_to_event_grid<SignalProducerClass>(
+                    signal_producer, current_sample_index, next_stop, grid
+                );
+            }
+
             if (next_stop > sample_count) {
                 next_stop = sample_count;
             }
@@ -527,6 +576,41 @@ void SignalProducer::handle_events(
     next_stop = sample_count;
 }
 
+
+template<class SignalProducerClass>
+Integer SignalProducer::align_to_event_grid(
+        SignalProducerClass& signal_producer,
+        Integer const current_sample_index,
+        Integer const next_stop,
+        Integer const grid
+) noexcept {
+    Integer const aligned_stop = ((next_stop + grid - 1) / grid) * grid;
+
+    /*
+    Postponing non-critical events is fine, but a critical event which is due
+    before the grid point must still be handled at its exact sample.
+    */
+    Queue<Event>::SizeType const length = signal_producer.events.length();
+
+    for (Queue<Event>::SizeType i = 1; i != length; ++i) {
+        Event const& event = signal_producer.events[i];
+        Integer const stop = current_sample_index + (Integer)std::ceil(
+            (event.time_offset - signal_producer.current_time)
+            * signal_producer.sample_rate
+        );
+
+        if (stop >= aligned_stop) {
+            break;
+        }
+
+        if (signal_producer.is_event_time_critical(event.type)) {
+            return stop;
+        }
+    }
+
+    return aligned_stop;
+}
+
 }
 
 #endif
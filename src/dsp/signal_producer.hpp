@@ -24,6 +24,7 @@
 
 #include "js80p.hpp"
 
+#include "dsp/profiler.hpp"
 #include "dsp/queue.hpp"
 
 
@@ -139,6 +140,20 @@ class SignalProducer
         void set_bpm(Number const new_bpm) noexcept;
         Number get_bpm() const noexcept;
 
+        /**
+         * \brief Let \c produce() postpone the handling of events which are
+         *        not time critical (see \c is_event_time_critical()) until
+         *        the next multiple of \c new_event_grid samples (counted from
+         *        the beginning of the block), so that a burst of events does
+         *        not fragment rendering into tiny spans. The setting is passed
+         *        on to the children. Defaults to 1, meaning that every event is
+         *        handled at its exact sample.
+         *
+         * \warning Must not be called while rendering is in progress.
+         */
+        void set_event_grid(Integer const new_event_grid) noexcept;
+        Integer get_event_grid() const noexcept;
+
         bool is_silent(
             Integer const round,
             Integer const sample_count = -1
@@ -206,6 +221,15 @@ class SignalProducer
          */
         void handle_event(Event const& event) noexcept;
 
+        /**
+         * \brief Override this method in order to tell which event types may
+         *        be postponed to the next grid point (see \c set_event_grid()).
+         *        Handlers of non-critical events must compensate for being late
+         *        by taking \c current_time into account. By default, every
+         *        event is critical.
+         */
+        bool is_event_time_critical(Event::Type const type) const noexcept;
+
         Sample** reallocate_buffer(Sample** old_buffer) const noexcept;
         Sample** allocate_buffer() const noexcept;
         Sample** free_buffer(Sample** old_buffer) const noexcept;
@@ -242,6 +266,7 @@ class SignalProducer
         Seconds sampling_period;
         Frequency nyquist_frequency;
         Number bpm;
+        Integer event_grid;
         Seconds current_time;
         Integer cached_round;
         Sample const* const* cached_buffer;
@@ -257,6 +282,14 @@ class SignalProducer
             Integer& next_stop
         ) noexcept;
 
+        template<class SignalProducerClass>
+        static Integer align_to_event_grid(
+            SignalProducerClass& signal_producer,
+            Integer const current_sample_index,
+            Integer const next_stop,
+            Integer const grid
+        ) noexcept;
+
         Children children;
         Integer cached_silence_round;
         bool cached_silence;
@@ -19,6 +19,7 @@
 #ifndef JS80P__DSP__WAVETABLE_CPP
 #define JS80P__DSP__WAVETABLE_CPP
 
+#include <algorithm>
 #include <cmath>
 
 #include "dsp/wavetable.hpp"
@@ -29,9 +30,6 @@
 namespace JS80P
 {
 
-bool Wavetable::is_initialized = false;
-
-
 Number Wavetable::sines[Wavetable::SIZE] = {0.0};
 
 
@@ -42,15 +40,22 @@ WavetableState::WavetableState() noexcept
 
 void Wavetable::initialize() noexcept
 {
-    if (is_initialized) {
-        return;
-    }
+    /*
+    Function-local statics are initialized only once, even if multiple threads
+    get here at the same time, e.g. when a host instantiates multiple plugins
+    in parallel.
+    */
+    [[maybe_unused]] static bool const is_initialized = initialize_sines();
+}
 
-    is_initialized = true;
 
+bool Wavetable::initialize_sines() noexcept
+{
     for (Integer j = 0; j != SIZE; ++j) {
         sines[j] = std::sin(((Number)j * SIZE_INV) * Math::PI_DOUBLE);
     }
+
+    return true;
 }
 
 
@@ -76,15 +81,74 @@ Number Wavetable::scale_phase_offset(Number const phase_offset) noexcept
 }
 
 
+Integer Wavetable::count_levels(Integer const partials) noexcept
+{
+    Integer levels = 1;
+
+    for (
+        Integer level_partials = 1;
+        level_partials != partials;
+        level_partials = next_level_partials(partials, level_partials)
+    ) {
+        ++levels;
+    }
+
+    return levels;
+}
+
+
+Integer Wavetable::next_level_partials(
+        Integer const partials,
+        Integer const level_partials
+) noexcept {
+    if (level_partials < DENSE_LEVELS) {
+        return std::min(partials, level_partials + 1);
+    }
+
+    return std::min(
+        partials,
+        std::max(
+            level_partials + 1,
+            (Integer)std::round((Number)level_partials * LEVEL_RATIO)
+        )
+    );
+}
+
+
 Wavetable::Wavetable(
         Number const coefficients[],
         Integer const coefficients_length
-) noexcept : partials(coefficients_length)
+) noexcept
+    : partials(coefficients_length),
+    levels(count_levels(coefficients_length))
 {
-    samples = new Sample*[partials];
+    initialize();
 
-    for (Integer i = 0; i != partials; ++i) {
+    samples = new Sample*[levels];
+    partials_to_level = new Integer[partials + 1];
+
+    for (Integer i = 0, level_partials = 1; i != levels; ++i) {
         samples[i] = new Sample[SIZE];
+        this->level_partials[i] = level_partials;
+        level_partials = next_level_partials(partials, level_partials);
+    }
+
+    for (Integer i = 0; i != levels - 1; ++i) {
+        level_width_inv[i] = (
+            1.0 / (Sample)(level_partials[i + 1] - level_partials[i])
+        );
+    }
+
+    level_width_inv[levels - 1] = 0.0;
+
+    partials_to_level[0] = 0;
+
+    for (Integer i = 1, level = 0; i != partials + 1; ++i) {
+        if (level + 1 != levels && level_partials[level + 1] <= i) {
+            ++level;
+        }
+
+        partials_to_level[i] = level;
     }
 
     update_coefficients(coefficients);
@@ -94,29 +158,32 @@ Wavetable::Wavetable(
 
 void Wavetable::update_coefficients(Number const coefficients[]) noexcept
 {
-    Integer frequency = 1;
-
     /*
     samples[0]: 0 partials above fundamental
     samples[1]: 1 partial above fundamental
     ...
-    samples[n]: n partials above fundamental
+    samples[n]: level_partials[n] - 1 partials above fundamental
     */
 
-    for (Integer j = 0; j != SIZE; ++j) {
-        samples[0][j] = (
-            (Sample)(coefficients[0] * sines[(j * frequency) & MASK])
-        );
-    }
+    Integer partial = 0;
 
-    for (Integer i = 1, prev_i = 0; i != partials; ++i, ++prev_i) {
-        ++frequency;
+    for (Integer i = 0; i != levels; ++i) {
+        Sample* const table = samples[i];
 
-        for (Integer j = 0; j != SIZE; ++j) {
-            samples[i][j] = (
-                samples[prev_i][j]
-                + (Sample)(coefficients[i] * sines[(j * frequency) & MASK])
-            );
+        if (i == 0) {
+            std::fill_n(table, SIZE, 0.0);
+        } else {
+            std::copy_n(samples[i - 1], SIZE, table);
+        }
+
+        for (; partial != level_partials[i]; ++partial) {
+            Integer const frequency = partial + 1;
+
+            for (Integer j = 0; j != SIZE; ++j) {
+                table[j] += (
+                    (Sample)(coefficients[partial] * sines[(j * frequency) & MASK])
+                );
+            }
         }
     }
 }
@@ -126,7 +193,7 @@ void Wavetable::normalize() noexcept
 {
     Sample max = 0.0;
 
-    for (Integer i = 0; i != partials; ++i) {
+    for (Integer i = 0; i != levels; ++i) {
         for (Integer j = 0; j != SIZE; ++j) {
             Sample const sample = std::fabs(samples[i][j]);
 
@@ -136,7 +203,7 @@ void Wavetable::normalize() noexcept
         }
     }
 
-    for (Integer i = 0; i != partials; ++i) {
+    for (Integer i = 0; i != levels; ++i) {
         for (Integer j = 0; j != SIZE; ++j) {
             samples[i][j] /= max;
         }
@@ -164,13 +231,15 @@ bool Wavetable::has_single_partial() const noexcept
 
 Wavetable::~Wavetable()
 {
-    for (Integer i = 0; i != partials; ++i) {
+    for (Integer i = 0; i != levels; ++i) {
         delete[] samples[i];
     }
 
     delete[] samples;
+    delete[] partials_to_level;
 
     samples = NULL;
+    partials_to_level = NULL;
 }
 
 
@@ -206,23 +275,29 @@ Sample Wavetable::lookup(
         Sample const max_partials = (
             (Sample)(state.nyquist_frequency / abs_frequency)
         );
-        Integer const more_partials_index = (
-            std::max((Integer)0, std::min(this->partials, (Integer)max_partials) - 1)
-        );
-        Integer const fewer_partials_index = (
-            std::max((Integer)0, more_partials_index - 1)
+        Integer const available_partials = (
+            std::max((Integer)1, std::min(this->partials, (Integer)max_partials))
         );
+        Integer const level = partials_to_level[available_partials];
 
-        state.table_indices[0] = fewer_partials_index;
+        if (level == 0 || available_partials == this->partials) {
+            state.table_indices[0] = level;
 
-        if (more_partials_index == fewer_partials_index) {
             return interpolate<interpolation, false>(
                 state, abs_frequency, sample_index + phase_offset
             );
         }
 
-        state.table_indices[1] = more_partials_index;
-        state.fewer_partials_weight = max_partials - std::floor(max_partials);
+        /*
+        The next level would contain partials above the Nyquist frequency, so
+        the current one is faded in over the previous one while max_partials
+        goes from the current level's partial count to the next one's.
+        */
+        state.table_indices[0] = level - 1;
+        state.table_indices[1] = level;
+        state.fewer_partials_weight = (
+            1.0 - (max_partials - (Sample)level_partials[level]) * level_width_inv[level]
+        );
 
         return interpolate<interpolation, true>(
             state, abs_frequency, sample_index + phase_offset
@@ -337,67 +412,70 @@ Sample Wavetable::interpolate_sample_lagrange(
 }
 
 
-StandardWaveforms const StandardWaveforms::standard_waveforms;
+StandardWaveforms const& StandardWaveforms::get() noexcept
+{
+    static StandardWaveforms const standard_waveforms;
+
+    return standard_waveforms;
+}
 
 
 Wavetable const* StandardWaveforms::sine() noexcept
 {
-    return standard_waveforms.sine_wt;
+    return get().sine_wt;
 }
 
 
 Wavetable const* StandardWaveforms::sawtooth() noexcept
 {
-    return standard_waveforms.sawtooth_wt;
+    return get().sawtooth_wt;
 }
 
 
 Wavetable const* StandardWaveforms::soft_sawtooth() noexcept
 {
-    return standard_waveforms.soft_sawtooth_wt;
+    return get().soft_sawtooth_wt;
 }
 
 
 Wavetable const* StandardWaveforms::inverse_sawtooth() noexcept
 {
-    return standard_waveforms.inverse_sawtooth_wt;
+    return get().inverse_sawtooth_wt;
 }
 
 
 Wavetable const* StandardWaveforms::soft_inverse_sawtooth() noexcept
 {
-    return standard_waveforms.soft_inverse_sawtooth_wt;
+    return get().soft_inverse_sawtooth_wt;
 }
 
 
 Wavetable const* StandardWaveforms::triangle() noexcept
 {
-    return standard_waveforms.triangle_wt;
+    return get().triangle_wt;
 }
 
 
 Wavetable const* StandardWaveforms::soft_triangle() noexcept
 {
-    return standard_waveforms.soft_triangle_wt;
+    return get().soft_triangle_wt;
 }
 
 
 Wavetable const* StandardWaveforms::square() noexcept
 {
-    return standard_waveforms.square_wt;
+    return get().square_wt;
 }
 
 
 Wavetable const* StandardWaveforms::soft_square() noexcept
 {
-    return standard_waveforms.soft_square_wt;
+    return get().soft_square_wt;
 }
 
 
 StandardWaveforms::StandardWaveforms() noexcept
 {
-    Wavetable::initialize();
-
     Number sine_coefficients[] = {1.0};
     Number sawtooth_coefficients[Wavetable::PARTIALS];
     Number soft_sawtooth_coefficients[Wavetable::SOFT_PARTIALS];
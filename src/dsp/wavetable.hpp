@@ -106,6 +106,20 @@ class Wavetable
         bool has_single_partial() const noexcept;
 
     private:
+        /*
+        Instead of storing a table for every possible number of partials,
+        tables are stored only for a mip-map like series of partial counts
+        ("levels"): every count up to DENSE_LEVELS, and then counts which grow
+        geometrically by LEVEL_RATIO (roughly 1/4 octave). For a given
+        frequency, the two highest levels which don't contain any partial
+        above the Nyquist frequency are crossfaded, so alias rejection is the
+        same as with a table per partial count, but the tables of a
+        waveform are small enough to stay in the cache.
+        */
+        static constexpr Integer DENSE_LEVELS = 16;
+        static constexpr Number LEVEL_RATIO = 1.189207115002721;
+        static constexpr Integer MAX_LEVELS = 64;
+
         /*
         24 Hz at 48 kHz sampling rate has a wavelength of 2000 samples,
         so 2048 samples per waveform with linear interpolation should be
@@ -124,7 +138,8 @@ class Wavetable
         );
 
         static Number sines[SIZE];
-        static bool is_initialized;
+
+        static bool initialize_sines() noexcept;
 
         Number wrap_around(Number const index) const noexcept;
 
@@ -147,9 +162,20 @@ class Wavetable
             Number const sample_index
         ) const noexcept;
 
+        static Integer count_levels(Integer const partials) noexcept;
+
+        static Integer next_level_partials(
+            Integer const partials,
+            Integer const level_partials
+        ) noexcept;
+
         Integer const partials;
+        Integer const levels;
 
         Sample** samples;
+        Integer* partials_to_level;
+        Integer level_partials[MAX_LEVELS];
+        Sample level_width_inv[MAX_LEVELS];
 };
 
 
@@ -170,7 +196,13 @@ class StandardWaveforms
         ~StandardWaveforms();
 
     private:
-        static StandardWaveforms const standard_waveforms;
+        /*
+        Building the standard waveforms takes a noticeable amount of time, so
+        instead of doing it when the library is loaded (which would slow down
+        plugin scanning in hosts), it's done when the first oscillator is
+        created.
+        */
+        static StandardWaveforms const& get() noexcept;
 
         Wavetable const* sine_wt;
         Wavetable const* sawtooth_wt;
@@ -1144,7 +1144,7 @@ GUI::GUI(
     synth_image = dummy_widget->load_image(this->platform_data, "SYNTH");
     vst_logo_image = dummy_widget->load_image(this->platform_data, "VSTLOGO");
 
-    background = new Background();
+    background = new Background(synth);
 
     this->parent_window = new ExternallyCreatedWindow(this->platform_data, parent_window);
     this->parent_window->own(background);
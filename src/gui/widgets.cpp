@@ -179,15 +179,24 @@ void TabBody::stop_editing()
 }
 
 
-void TabBody::refresh_controlled_param_editors()
-{
+void TabBody::refresh_changed_param_editors(
+        Synth::ParamStateChanges const& changes
+) {
     for (GUI::ParamEditors::iterator it = param_editors.begin(); it != param_editors.end(); ++it) {
         ParamEditor* editor = *it;
 
-        if (editor->has_controller()) {
+        if (changes.is_changed(editor->param_id)) {
             editor->refresh();
         }
     }
+
+    for (GUI::ToggleSwitches::iterator it = toggle_switches.begin(); it != toggle_switches.end(); ++it) {
+        ToggleSwitch* toggle_switch = *it;
+
+        if (changes.is_changed(toggle_switch->param_id)) {
+            toggle_switch->refresh();
+        }
+    }
 }
 
 
@@ -207,8 +216,9 @@ void TabBody::refresh_toggle_switches()
 }
 
 
-Background::Background()
+Background::Background(Synth& synth)
     : Widget("JS80P", 0, 0, GUI::WIDTH, GUI::HEIGHT, Type::BACKGROUND),
+    synth(synth),
     body(NULL),
     next_full_refresh(FULL_REFRESH_TICKS)
 {
@@ -249,6 +259,13 @@ void Background::show_body()
 
 void Background::refresh()
 {
+    /*
+    The changes are collected even when there's nothing to refresh, so that
+    old changes don't trigger unnecessary refreshing later. Changes which
+    affect hidden tabs are picked up by the periodic full refresh.
+    */
+    synth.collect_param_state_changes(param_state_changes);
+
     if (body == NULL) {
         return;
     }
@@ -259,8 +276,8 @@ void Background::refresh()
         next_full_refresh = FULL_REFRESH_TICKS;
         body->refresh_param_editors();
         body->refresh_toggle_switches();
-    } else {
-        body->refresh_controlled_param_editors();
+    } else if (!param_state_changes.is_empty()) {
+        body->refresh_changed_param_editors(param_state_changes);
     }
 }
 
@@ -689,19 +706,15 @@ void ParamEditor::refresh()
         return;
     }
 
-    Synth::ControllerId const new_controller_id = (
-        synth.get_param_controller_id_atomic(param_id)
-    );
-    Number const new_ratio = synth.get_param_ratio_atomic(param_id);
+    Synth::ControllerId new_controller_id;
+    Number new_ratio;
+
+    synth.get_param_state_atomic(param_id, new_ratio, new_controller_id);
 
     has_controller_ = new_controller_id > Synth::Synth::ControllerId::NONE;
 
     if (new_ratio != ratio || new_controller_id != controller_id) {
         update_editor(new_ratio, new_controller_id);
-    } else {
-        synth.push_message(
-            Synth::MessageType::REFRESH_PARAM, param_id, 0.0, 0
-        );
     }
 }
 
@@ -1271,10 +1284,6 @@ void ToggleSwitch::refresh()
     if (new_ratio != ratio) {
         ratio = GUI::clamp_ratio(new_ratio);
         redraw();
-    } else {
-        synth.push_message(
-            Synth::MessageType::REFRESH_PARAM, param_id, 0.0, 0
-        );
     }
 }
 
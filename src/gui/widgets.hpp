@@ -129,7 +129,9 @@ class TabBody : public TransparentWidget
 
         void stop_editing();
 
-        void refresh_controlled_param_editors();
+        void refresh_changed_param_editors(
+            Synth::ParamStateChanges const& changes
+        );
         void refresh_param_editors();
         void refresh_toggle_switches();
 
@@ -142,7 +144,7 @@ class TabBody : public TransparentWidget
 class Background : public Widget
 {
     public:
-        Background();
+        Background(Synth& synth);
         ~Background();
 
         void replace_body(TabBody* new_body);
@@ -153,6 +155,8 @@ class Background : public Widget
     private:
         static constexpr Integer FULL_REFRESH_TICKS = 3;
 
+        Synth& synth;
+        Synth::ParamStateChanges param_state_changes;
         TabBody* body;
         Integer next_full_refresh;
 };
@@ -45,10 +45,21 @@ typedef intptr_t Integer;
 Aliases for Number to make signatures more informative while avoiding type
 conversions.
 */
-typedef Number Sample;
 typedef Number Seconds;
 typedef Number Frequency;
 
+/*
+Building with JS80P_FLOAT_SAMPLES makes the signal processing graph work with
+single precision buffers: twice as many samples fit into a SIMD register, and
+half as much memory needs to be moved around for each block. Parameters,
+time, and frequency calculations stay in double precision.
+*/
+#ifdef JS80P_FLOAT_SAMPLES
+typedef float Sample;
+#else
+typedef Number Sample;
+#endif
+
 typedef unsigned char Byte;
 
 
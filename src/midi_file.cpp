@@ -0,0 +1,341 @@
+/*
+ * This file is part of JS80P, a synthesizer plugin.
+ * Copyright (C) 2023  Attila M. Magyar
+ *
+ * JS80P is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * JS80P is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef JS80P__MIDI_FILE_CPP
+#define JS80P__MIDI_FILE_CPP
+
+#include <algorithm>
+
+#include "midi_file.hpp"
+
+
+namespace JS80P
+{
+
+bool MidiFile::read_u8(uint32_t& value)
+{
+    if (pos >= data->size()) {
+        return false;
+    }
+
+    value = (uint32_t)(unsigned char)(*data)[pos++];
+
+    return true;
+}
+
+
+bool MidiFile::read_u16(uint32_t& value)
+{
+    uint32_t hi, lo;
+
+    if (!read_u8(hi) || !read_u8(lo)) {
+        return false;
+    }
+
+    value = (hi << 8) | lo;
+
+    return true;
+}
+
+
+bool MidiFile::read_u32(uint32_t& value)
+{
+    uint32_t hi, lo;
+
+    if (!read_u16(hi) || !read_u16(lo)) {
+        return false;
+    }
+
+    value = (hi << 16) | lo;
+
+    return true;
+}
+
+
+bool MidiFile::read_variable_length(uint32_t& value)
+{
+    uint32_t byte;
+
+    value = 0;
+
+    for (int i = 0; i != 4; ++i) {
+        if (!read_u8(byte)) {
+            return false;
+        }
+
+        value = (value << 7) | (byte & 0x7f);
+
+        if ((byte & 0x80) == 0) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+bool MidiFile::parse(std::string const& data, std::string& error)
+{
+    uint32_t chunk_size, format, tracks, division;
+    std::vector<TickEvent> tick_events;
+    uint64_t end_tick = 0;
+
+    this->data = &data;
+    pos = 0;
+    events.clear();
+    length = 0.0;
+
+    if (data.compare(0, 4, "MThd") != 0) {
+        error = "not a Standard MIDI File";
+
+        return false;
+    }
+
+    pos = 4;
+
+    if (
+            !read_u32(chunk_size)
+            || chunk_size < 6
+            || !read_u16(format)
+            || !read_u16(tracks)
+            || !read_u16(division)
+    ) {
+        error = "invalid header";
+
+        return false;
+    }
+
+    if (format > 1) {
+        error = "only format 0 and format 1 files are supported";
+
+        return false;
+    }
+
+    pos = 8 + chunk_size;
+
+    for (uint32_t track = 0; track != tracks;) {
+        if (pos + 8 > data.size()) {
+            error = "missing track";
+
+            return false;
+        }
+
+        bool const is_track = data.compare(pos, 4, "MTrk") == 0;
+
+        pos += 4;
+
+        if (!read_u32(chunk_size) || pos + chunk_size > data.size()) {
+            error = "truncated chunk";
+
+            return false;
+        }
+
+        std::string::size_type const end = pos + chunk_size;
+
+        if (is_track) {
+            if (!parse_track(end, tick_events, end_tick, error)) {
+                return false;
+            }
+
+            ++track;
+        }
+
+        pos = end;
+    }
+
+    /*
+    Events of the same tick keep the order of the tracks, so that tempo changes
+    in the conductor track take effect before the notes of other tracks.
+    */
+    std::stable_sort(
+        tick_events.begin(),
+        tick_events.end(),
+        [](TickEvent const& a, TickEvent const& b) { return a.tick < b.tick; }
+    );
+
+    Number seconds_per_tick;
+    Number tick_scale;
+
+    if ((division & 0x8000) != 0) {
+        /* SMPTE time division: ticks per frame, negative frames per second */
+        Number frames_per_second = (Number)(-(int8_t)(division >> 8));
+
+        if (frames_per_second == 29.0) {
+            frames_per_second = 29.97;
+        }
+
+        seconds_per_tick = 1.0 / (frames_per_second * (Number)(division & 0xff));
+        tick_scale = 0.0;
+    } else {
+        if (division == 0) {
+            error = "invalid time division";
+
+            return false;
+        }
+
+        tick_scale = 1.0 / (1000000.0 * (Number)division);
+        seconds_per_tick = DEFAULT_TEMPO * tick_scale;
+    }
+
+    uint64_t previous_tick = 0;
+    Seconds time = 0.0;
+
+    events.reserve(tick_events.size());
+
+    for (TickEvent const& tick_event : tick_events) {
+        time += (Number)(tick_event.tick - previous_tick) * seconds_per_tick;
+        previous_tick = tick_event.tick;
+
+        if (tick_event.is_tempo) {
+            if (tick_scale > 0.0) {
+                seconds_per_tick = (Number)tick_event.tempo * tick_scale;
+            }
+        } else {
+            Event event;
+
+            event.time = time;
+            std::copy_n(tick_event.bytes, 4, event.bytes);
+            events.push_back(event);
+        }
+    }
+
+    length = time + (Number)(end_tick - previous_tick) * seconds_per_tick;
+
+    return true;
+}
+
+
+bool MidiFile::parse_track(
+        std::string::size_type const end,
+        std::vector<TickEvent>& tick_events,
+        uint64_t& end_tick,
+        std::string& error
+) {
+    uint64_t tick = 0;
+    uint32_t running_status = 0;
+
+    while (pos < end) {
+        uint32_t delta, status, length, value;
+        TickEvent tick_event;
+
+        if (!read_variable_length(delta) || !read_u8(status)) {
+            return truncated_track(error);
+        }
+
+        tick += delta;
+        end_tick = std::max(end_tick, tick);
+
+        if (status == META_EVENT) {
+            uint32_t type;
+
+            if (!read_u8(type) || !read_variable_length(length)) {
+                return truncated_track(error);
+            }
+
+            std::string::size_type const next = pos + length;
+
+            if (type == META_END_OF_TRACK) {
+                pos = end;
+
+                return true;
+            }
+
+            if (type == META_SET_TEMPO && length == 3) {
+                uint32_t hi, lo;
+
+                if (!read_u8(hi) || !read_u16(lo)) {
+                    return truncated_track(error);
+                }
+
+                tick_event.tick = tick;
+                tick_event.tempo = (hi << 16) | lo;
+                tick_event.is_tempo = true;
+                tick_events.push_back(tick_event);
+            }
+
+            pos = next;
+            running_status = 0;
+
+            continue;
+        }
+
+        if (status == SYSEX_EVENT || status == SYSEX_ESCAPE) {
+            if (!read_variable_length(length)) {
+                return truncated_track(error);
+            }
+
+            pos += length;
+            running_status = 0;
+
+            continue;
+        }
+
+        tick_event.bytes[1] = tick_event.bytes[2] = tick_event.bytes[3] = 0;
+
+        if (status < 0x80) {
+            if (running_status == 0) {
+                error = "data byte without running status";
+
+                return false;
+            }
+
+            tick_event.bytes[1] = (Midi::Byte)status;
+            status = running_status;
+        } else if (!read_u8(value)) {
+            return truncated_track(error);
+        } else {
+            tick_event.bytes[1] = (Midi::Byte)value;
+            running_status = status;
+        }
+
+        Midi::Command const command = (Midi::Command)(status & 0xf0);
+
+        if (command != Midi::PROGRAM_CHANGE && command != Midi::CHANNEL_PRESSURE) {
+            if (!read_u8(value)) {
+                return truncated_track(error);
+            }
+
+            tick_event.bytes[2] = (Midi::Byte)value;
+        }
+
+        tick_event.tick = tick;
+        tick_event.tempo = 0;
+        tick_event.is_tempo = false;
+        tick_event.bytes[0] = (Midi::Byte)status;
+        tick_events.push_back(tick_event);
+    }
+
+    /* The last event or a meta or sysex event may run past the chunk. */
+    if (pos > end) {
+        return truncated_track(error);
+    }
+
+    return true;
+}
+
+
+bool MidiFile::truncated_track(std::string& error)
+{
+    error = "truncated track";
+
+    return false;
+}
+
+}
+
+#endif
@@ -0,0 +1,94 @@
+/*
+ * This file is part of JS80P, a synthesizer plugin.
+ * Copyright (C) 2023  Attila M. Magyar
+ *
+ * JS80P is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * JS80P is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef JS80P__MIDI_FILE_HPP
+#define JS80P__MIDI_FILE_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "js80p.hpp"
+#include "midi.hpp"
+
+
+namespace JS80P
+{
+
+/**
+ * \brief Parse a format 0 or format 1 Standard MIDI File into a single list of
+ *        channel messages, timed in seconds, following the tempo map.
+ */
+class MidiFile
+{
+    public:
+        class Event
+        {
+            public:
+                Seconds time;
+                Midi::Byte bytes[4];
+        };
+
+        bool parse(std::string const& data, std::string& error);
+
+        std::vector<Event> events;
+        Seconds length;
+
+    private:
+        static constexpr Midi::Byte META_EVENT = 0xff;
+        static constexpr Midi::Byte META_END_OF_TRACK = 0x2f;
+        static constexpr Midi::Byte META_SET_TEMPO = 0x51;
+        static constexpr Midi::Byte SYSEX_EVENT = 0xf0;
+        static constexpr Midi::Byte SYSEX_ESCAPE = 0xf7;
+
+        static constexpr Number DEFAULT_TEMPO = 500000.0; /* us per quarter */
+
+        /*
+        Tempo changes and channel messages of all tracks, timed in ticks, to be
+        merged and converted to seconds once every track has been read.
+        */
+        class TickEvent
+        {
+            public:
+                uint64_t tick;
+                uint32_t tempo;
+                bool is_tempo;
+                Midi::Byte bytes[4];
+        };
+
+        bool read_u8(uint32_t& value);
+        bool read_u16(uint32_t& value);
+        bool read_u32(uint32_t& value);
+        bool read_variable_length(uint32_t& value);
+
+        bool parse_track(
+            std::string::size_type const end,
+            std::vector<TickEvent>& tick_events,
+            uint64_t& end_tick,
+            std::string& error
+        );
+
+        static bool truncated_track(std::string& error);
+
+        std::string const* data;
+        std::string::size_type pos;
+};
+
+}
+
+#endif
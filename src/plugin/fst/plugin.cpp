@@ -17,6 +17,7 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
 #include <cstring>
 
 #include "plugin/fst/plugin.hpp"
@@ -144,6 +145,7 @@ AEffect* FstPlugin::create_instance(
     effect->setParameter = &set_parameter;
     effect->uniqueID = CCONST('a', 'm', 'j', '8');
     effect->version = FstPlugin::VERSION;
+    effect->initialDelay = (VstInt32)Renderer::PLUGIN_FIXED_BLOCK_SIZE;
 
     return effect;
 }
@@ -385,7 +387,7 @@ FstPlugin::FstPlugin(
     host_callback(host_callback),
     platform_data(platform_data),
     gui(NULL),
-    renderer(synth),
+    renderer(synth, Renderer::PLUGIN_FIXED_BLOCK_SIZE),
     to_audio_messages(1024),
     to_audio_string_messages(256),
     to_gui_messages(1024),
@@ -403,6 +405,11 @@ FstPlugin::FstPlugin(
 {
     clear_received_midi_cc();
 
+    synth.set_background_wavetable_building(true);
+    synth.set_voice_rendering_threads(
+        Synth::get_default_voice_rendering_threads()
+    );
+
     window_rect.top = 0;
     window_rect.left = 0;
     window_rect.bottom = GUI::HEIGHT;
@@ -447,8 +454,10 @@ FstPlugin::FstPlugin(
         synth.midi_controllers[Synth::ControllerId::SUSTAIN_PEDAL]
     );
 
-    serialized_bank = bank.serialize();
-    current_patch = bank[current_program_index].serialize();
+    bank.compile(synth);
+
+    serialized_bank = bank.serialize_binary(synth);
+    current_patch = bank[current_program_index].serialize_binary(synth);
 
     program_names.import_names(serialized_bank);
 }
@@ -457,49 +466,69 @@ FstPlugin::FstPlugin(
 FstPlugin::~FstPlugin()
 {
     close_gui();
+
+    process_internal_messages_in_gui_thread();
+
+    /* Banks which were imported but never loaded by the audio thread. */
+    Message message;
+
+    while (to_audio_string_messages.pop(message)) {
+        if (message.get_type() == MessageType::IMPORT_BANK) {
+            delete message.get_bank();
+        }
+    }
 }
 
 
 void FstPlugin::process_internal_messages_in_audio_thread(
         SPSCQueue<FstPlugin::Message>& messages
 ) noexcept {
-    SPSCQueue<Message>::SizeType const message_count = messages.length();
+    Message batch[MESSAGE_BATCH_SIZE];
+    SPSCQueue<Message>::SizeType remaining = messages.length();
 
-    for (size_t i = 0; i != message_count; ++i) {
-        Message message;
+    while (remaining > 0) {
+        SPSCQueue<Message>::SizeType const popped = messages.pop_bulk(
+            batch, std::min(remaining, (SPSCQueue<Message>::SizeType)MESSAGE_BATCH_SIZE)
+        );
 
-        if (!messages.pop(message)) {
-            continue;
+        if (popped == 0) {
+            break;
         }
 
-        switch (message.get_type()) {
-            case MessageType::CHANGE_PROGRAM:
-                handle_change_program(message.get_index());
-                break;
+        for (SPSCQueue<Message>::SizeType i = 0; i != popped; ++i) {
+            Message const& message = batch[i];
 
-            case MessageType::RENAME_PROGRAM:
-                handle_rename_program(message.get_serialized_data());
-                break;
+            switch (message.get_type()) {
+                case MessageType::CHANGE_PROGRAM:
+                    handle_change_program(message.get_index());
+                    break;
 
-            case MessageType::CHANGE_PARAM:
-                handle_change_param(
-                    message.get_controller_id(),
-                    message.get_new_value(),
-                    message.get_midi_controller()
-                );
-                break;
+                case MessageType::RENAME_PROGRAM:
+                    handle_rename_program(message.get_serialized_data());
+                    break;
 
-            case MessageType::IMPORT_PATCH:
-                handle_import_patch(message.get_serialized_data());
-                break;
+                case MessageType::CHANGE_PARAM:
+                    handle_change_param(
+                        message.get_controller_id(),
+                        message.get_new_value(),
+                        message.get_midi_controller()
+                    );
+                    break;
 
-            case MessageType::IMPORT_BANK:
-                handle_import_bank(message.get_serialized_data());
-                break;
+                case MessageType::IMPORT_PATCH:
+                    handle_import_patch(message.get_serialized_data());
+                    break;
 
-            default:
-                break;
+                case MessageType::IMPORT_BANK:
+                    handle_import_bank(message.get_bank());
+                    break;
+
+                default:
+                    break;
+            }
         }
+
+        remaining -= popped;
     }
 }
 
@@ -516,11 +545,23 @@ void FstPlugin::handle_change_program(size_t const new_program) noexcept
         return;
     }
 
-    std::string const new_patch(bank[new_program].serialize());
+    Bank::Program const& program = bank[new_program];
+    Serializer::Messages const* const messages = program.get_compiled_messages();
 
     synth.process_messages();
-    bank[old_program].import(Serializer::serialize(synth));
-    Serializer::import_patch_in_audio_thread(synth, new_patch);
+
+    /*
+    Only the compiled form of the outgoing program is captured here, its text
+    form is regenerated during the next bank update, see finalize_rendering().
+    */
+    bank[old_program].capture(synth);
+
+    if (LIKELY(messages != NULL)) {
+        Serializer::import_patch_in_audio_thread(synth, *messages);
+    } else {
+        Serializer::import_patch_in_audio_thread(synth, program.serialize());
+    }
+
     synth.clear_dirty_flag();
     renderer.reset();
     bank.set_current_program_index(new_program);
@@ -576,26 +617,41 @@ void FstPlugin::handle_import_patch(std::string const& patch) noexcept
     synth.clear_dirty_flag();
     renderer.reset();
 
-    std::string const& serialized_patch(Serializer::serialize(synth));
-
-    bank[current_program].import(serialized_patch);
+    bank[current_program].capture(synth);
 
     need_bank_update = true;
 }
 
 
-void FstPlugin::handle_import_bank(std::string const& serialized_bank) noexcept
+void FstPlugin::handle_import_bank(Bank* const imported_bank) noexcept
 {
     size_t const current_program = bank.get_current_program_index();
 
-    bank.import(serialized_bank);
+    /*
+    The imported bank has already been parsed and compiled by set_chunk(), so
+    neither loading it, nor switching to one of its programs later needs to
+    parse or allocate anything here.
+    */
+    bank.swap_programs(*imported_bank);
 
-    Serializer::import_patch_in_audio_thread(
-        synth, bank[current_program].serialize()
+    Serializer::Messages const* const messages = (
+        bank[current_program].get_compiled_messages()
     );
+
+    if (LIKELY(messages != NULL)) {
+        Serializer::import_patch_in_audio_thread(synth, *messages);
+    } else {
+        Serializer::import_patch_in_audio_thread(
+            synth, bank[current_program].serialize()
+        );
+    }
+
     synth.clear_dirty_flag();
     renderer.reset();
 
+    /* The previous programs are freed outside the audio thread. */
+    to_gui_messages.push(Message(MessageType::BANK_IMPORTED, imported_bank));
+
     need_bank_update = true;
 }
 
@@ -626,6 +682,10 @@ void FstPlugin::process_internal_messages_in_gui_thread() noexcept
                 handle_params_changed();
                 break;
 
+            case MessageType::BANK_IMPORTED:
+                handle_bank_imported(message.get_bank());
+                break;
+
             default:
                 break;
         }
@@ -637,13 +697,10 @@ void FstPlugin::handle_program_changed(
         size_t const new_program,
         std::string const& patch
 ) noexcept {
-    Bank::Program program;
-
     current_program_index = new_program;
     current_patch = patch;
 
-    program.import(patch);
-    program_names[current_program_index].set_name(program.get_name());
+    program_names[current_program_index].set_name(get_program_name(patch));
 
     parameters[0].set_value(
         Bank::program_index_to_normalized_parameter_value(new_program)
@@ -659,12 +716,36 @@ void FstPlugin::handle_bank_changed(std::string const& serialized_bank) noexcept
 }
 
 
+void FstPlugin::handle_bank_imported(Bank* const old_programs) noexcept
+{
+    delete old_programs;
+}
+
+
 void FstPlugin::handle_params_changed() noexcept
 {
     need_host_update = true;
 }
 
 
+std::string FstPlugin::get_program_name(std::string const& patch) const noexcept
+{
+    if (Serializer::is_binary(patch)) {
+        Serializer::BinaryPrograms programs;
+
+        Serializer::parse_binary_names(patch, programs);
+
+        return programs.empty() ? "" : programs[0].name;
+    }
+
+    Bank::Program program;
+
+    program.import(patch);
+
+    return program.get_name();
+}
+
+
 void FstPlugin::initialize() noexcept
 {
     need_idle();
@@ -712,7 +793,7 @@ void FstPlugin::set_sample_rate(float const new_sample_rate) noexcept
 void FstPlugin::set_block_size(VstIntPtr const new_block_size) noexcept
 {
     process_internal_messages_in_gui_thread();
-    synth.set_block_size((Integer)new_block_size);
+    synth.set_block_size(renderer.get_block_size((Integer)new_block_size));
     renderer.reset();
 }
 
@@ -766,7 +847,7 @@ void FstPlugin::clear_received_midi_cc() noexcept
 void FstPlugin::process_vst_midi_event(VstMidiEvent const* const event) noexcept
 {
     Seconds const time_offset = (
-        synth.sample_count_to_time_offset((Integer)event->deltaFrames)
+        renderer.time_offset((Integer)event->deltaFrames)
     );
     Midi::Byte const* const midi_bytes = (Midi::Byte const*)event->midiData;
 
@@ -784,6 +865,8 @@ void FstPlugin::generate_samples(
         return;
     }
 
+    ScopedFlushToZero const flush_to_zero;
+
     prepare_rendering(sample_count);
     renderer.render<NumberType>(sample_count, samples);
     finalize_rendering(sample_count);
@@ -857,11 +940,16 @@ void FstPlugin::finalize_rendering(Integer const sample_count) noexcept
     synth.clear_dirty_flag();
 
     size_t const current_program = bank.get_current_program_index();
-    std::string const& current_patch = Serializer::serialize(synth);
 
-    bank[current_program].import(current_patch);
+    /*
+    Both chunks are serialized from compiled messages into the binary format,
+    so neither the text form of the programs, nor number formatting is needed
+    here.
+    */
+    bank[current_program].capture(synth);
 
-    std::string const& serialized_bank(bank.serialize());
+    std::string const& current_patch(bank[current_program].serialize_binary(synth));
+    std::string const& serialized_bank(bank.serialize_binary(synth));
 
     to_gui_messages.push(
         Message(MessageType::PROGRAM_CHANGED, current_program, current_patch)
@@ -912,6 +1000,8 @@ void FstPlugin::generate_and_add_samples(
         return;
     }
 
+    ScopedFlushToZero const flush_to_zero;
+
     prepare_rendering(sample_count);
     renderer.render<float, Renderer::Operation::ADD>(sample_count, samples);
     finalize_rendering(sample_count);
@@ -920,15 +1010,20 @@ void FstPlugin::generate_and_add_samples(
 
 VstIntPtr FstPlugin::get_chunk(void** chunk, bool is_preset) noexcept
 {
+    /*
+    Both chunks are binary (see Serializer::serialize_binary()), and set_chunk()
+    still accepts text chunks which were saved by older versions.
+    */
     process_internal_messages_in_gui_thread();
 
     if (is_preset) {
-        Bank::Program program;
-
-        program.import(current_patch);
-        program.set_name(program_names[current_program_index].get_name());
+        Serializer::Messages messages;
 
-        current_patch = program.serialize();
+        if (Serializer::compile_patch(synth, current_patch, messages)) {
+            current_patch = Serializer::serialize_binary(
+                synth, program_names[current_program_index].get_name(), messages
+            );
+        }
 
         *chunk = (void*)current_patch.c_str();
 
@@ -950,10 +1045,7 @@ void FstPlugin::set_chunk(void const* chunk, VstIntPtr const size, bool is_prese
     if (is_preset) {
         current_patch = buffer;
 
-        Bank::Program program;
-        program.import(current_patch);
-
-        std::string const& name(program.get_name());
+        std::string const name(get_program_name(current_patch));
 
         program_names[current_program_index].set_name(name);
 
@@ -968,9 +1060,19 @@ void FstPlugin::set_chunk(void const* chunk, VstIntPtr const size, bool is_prese
 
         program_names.import_names(serialized_bank);
 
-        to_audio_string_messages.push(
-            Message(MessageType::IMPORT_BANK, 0, serialized_bank)
-        );
+        /*
+        Parsing and compiling all the programs of the bank is done here, so
+        that the audio thread only needs to swap them in.
+        */
+        Bank* const imported_bank = new Bank();
+
+        imported_bank->import(synth, serialized_bank);
+
+        if (!to_audio_string_messages.push(
+                Message(MessageType::IMPORT_BANK, imported_bank)
+        )) {
+            delete imported_bank;
+        }
     }
 }
 
@@ -1308,6 +1410,7 @@ FstPlugin::Message::Message(
         std::string const& serialized_data
 ) : serialized_data(serialized_data),
     midi_controller(NULL),
+    bank(NULL),
     new_value(0.0),
     index(index),
     type(type),
@@ -1322,6 +1425,7 @@ FstPlugin::Message::Message(
         MidiController* const midi_controller
 ) : serialized_data(""),
     midi_controller(midi_controller),
+    bank(NULL),
     new_value(new_value),
     index(0),
     type(MessageType::CHANGE_PARAM),
@@ -1330,6 +1434,18 @@ FstPlugin::Message::Message(
 }
 
 
+FstPlugin::Message::Message(MessageType const type, Bank* const bank)
+    : serialized_data(""),
+    midi_controller(NULL),
+    bank(bank),
+    new_value(0.0),
+    index(0),
+    type(type),
+    controller_id(0)
+{
+}
+
+
 FstPlugin::MessageType FstPlugin::Message::get_type() const noexcept
 {
     return type;
@@ -1365,4 +1481,10 @@ MidiController* FstPlugin::Message::get_midi_controller() const noexcept
     return midi_controller;
 }
 
+
+Bank* FstPlugin::Message::get_bank() const noexcept
+{
+    return bank;
+}
+
 }
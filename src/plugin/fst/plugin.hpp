@@ -189,6 +189,8 @@ class FstPlugin : public Midi::EventHandler
             1.0 / BANK_UPDATE_FREQUENCY
         );
 
+        static constexpr size_t MESSAGE_BATCH_SIZE = 16;
+
         enum MessageType {
             NONE = 0,
 
@@ -203,6 +205,7 @@ class FstPlugin : public Midi::EventHandler
             PROGRAM_CHANGED = 6,
             BANK_CHANGED = 7,
             PARAMS_CHANGED = 8,
+            BANK_IMPORTED = 9,
         };
 
         class Message
@@ -219,6 +222,7 @@ class FstPlugin : public Midi::EventHandler
                     Number const new_value,
                     MidiController* const midi_controller
                 );
+                Message(MessageType const type, Bank* const bank);
                 Message(Message const& message) = default;
                 Message(Message&& message) = default;
 
@@ -233,10 +237,12 @@ class FstPlugin : public Midi::EventHandler
                 Midi::Controller get_controller_id() const noexcept;
                 Number get_new_value() const noexcept;
                 MidiController* get_midi_controller() const noexcept;
+                Bank* get_bank() const noexcept;
 
             private:
                 std::string serialized_data;
                 MidiController* midi_controller;
+                Bank* bank;
                 Number new_value;
                 size_t index;
                 MessageType type;
@@ -305,7 +311,7 @@ class FstPlugin : public Midi::EventHandler
         ) noexcept;
 
         void handle_import_patch(std::string const& patch) noexcept;
-        void handle_import_bank(std::string const& serialized_bank) noexcept;
+        void handle_import_bank(Bank* const imported_bank) noexcept;
 
         void handle_program_changed(
             size_t const new_program,
@@ -313,8 +319,11 @@ class FstPlugin : public Midi::EventHandler
         ) noexcept;
 
         void handle_bank_changed(std::string const& serialized_bank) noexcept;
+        void handle_bank_imported(Bank* const old_programs) noexcept;
         void handle_params_changed() noexcept;
 
+        std::string get_program_name(std::string const& patch) const noexcept;
+
         Midi::Byte float_to_midi_byte(float const value) const noexcept;
 
         Parameter parameters[NUMBER_OF_PARAMETERS];
@@ -17,6 +17,7 @@
  */
 
 #include <algorithm>
+#include <cmath>
 #include <string>
 
 #include <vst3sdk/base/source/fstreamer.h>
@@ -94,7 +95,7 @@ FUnknown* Vst3Plugin::Processor::createInstance(void* unused)
 
 Vst3Plugin::Processor::Processor()
     : synth(),
-    renderer(synth),
+    renderer(synth, Renderer::PLUGIN_FIXED_BLOCK_SIZE),
     bank(NULL),
     events(4096),
     new_program(0),
@@ -102,6 +103,11 @@ Vst3Plugin::Processor::Processor()
 {
     setControllerClass(Controller::ID);
     processContextRequirements.needTempo();
+
+    synth.set_background_wavetable_building(true);
+    synth.set_voice_rendering_threads(
+        Synth::get_default_voice_rendering_threads()
+    );
 }
 
 
@@ -164,7 +170,14 @@ tresult PLUGIN_API Vst3Plugin::Processor::notify(Vst::IMessage* message)
         int64 bank_ptr;
 
         if (message->getAttributes()->getInt(MSG_CTL_READY_BANK, bank_ptr) == kResultOk) {
-            bank = (Bank const*)bank_ptr;
+            Bank* const new_bank = (Bank*)bank_ptr;
+
+            /*
+            The controller does not modify its bank after connecting, so the
+            programs can be compiled here, outside the audio thread.
+            */
+            new_bank->compile(synth);
+            bank = new_bank;
             share_synth();
         }
     }
@@ -188,7 +201,9 @@ tresult PLUGIN_API Vst3Plugin::Processor::canProcessSampleSize(int32 symbolic_sa
 
 tresult PLUGIN_API Vst3Plugin::Processor::setupProcessing(Vst::ProcessSetup& setup)
 {
-    synth.set_block_size((Integer)setup.maxSamplesPerBlock);
+    synth.set_block_size(
+        renderer.get_block_size((Integer)setup.maxSamplesPerBlock)
+    );
     synth.set_sample_rate((Frequency)setup.sampleRate);
     renderer.reset();
 
@@ -234,6 +249,8 @@ void Vst3Plugin::Processor::share_synth() noexcept
 
 tresult PLUGIN_API Vst3Plugin::Processor::process(Vst::ProcessData& data)
 {
+    ScopedFlushToZero const flush_to_zero;
+
     collect_param_change_events(data);
     collect_note_events(data);
     std::sort(events.begin(), events.end());
@@ -241,11 +258,18 @@ tresult PLUGIN_API Vst3Plugin::Processor::process(Vst::ProcessData& data)
     events.clear();
 
     if (bank != NULL && need_to_load_new_program) {
-        need_to_load_new_program = false;
-        Serializer::import_patch_in_audio_thread(
-            synth,
-            (*bank)[new_program].serialize()
+        Bank::Program const& program = (*bank)[new_program];
+        Serializer::Messages const* const messages = (
+            program.get_compiled_messages()
         );
+
+        need_to_load_new_program = false;
+
+        if (LIKELY(messages != NULL)) {
+            Serializer::import_patch_in_audio_thread(synth, *messages);
+        } else {
+            Serializer::import_patch_in_audio_thread(synth, program.serialize());
+        }
     }
 
     if (data.numOutputs == 0 || data.numSamples < 1) {
@@ -328,7 +352,7 @@ void Vst3Plugin::Processor::collect_param_change_events_as(
         events.push_back(
             Event(
                 event_type,
-                synth.sample_count_to_time_offset(sample_offset),
+                renderer.time_offset(sample_offset),
                 midi_controller,
                 (Number)value
             )
@@ -358,7 +382,7 @@ void Vst3Plugin::Processor::collect_note_events(Vst::ProcessData& data) noexcept
                 events.push_back(
                     Event(
                         Event::Type::NOTE_ON,
-                        synth.sample_count_to_time_offset(event.sampleOffset),
+                        renderer.time_offset(event.sampleOffset),
                         (Midi::Byte)event.noteOn.pitch,
                         (Number)event.noteOn.velocity
                     )
@@ -369,7 +393,7 @@ void Vst3Plugin::Processor::collect_note_events(Vst::ProcessData& data) noexcept
                 events.push_back(
                     Event(
                         Event::Type::NOTE_OFF,
-                        synth.sample_count_to_time_offset(event.sampleOffset),
+                        renderer.time_offset(event.sampleOffset),
                         (Midi::Byte)event.noteOff.pitch,
                         (Number)event.noteOff.velocity
                     )
@@ -380,7 +404,7 @@ void Vst3Plugin::Processor::collect_note_events(Vst::ProcessData& data) noexcept
                 events.push_back(
                     Event(
                         Event::Type::NOTE_PRESSURE,
-                        synth.sample_count_to_time_offset(event.sampleOffset),
+                        renderer.time_offset(event.sampleOffset),
                         (Midi::Byte)event.polyPressure.pitch,
                         (Number)event.polyPressure.pressure
                     )
@@ -517,12 +541,45 @@ void Vst3Plugin::Processor::generate_samples(Vst::ProcessData& data) noexcept
     } else {
         return;
     }
+
+    data.outputs[0].silenceFlags = (
+        renderer.is_silent()
+            ? ((uint64)1 << (uint64)data.outputs[0].numChannels) - 1
+            : 0
+    );
+}
+
+
+uint32 PLUGIN_API Vst3Plugin::Processor::getLatencySamples()
+{
+    return (uint32)renderer.get_latency();
 }
 
 
 uint32 PLUGIN_API Vst3Plugin::Processor::getTailSamples()
 {
-    return Vst::kInfiniteTail;
+    /*
+    Hosts may ask this repeatedly in order to find out when the plugin can be
+    put to sleep, so the estimate reflects the current state of the synth.
+    This may run outside the audio thread, so the estimate which is published
+    by the audio thread is used.
+    */
+    Seconds const tail_length = synth.get_published_tail_length();
+
+    if (tail_length >= Synth::INFINITE_TAIL_LENGTH) {
+        return Vst::kInfiniteTail;
+    }
+
+    Number const tail_samples = (
+        std::ceil(tail_length * synth.get_sample_rate())
+        + (Number)renderer.get_latency()
+    );
+
+    if (tail_samples >= (Number)Vst::kInfiniteTail) {
+        return Vst::kInfiniteTail;
+    }
+
+    return (uint32)tail_samples;
 }
 
 
@@ -542,33 +599,39 @@ std::string Vst3Plugin::read_stream(IBStream* stream)
 {
     /*
     Not using FStreamer::readString8(), because we need the entire string here,
-    and that method stops at line breaks.
+    and that method stops at line breaks. Binary patches may contain null bytes,
+    so the data is read in bulk, and text patches are cut at the first null
+    byte afterwards.
     */
 
     char* buffer = new char[Serializer::MAX_SIZE];
-    Integer i;
+    Integer size = 0;
     int32 bytes_read;
-    char8 c;
 
-    for (i = 0; i != Serializer::MAX_SIZE; ++i) {
-        stream->read(&c, sizeof(char8), &bytes_read);
+    while (size < Serializer::MAX_SIZE) {
+        bytes_read = 0;
+        stream->read(
+            (void*)&buffer[size], (int32)(Serializer::MAX_SIZE - size), &bytes_read
+        );
 
-        if (bytes_read != sizeof(char8) || c == '\x00') {
+        if (bytes_read <= 0) {
             break;
         }
 
-        buffer[i] = c;
+        size += (Integer)bytes_read;
     }
 
-    if (i >= Serializer::MAX_SIZE) {
-        i = Serializer::MAX_SIZE - 1;
-    }
+    std::string result(buffer, (std::string::size_type)size);
 
-    buffer[i] = '\x00';
+    delete[] buffer;
 
-    std::string const result(buffer, (std::string::size_type)i);
+    if (!Serializer::is_binary(result)) {
+        std::string::size_type const end = result.find('\x00');
 
-    delete[] buffer;
+        if (end != std::string::npos) {
+            result.resize(end);
+        }
+    }
 
     return result;
 }
@@ -580,7 +643,7 @@ tresult PLUGIN_API Vst3Plugin::Processor::getState(IBStream* state)
         return kResultFalse;
     }
 
-    std::string const& serialized = Serializer::serialize(synth);
+    std::string const& serialized = Serializer::serialize_binary(synth);
     int32 const size = serialized.size();
     int32 numBytesWritten;
 
@@ -0,0 +1,682 @@
+/*
+ * This file is part of JS80P, a synthesizer plugin.
+ * Copyright (C) 2023  Attila M. Magyar
+ *
+ * JS80P is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * JS80P is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/*
+Render Standard MIDI Files with JS80P patches into WAV (32 bit float) or raw
+(native endian, interleaved 32 bit float) files, faster than realtime,
+distributing the jobs among multiple threads, each of them using a Synth
+object of its own. E.g.:
+
+    ./build/x86_64-gpp-avx/js80p-render-64bit -j 4 \
+        presets/bells_1.js80p song.mid bells.wav \
+        my_bank.js80p#3 song.mid pad.raw
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "js80p.hpp"
+#include "bank.hpp"
+#include "midi.hpp"
+#include "midi_file.cpp"
+#include "renderer.hpp"
+#include "serializer.hpp"
+#include "synth.hpp"
+
+
+namespace JS80P
+{
+
+class Options
+{
+    public:
+        Options()
+            : threads((Integer)std::thread::hardware_concurrency()),
+            block_size(256),
+            sample_rate(44100.0),
+            tail(2.0),
+            event_grid(1),
+            voice_threads(0)
+        {
+        }
+
+        Integer threads;
+        Integer block_size;
+        Frequency sample_rate;
+        Seconds tail;
+        Integer event_grid;
+        Integer voice_threads;
+};
+
+
+class Job
+{
+    public:
+        Job(
+            std::string const& patch_file,
+            Integer const program_index,
+            std::string const& midi_file,
+            std::string const& output_file
+        ) : patch_file(patch_file),
+            program_index(program_index),
+            midi_file(midi_file),
+            output_file(output_file)
+        {
+        }
+
+        std::string patch_file;
+
+        /* Negative when the patch file is not a bank. */
+        Integer program_index;
+
+        std::string midi_file;
+        std::string output_file;
+};
+
+
+/**
+ * \brief Write interleaved 32 bit float samples into a WAV or a raw file
+ *        through a large buffer, so that the file is written in big chunks.
+ */
+class OutputFile
+{
+    public:
+        static constexpr size_t BUFFER_SIZE = 256 * 1024;
+
+        OutputFile(std::string const& path, bool const is_wav);
+        ~OutputFile();
+
+        bool is_open() const;
+        void write_header(Frequency const sample_rate, size_t const frames);
+        void write_samples(
+            float const* const* channels,
+            Integer const sample_count
+        );
+        bool close();
+
+    private:
+        static constexpr uint32_t WAV_FORMAT_IEEE_FLOAT = 3;
+        static constexpr uint32_t WAV_BYTES_PER_SAMPLE = sizeof(float);
+        static constexpr uint32_t WAV_FORMAT_SIZE = 18;
+
+        void append16(uint32_t const word);
+        void append32(uint32_t const dword);
+        void append(void const* const bytes, size_t const size);
+        void flush();
+
+        FILE* file;
+        bool const is_wav;
+
+        char* const buffer;
+        size_t buffer_pos;
+        bool is_ok;
+};
+
+
+OutputFile::OutputFile(std::string const& path, bool const is_wav)
+    : file(fopen(path.c_str(), "wb")),
+    is_wav(is_wav),
+    buffer(new char[BUFFER_SIZE]),
+    buffer_pos(0),
+    is_ok(file != NULL)
+{
+}
+
+
+OutputFile::~OutputFile()
+{
+    close();
+
+    delete[] buffer;
+}
+
+
+bool OutputFile::is_open() const
+{
+    return file != NULL;
+}
+
+
+void OutputFile::write_header(Frequency const sample_rate, size_t const frames)
+{
+    if (!is_wav) {
+        return;
+    }
+
+    uint32_t const channels = (uint32_t)Synth::OUT_CHANNELS;
+    uint32_t const block_align = channels * WAV_BYTES_PER_SAMPLE;
+    uint32_t const data_size = (uint32_t)(frames * block_align);
+
+    /* RIFF chunk */
+    append("RIFF", 4);
+    append32(4 + (8 + WAV_FORMAT_SIZE) + (8 + 4) + (8 + data_size));
+    append("WAVE", 4);
+
+    /* Format sub-chunk */
+    append("fmt ", 4);
+    append32(WAV_FORMAT_SIZE);
+    append16(WAV_FORMAT_IEEE_FLOAT);
+    append16(channels);
+    append32((uint32_t)sample_rate);
+    append32((uint32_t)sample_rate * block_align);
+    append16(block_align);
+    append16(WAV_BYTES_PER_SAMPLE * 8);
+    append16(0);
+
+    /* Fact sub-chunk, required for non-PCM formats */
+    append("fact", 4);
+    append32(4);
+    append32((uint32_t)frames);
+
+    /* Data sub-chunk */
+    append("data", 4);
+    append32(data_size);
+}
+
+
+void OutputFile::append16(uint32_t const word)
+{
+    unsigned char const bytes[2] = {
+        (unsigned char)(word & 0xff),
+        (unsigned char)((word >> 8) & 0xff),
+    };
+
+    append(bytes, 2);
+}
+
+
+void OutputFile::append32(uint32_t const dword)
+{
+    unsigned char const bytes[4] = {
+        (unsigned char)(dword & 0xff),
+        (unsigned char)((dword >> 8) & 0xff),
+        (unsigned char)((dword >> 16) & 0xff),
+        (unsigned char)((dword >> 24) & 0xff),
+    };
+
+    append(bytes, 4);
+}
+
+
+void OutputFile::append(void const* const bytes, size_t const size)
+{
+    if (buffer_pos + size > BUFFER_SIZE) {
+        flush();
+    }
+
+    std::memcpy(&buffer[buffer_pos], bytes, size);
+    buffer_pos += size;
+}
+
+
+void OutputFile::write_samples(
+        float const* const* channels,
+        Integer const sample_count
+) {
+    constexpr size_t frame_size = sizeof(float) * (size_t)Synth::OUT_CHANNELS;
+
+    for (Integer i = 0; i != sample_count; ++i) {
+        if (UNLIKELY(buffer_pos + frame_size > BUFFER_SIZE)) {
+            flush();
+        }
+
+        /* WAV is little endian, and so is every target platform of JS80P. */
+        float* const frame = (float*)&buffer[buffer_pos];
+
+        for (Integer c = 0; c != Synth::OUT_CHANNELS; ++c) {
+            frame[c] = channels[c][i];
+        }
+
+        buffer_pos += frame_size;
+    }
+}
+
+
+void OutputFile::flush()
+{
+    if (buffer_pos == 0) {
+        return;
+    }
+
+    if (is_ok) {
+        is_ok = fwrite(buffer, 1, buffer_pos, file) == buffer_pos;
+    }
+
+    buffer_pos = 0;
+}
+
+
+bool OutputFile::close()
+{
+    if (file == NULL) {
+        return false;
+    }
+
+    flush();
+
+    if (fclose(file) != 0) {
+        is_ok = false;
+    }
+
+    file = NULL;
+
+    return is_ok;
+}
+
+
+bool read_file(std::string const& path, std::string& result)
+{
+    std::ifstream file(path, std::ios::in | std::ios::binary);
+
+    if (!file.is_open()) {
+        return false;
+    }
+
+    result.assign(
+        std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()
+    );
+
+    return !file.bad();
+}
+
+
+bool ends_with(std::string const& text, std::string const& suffix)
+{
+    return (
+        text.length() >= suffix.length()
+        && text.compare(text.length() - suffix.length(), suffix.length(), suffix) == 0
+    );
+}
+
+
+/**
+ * \brief A thread which renders jobs one after the other with its own Synth
+ *        object, until there are no more jobs left.
+ */
+class Worker
+{
+    public:
+        Worker(
+            Options const& options,
+            std::vector<Job> const& jobs,
+            std::atomic<size_t>& next_job,
+            std::mutex& report_mutex
+        );
+
+        ~Worker();
+
+        void run();
+
+        Integer failures;
+
+    private:
+        bool render(Job const& job, Seconds& length, std::string& error);
+        void report(
+            Job const& job,
+            bool const is_ok,
+            Seconds const length,
+            Seconds const elapsed,
+            std::string const& error
+        );
+
+        Options const& options;
+        std::vector<Job> const& jobs;
+        std::atomic<size_t>& next_job;
+        std::mutex& report_mutex;
+
+        Synth* const synth;
+        float* buffer[Synth::OUT_CHANNELS];
+        MidiFile midi_file;
+};
+
+
+Worker::Worker(
+        Options const& options,
+        std::vector<Job> const& jobs,
+        std::atomic<size_t>& next_job,
+        std::mutex& report_mutex
+) : failures(0),
+    options(options),
+    jobs(jobs),
+    next_job(next_job),
+    report_mutex(report_mutex),
+    synth(new Synth())
+{
+    for (Integer c = 0; c != Synth::OUT_CHANNELS; ++c) {
+        buffer[c] = new float[options.block_size];
+    }
+
+    synth->set_voice_rendering_threads(options.voice_threads);
+}
+
+
+Worker::~Worker()
+{
+    for (Integer c = 0; c != Synth::OUT_CHANNELS; ++c) {
+        delete[] buffer[c];
+    }
+
+    delete synth;
+}
+
+
+void Worker::run()
+{
+    size_t job_index;
+
+    while ((job_index = next_job.fetch_add(1)) < jobs.size()) {
+        Job const& job = jobs[job_index];
+        Seconds length = 0.0;
+        std::string error;
+
+        std::chrono::steady_clock::time_point const start = (
+            std::chrono::steady_clock::now()
+        );
+
+        bool const is_ok = render(job, length, error);
+
+        Seconds const elapsed = std::chrono::duration<Seconds>(
+            std::chrono::steady_clock::now() - start
+        ).count();
+
+        if (!is_ok) {
+            ++failures;
+        }
+
+        report(job, is_ok, length, elapsed, error);
+    }
+}
+
+
+bool Worker::render(Job const& job, Seconds& length, std::string& error)
+{
+    std::string patch;
+    std::string midi;
+
+    if (!read_file(job.patch_file, patch)) {
+        error = "unable to read patch file: " + job.patch_file;
+
+        return false;
+    }
+
+    if (job.program_index >= 0) {
+        Bank bank;
+
+        bank.import(patch);
+        patch = bank[(size_t)job.program_index].serialize();
+    }
+
+    if (!read_file(job.midi_file, midi)) {
+        error = "unable to read MIDI file: " + job.midi_file;
+
+        return false;
+    }
+
+    if (!midi_file.parse(midi, error)) {
+        error = job.midi_file + ": " + error;
+
+        return false;
+    }
+
+    length = midi_file.length + options.tail;
+
+    Integer const frames = (Integer)std::ceil(length * options.sample_rate);
+    OutputFile output_file(job.output_file, !ends_with(job.output_file, ".raw"));
+
+    if (!output_file.is_open()) {
+        error = "unable to open output file: " + job.output_file;
+
+        return false;
+    }
+
+    Serializer::import_patch_in_audio_thread(*synth, patch);
+
+    synth->suspend();
+    synth->set_block_size(options.block_size);
+    synth->set_sample_rate(options.sample_rate);
+    synth->resume();
+    synth->process_message(
+        Synth::MessageType::SET_EVENT_GRID,
+        Synth::ParamId::MAX_PARAM_ID,
+        (Number)options.event_grid,
+        0
+    );
+    synth->process_messages();
+
+    JS80P::Renderer renderer(*synth);
+    std::vector<MidiFile::Event>::const_iterator next_event = (
+        midi_file.events.begin()
+    );
+    std::vector<MidiFile::Event>::const_iterator const end = midi_file.events.end();
+
+    output_file.write_header(options.sample_rate, (size_t)frames);
+
+    for (Integer frame = 0; frame < frames; frame += options.block_size) {
+        Integer const sample_count = std::min(options.block_size, frames - frame);
+        Seconds const block_start = (Seconds)frame / options.sample_rate;
+        Seconds const block_end = (
+            (Seconds)(frame + sample_count) / options.sample_rate
+        );
+
+        for (; next_event != end && next_event->time < block_end; ++next_event) {
+            Midi::Dispatcher::dispatch<Synth>(
+                *synth,
+                std::max(0.0, next_event->time - block_start),
+                next_event->bytes
+            );
+        }
+
+        renderer.render<float>(sample_count, buffer);
+        output_file.write_samples(buffer, sample_count);
+    }
+
+    if (!output_file.close()) {
+        error = "unable to write output file: " + job.output_file;
+
+        return false;
+    }
+
+    return true;
+}
+
+
+void Worker::report(
+        Job const& job,
+        bool const is_ok,
+        Seconds const length,
+        Seconds const elapsed,
+        std::string const& error
+) {
+    std::lock_guard<std::mutex> lock(report_mutex);
+
+    if (!is_ok) {
+        fprintf(stderr, "ERROR: %s\n", error.c_str());
+
+        return;
+    }
+
+    fprintf(
+        stdout,
+        "%s\t%.3f\t%.3f\t%.2f\n",
+        job.output_file.c_str(),
+        length,
+        elapsed,
+        elapsed > 0.0 ? length / elapsed : 0.0
+    );
+    fflush(stdout);
+}
+
+}
+
+
+using namespace JS80P;
+
+
+void usage(char const* const name)
+{
+    fprintf(stderr, "Usage: %s [options] PATCH MIDI OUTPUT [PATCH MIDI OUTPUT ...]\n", name);
+    fprintf(stderr, "\n");
+    fprintf(stderr, "    PATCH      patch file, or BANK#N for the N-th program (0-%d) of a bank file\n", (int)Bank::NUMBER_OF_PROGRAMS - 1);
+    fprintf(stderr, "    MIDI       Standard MIDI File (format 0 or 1)\n");
+    fprintf(stderr, "    OUTPUT     32 bit float .wav file, or .raw for headerless interleaved floats\n");
+    fprintf(stderr, "\n");
+    fprintf(stderr, "Options:\n");
+    fprintf(stderr, "    -j N       number of threads (default: number of CPU cores)\n");
+    fprintf(stderr, "    -v N       additional voice rendering threads for each job (0-%d, default: 0)\n", (int)Synth::MAX_VOICE_RENDERING_THREADS);
+    fprintf(stderr, "    -r RATE    sample rate (default: 44100)\n");
+    fprintf(stderr, "    -b SIZE    block size (default: 256)\n");
+    fprintf(stderr, "    -t SECS    time to render after the end of the MIDI file (default: 2)\n");
+    fprintf(stderr, "    -g N       start parameter ramps only at every N-th sample of a block (default: 1)\n");
+    fprintf(stderr, "\n");
+    fprintf(stderr, "Prints the output file, its length, the rendering time and the realtime factor\n");
+    fprintf(stderr, "of each job as tab separated values.\n");
+}
+
+
+bool parse_options(int const argc, char const* const* const argv, Options& options, int& arg)
+{
+    for (arg = 1; arg + 1 < argc && argv[arg][0] == '-'; arg += 2) {
+        std::string const option(argv[arg]);
+        char const* const value = argv[arg + 1];
+
+        if (option == "-j") {
+            options.threads = (Integer)atoi(value);
+        } else if (option == "-v") {
+            options.voice_threads = (Integer)atoi(value);
+        } else if (option == "-r") {
+            options.sample_rate = (Frequency)atof(value);
+        } else if (option == "-b") {
+            options.block_size = (Integer)atoi(value);
+        } else if (option == "-t") {
+            options.tail = (Seconds)atof(value);
+        } else if (option == "-g") {
+            options.event_grid = (Integer)atoi(value);
+        } else {
+            return false;
+        }
+    }
+
+    return (
+        options.sample_rate >= 1.0
+        && options.block_size > 0
+        && options.tail >= 0.0
+        && options.event_grid > 0
+        && 0 <= options.voice_threads
+        && options.voice_threads <= Synth::MAX_VOICE_RENDERING_THREADS
+    );
+}
+
+
+bool parse_jobs(int const argc, char const* const* const argv, int arg, std::vector<Job>& jobs)
+{
+    if (arg == argc || (argc - arg) % 3 != 0) {
+        return false;
+    }
+
+    for (; arg != argc; arg += 3) {
+        std::string patch_file(argv[arg]);
+        std::string::size_type const separator = patch_file.rfind('#');
+        Integer program_index = -1;
+
+        /*
+        A '#' may also be part of an ordinary file name, so only a non-empty,
+        all digits suffix is treated as a program index.
+        */
+        if (
+                separator != std::string::npos
+                && separator + 1 < patch_file.size()
+                && std::all_of(
+                    patch_file.begin() + separator + 1,
+                    patch_file.end(),
+                    [](char const c) { return c >= '0' && c <= '9'; }
+                )
+        ) {
+            unsigned long const index = strtoul(
+                patch_file.c_str() + separator + 1, NULL, 10
+            );
+
+            if (index >= (unsigned long)Bank::NUMBER_OF_PROGRAMS) {
+                return false;
+            }
+
+            program_index = (Integer)index;
+            patch_file.erase(separator);
+        }
+
+        jobs.push_back(Job(patch_file, program_index, argv[arg + 1], argv[arg + 2]));
+    }
+
+    return true;
+}
+
+
+int main(int const argc, char const* const* const argv)
+{
+    Options options;
+    std::vector<Job> jobs;
+    int arg;
+
+    if (!parse_options(argc, argv, options, arg) || !parse_jobs(argc, argv, arg, jobs)) {
+        usage(argv[0]);
+
+        return 1;
+    }
+
+    size_t const threads = (size_t)std::max(
+        (Integer)1, std::min(options.threads, (Integer)jobs.size())
+    );
+    std::atomic<size_t> next_job(0);
+    std::mutex report_mutex;
+    std::vector<Worker*> workers;
+    std::vector<std::thread> worker_threads;
+
+    for (size_t i = 0; i != threads; ++i) {
+        workers.push_back(new Worker(options, jobs, next_job, report_mutex));
+    }
+
+    for (size_t i = 1; i != threads; ++i) {
+        worker_threads.push_back(std::thread(&Worker::run, workers[i]));
+    }
+
+    workers[0]->run();
+
+    Integer failures = 0;
+
+    for (size_t i = 0; i != threads; ++i) {
+        if (i != 0) {
+            worker_threads[i - 1].join();
+        }
+
+        failures += workers[i]->failures;
+        delete workers[i];
+    }
+
+    return failures == 0 ? 0 : 2;
+}
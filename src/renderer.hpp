@@ -19,10 +19,24 @@
 #ifndef JS80P__RENDERER_HPP
 #define JS80P__RENDERER_HPP
 
+#include <algorithm>
+
 #include "js80p.hpp"
 
 #include "synth.hpp"
 
+#include "dsp/math.hpp"
+
+
+/*
+Building with e.g. JS80P_FIXED_BLOCK_SIZE=128 makes the plugins render blocks
+of that size regardless of the buffer sizes that the host uses, at the cost of
+the same amount of latency.
+*/
+#ifndef JS80P_FIXED_BLOCK_SIZE
+#define JS80P_FIXED_BLOCK_SIZE 0
+#endif
+
 
 namespace JS80P
 {
@@ -36,19 +50,89 @@ class Renderer
             OVERWRITE = 1,
         };
 
-        Renderer(Synth& synth)
+        static constexpr Integer PLUGIN_FIXED_BLOCK_SIZE = JS80P_FIXED_BLOCK_SIZE;
+
+        /**
+         * \brief When \c fixed_block_size is positive, then the synth renders
+         *        blocks of exactly that size into a buffer, and host buffers
+         *        of any size are served from there, delayed by
+         *        \c fixed_block_size samples (see \c get_latency()). MIDI
+         *        events must then be timed with \c time_offset().
+         */
+        Renderer(Synth& synth, Integer const fixed_block_size = 0)
             : synth(synth),
+            fixed_block_size(std::max((Integer)0, fixed_block_size)),
             round(0),
-            previous_round_sample_count(0)
+            previous_round_sample_count(0),
+            fixed_block_position(0),
+            is_fixed_block_silent(true),
+            is_last_output_silent(true)
         {
+            for (Integer c = 0; c != Synth::OUT_CHANNELS; ++c) {
+                if (this->fixed_block_size > 0) {
+                    fixed_block[c] = new Sample[this->fixed_block_size];
+                    std::fill_n(fixed_block[c], this->fixed_block_size, 0.0);
+                } else {
+                    fixed_block[c] = NULL;
+                }
+            }
+        }
+
+        ~Renderer()
+        {
+            for (Integer c = 0; c != Synth::OUT_CHANNELS; ++c) {
+                if (fixed_block[c] != NULL) {
+                    delete[] fixed_block[c];
+                    fixed_block[c] = NULL;
+                }
+            }
+        }
+
+        Renderer(Renderer const& renderer) = delete;
+        Renderer& operator=(Renderer const& renderer) = delete;
+
+        /**
+         * \brief The number of samples by which the output lags behind the
+         *        events.
+         */
+        Integer get_latency() const noexcept
+        {
+            return fixed_block_size;
+        }
+
+        /**
+         * \brief The block size that the synth needs to be configured with when
+         *        the host may send at most \c host_block_size samples at once.
+         */
+        Integer get_block_size(Integer const host_block_size) const noexcept
+        {
+            return fixed_block_size > 0 ? fixed_block_size : host_block_size;
+        }
+
+        /**
+         * \brief Convert the position of an event within the next host buffer
+         *        into a time offset for the synth.
+         *
+         * \note In fixed block size mode, the synth may be behind the host by
+         *       the samples which are still waiting in the buffer, so events
+         *       need to be re-based in order to keep a fixed latency.
+         */
+        Seconds time_offset(Integer const sample_offset) const noexcept
+        {
+            return synth.sample_count_to_time_offset(
+                sample_offset + fixed_block_position
+            );
+        }
+
+        /**
+         * \brief Tell whether everything that the last \c render() call
+         *        produced was silent.
+         */
+        bool is_silent() const noexcept
+        {
+            return is_last_output_silent;
         }
 
-        /*
-        Some hosts do use variable size buffers, and we don't want delay
-        feedback buffers to run out of samples when a long batch is rendered
-        after a shorter one, so we split up rendering batches into chunks that
-        are smaller than the previously rendered batch.
-        */
         template<typename NumberType, Operation operation = Operation::OVERWRITE>
         void render(Integer const sample_count, NumberType** buffer)
         {
@@ -56,6 +140,69 @@ class Renderer
                 return;
             }
 
+            is_last_output_silent = true;
+
+            ScopedFlushToZero const flush_to_zero;
+
+            if (fixed_block_size > 0) {
+                render_fixed_blocks<NumberType, operation>(sample_count, buffer);
+            } else {
+                render_variable_blocks<NumberType, operation>(sample_count, buffer);
+            }
+        }
+
+        void reset()
+        {
+            previous_round_sample_count = 0;
+
+            if (fixed_block_size > 0) {
+                for (Integer c = 0; c != Synth::OUT_CHANNELS; ++c) {
+                    std::fill_n(fixed_block[c], fixed_block_size, 0.0);
+                }
+
+                fixed_block_position = 0;
+            }
+
+            is_fixed_block_silent = true;
+            is_last_output_silent = true;
+        }
+
+    private:
+        static constexpr Integer ROUND_MASK = 0x7fffff;
+
+        template<typename NumberType, Operation operation>
+        static void copy(
+                Sample const* const* samples,
+                Integer const samples_position,
+                NumberType** buffer,
+                Integer const buffer_position,
+                Integer const sample_count
+        ) {
+            for (Integer c = 0; c != Synth::OUT_CHANNELS; ++c) {
+                Sample const* const src = &samples[c][samples_position];
+                NumberType* const dst = &buffer[c][buffer_position];
+
+                if constexpr (operation == Operation::OVERWRITE) {
+                    for (Integer i = 0; i != sample_count; ++i) {
+                        dst[i] = (NumberType)src[i];
+                    }
+                } else {
+                    for (Integer i = 0; i != sample_count; ++i) {
+                        dst[i] += (NumberType)src[i];
+                    }
+                }
+            }
+        }
+
+        /*
+        Some hosts do use variable size buffers, and we don't want delay
+        feedback buffers to run out of samples when a long batch is rendered
+        after a shorter one, so we split up rendering batches into chunks that
+        are smaller than the previously rendered batch.
+        */
+        template<typename NumberType, Operation operation>
+        void render_variable_blocks(Integer const sample_count, NumberType** buffer)
+        {
             Integer const previous_round_sample_count = (
                 LIKELY(this->previous_round_sample_count != 0)
                     ? this->previous_round_sample_count
@@ -78,19 +225,13 @@ class Renderer
                     round, round_size
                 );
 
-                if constexpr (operation == Operation::OVERWRITE) {
-                    for (Integer c = 0; c != Synth::OUT_CHANNELS; ++c) {
-                        for (Integer i = 0; i != round_size; ++i) {
-                            buffer[c][buffer_pos + i] = (NumberType)samples[c][i];
-                        }
-                    }
-                } else {
-                    for (Integer c = 0; c != Synth::OUT_CHANNELS; ++c) {
-                        for (Integer i = 0; i != round_size; ++i) {
-                            buffer[c][buffer_pos + i] += (NumberType)samples[c][i];
-                        }
-                    }
-                }
+                copy<NumberType, operation>(
+                    samples, 0, buffer, buffer_pos, round_size
+                );
+
+                is_last_output_silent = (
+                    is_last_output_silent && synth.is_silent(round, round_size)
+                );
 
                 buffer_pos += round_size;
             }
@@ -98,17 +239,58 @@ class Renderer
             this->previous_round_sample_count = sample_count;
         }
 
-        void reset()
+        /*
+        The buffer starts out with a block of silence, and a new block is
+        rendered whenever the previous one has been used up, so the output is
+        always exactly fixed_block_size samples behind the synth's timeline,
+        and the synth is never ahead of the host.
+        */
+        template<typename NumberType, Operation operation>
+        void render_fixed_blocks(Integer const sample_count, NumberType** buffer)
         {
-            previous_round_sample_count = 0;
-        }
+            Integer buffer_pos = 0;
 
-    private:
-        static constexpr Integer ROUND_MASK = 0x7fffff;
+            while (buffer_pos != sample_count) {
+                if (fixed_block_position == fixed_block_size) {
+                    round = (round + 1) & ROUND_MASK;
+
+                    Sample const* const* samples = synth.generate_samples(
+                        round, fixed_block_size
+                    );
+
+                    for (Integer c = 0; c != Synth::OUT_CHANNELS; ++c) {
+                        std::copy_n(samples[c], fixed_block_size, fixed_block[c]);
+                    }
+
+                    is_fixed_block_silent = synth.is_silent(round, fixed_block_size);
+                    fixed_block_position = 0;
+                }
+
+                Integer const size = std::min(
+                    fixed_block_size - fixed_block_position,
+                    sample_count - buffer_pos
+                );
+
+                copy<NumberType, operation>(
+                    fixed_block, fixed_block_position, buffer, buffer_pos, size
+                );
+
+                is_last_output_silent = (
+                    is_last_output_silent && is_fixed_block_silent
+                );
+                fixed_block_position += size;
+                buffer_pos += size;
+            }
+        }
 
         Synth& synth;
+        Integer const fixed_block_size;
         Integer round;
         Integer previous_round_sample_count;
+        Integer fixed_block_position;
+        bool is_fixed_block_silent;
+        bool is_last_output_silent;
+        Sample* fixed_block[Synth::OUT_CHANNELS];
 };
 
 }
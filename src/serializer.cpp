@@ -34,11 +34,11 @@ std::string const Serializer::CONTROLLER_SUFFIX = "ctl";
 
 std::string const Serializer::LINE_END = "\r\n";
 
+constexpr char Serializer::BINARY_MAGIC[8];
+
 
 std::string Serializer::serialize(Synth const& synth) noexcept
 {
-    constexpr size_t line_size = 128;
-    char line[line_size];
     std::string serialized("");
 
     serialized.reserve(MAX_SIZE);
@@ -61,29 +61,15 @@ std::string Serializer::serialize(Synth const& synth) noexcept
                 Number const default_ratio = synth.get_param_default_ratio(param_id);
 
                 if (std::fabs(default_ratio - set_ratio) > 0.000001) {
-                    int const length = snprintf(
-                        line,
-                        line_size,
-                        "%s = %.15f",
-                        param_name.c_str(),
-                        set_ratio
-                    );
-                    trim_excess_zeros_from_end_after_snprintf(line, length, line_size);
-                    serialized += line;
-                    serialized += LINE_END;
+                    serialize_line(serialized, param_name, "", set_ratio);
                 }
             } else {
-                int const length = snprintf(
-                    line,
-                    line_size,
-                    "%s%s = %.15f",
-                    param_name.c_str(),
+                serialize_line(
+                    serialized,
+                    param_name,
                     CONTROLLER_SUFFIX.c_str(),
                     controller_id_to_float(controller_id)
                 );
-                trim_excess_zeros_from_end_after_snprintf(line, length, line_size);
-                serialized += line;
-                serialized += LINE_END;
             }
         }
     }
@@ -92,6 +78,389 @@ std::string Serializer::serialize(Synth const& synth) noexcept
 }
 
 
+std::string Serializer::serialize(
+        Synth const& synth,
+        Messages const& messages
+) noexcept {
+    Synth::Message const* messages_by_param[Synth::ParamId::MAX_PARAM_ID];
+    std::string serialized("");
+
+    std::fill_n(messages_by_param, Synth::ParamId::MAX_PARAM_ID, (Synth::Message const*)NULL);
+
+    for (Messages::const_iterator it = messages.begin(); it != messages.end(); ++it) {
+        if ((int)it->param_id < (int)Synth::ParamId::MAX_PARAM_ID) {
+            messages_by_param[it->param_id] = &*it;
+        }
+    }
+
+    serialized.reserve(MAX_SIZE);
+    serialized += "[";
+    serialized += JS80P_SECTION_NAME;
+    serialized += "]";
+    serialized += LINE_END;
+
+    /* Same order as serialize(), so that the two produce identical text. */
+    for (int i = 0; i != Synth::ParamId::MAX_PARAM_ID; ++i) {
+        Synth::Message const* const message = messages_by_param[i];
+
+        if (message == NULL) {
+            continue;
+        }
+
+        std::string const& param_name = synth.get_param_name(message->param_id);
+
+        if (message->type == Synth::MessageType::SET_PARAM) {
+            serialize_line(serialized, param_name, "", message->number_param);
+        } else if (message->type == Synth::MessageType::ASSIGN_CONTROLLER) {
+            serialize_line(
+                serialized,
+                param_name,
+                CONTROLLER_SUFFIX.c_str(),
+                controller_id_to_float((Synth::ControllerId)message->byte_param)
+            );
+        }
+    }
+
+    return serialized;
+}
+
+
+void Serializer::serialize_line(
+        std::string& serialized,
+        std::string const& param_name,
+        char const* const suffix,
+        Number const value
+) noexcept {
+    constexpr size_t line_size = 128;
+    char line[line_size];
+
+    int const length = snprintf(
+        line, line_size, "%s%s = %.15f", param_name.c_str(), suffix, value
+    );
+    trim_excess_zeros_from_end_after_snprintf(line, length, line_size);
+    serialized += line;
+    serialized += LINE_END;
+}
+
+
+std::string Serializer::serialize_binary(Synth const& synth) noexcept
+{
+    Messages messages;
+
+    messages.reserve(Synth::ParamId::MAX_PARAM_ID);
+    compile_patch(synth, messages);
+
+    return serialize_binary(synth, "", messages);
+}
+
+
+std::string Serializer::serialize_binary(
+        Synth const& synth,
+        std::string const& name,
+        Messages const& messages
+) noexcept {
+    std::string serialized;
+
+    serialize_binary_header(synth, 1, serialized);
+    serialize_binary_program(name, messages, serialized);
+
+    return serialized;
+}
+
+
+void Serializer::serialize_binary_header(
+        Synth const& synth,
+        uint32_t const program_count,
+        std::string& serialized
+) noexcept {
+    uint32_t const version = BINARY_VERSION;
+    uint32_t const param_count = (uint32_t)Synth::ParamId::MAX_PARAM_ID;
+    uint64_t const param_names_hash = hash_param_names(synth);
+
+    serialized.clear();
+    serialized.reserve(
+        BINARY_HEADER_SIZE + param_count * (Constants::PARAM_NAME_MAX_LENGTH + 1)
+    );
+    serialized.append(BINARY_MAGIC, sizeof(BINARY_MAGIC));
+    serialized.append((char const*)&version, sizeof(version));
+    serialized.append((char const*)&param_count, sizeof(param_count));
+    serialized.append((char const*)&param_names_hash, sizeof(param_names_hash));
+    serialized.append((char const*)&program_count, sizeof(program_count));
+
+    for (uint32_t i = 0; i != param_count; ++i) {
+        std::string const& param_name = synth.get_param_name((Synth::ParamId)i);
+
+        serialized += (char)(uint8_t)param_name.length();
+        serialized += param_name;
+    }
+}
+
+
+void Serializer::serialize_binary_program(
+        std::string const& name,
+        Messages const& messages,
+        std::string& serialized
+) noexcept {
+    uint8_t const name_length = (uint8_t)std::min(name.length(), (size_t)255);
+    uint32_t entry_count = 0;
+
+    for (Messages::const_iterator it = messages.begin(); it != messages.end(); ++it) {
+        if (
+                (int)it->param_id < (int)Synth::ParamId::MAX_PARAM_ID
+                && (
+                    it->type == Synth::MessageType::SET_PARAM
+                    || it->type == Synth::MessageType::ASSIGN_CONTROLLER
+                )
+        ) {
+            ++entry_count;
+        }
+    }
+
+    serialized += (char)name_length;
+    serialized.append(name, 0, name_length);
+    serialized.append((char const*)&entry_count, sizeof(entry_count));
+
+    for (Messages::const_iterator it = messages.begin(); it != messages.end(); ++it) {
+        if ((int)it->param_id >= (int)Synth::ParamId::MAX_PARAM_ID) {
+            continue;
+        }
+
+        uint16_t const param_index = (uint16_t)it->param_id;
+        uint8_t controller_id;
+        double ratio;
+
+        if (it->type == Synth::MessageType::SET_PARAM) {
+            controller_id = (uint8_t)Synth::ControllerId::NONE;
+            ratio = (double)it->number_param;
+        } else if (it->type == Synth::MessageType::ASSIGN_CONTROLLER) {
+            controller_id = (uint8_t)it->byte_param;
+            ratio = 0.0;
+        } else {
+            continue;
+        }
+
+        serialized.append((char const*)&param_index, sizeof(param_index));
+        serialized.append((char const*)&controller_id, sizeof(controller_id));
+        serialized.append((char const*)&ratio, sizeof(ratio));
+    }
+}
+
+
+bool Serializer::is_binary(std::string const& serialized) noexcept
+{
+    return (
+        serialized.length() >= BINARY_HEADER_SIZE
+        && memcmp(serialized.data(), BINARY_MAGIC, sizeof(BINARY_MAGIC)) == 0
+    );
+}
+
+
+uint64_t Serializer::hash_param_names(Synth const& synth) noexcept
+{
+    /* FNV-1a */
+    uint64_t hash = 0xcbf29ce484222325;
+
+    for (int i = 0; i != Synth::ParamId::MAX_PARAM_ID; ++i) {
+        std::string const& param_name = synth.get_param_name((Synth::ParamId)i);
+
+        for (std::string::const_iterator it = param_name.begin(); it != param_name.end(); ++it) {
+            hash = (hash ^ (uint64_t)(uint8_t)*it) * 0x100000001b3;
+        }
+
+        hash = hash * 0x100000001b3;
+    }
+
+    return hash;
+}
+
+
+bool Serializer::parse_binary(
+        Synth const& synth,
+        std::string const& serialized,
+        BinaryPrograms& programs
+) noexcept {
+    return parse_binary(&synth, serialized, programs);
+}
+
+
+bool Serializer::parse_binary_names(
+        std::string const& serialized,
+        BinaryPrograms& programs
+) noexcept {
+    return parse_binary(NULL, serialized, programs);
+}
+
+
+bool Serializer::parse_binary(
+        Synth const* const synth,
+        std::string const& serialized,
+        BinaryPrograms& programs
+) noexcept {
+    char const* const data = serialized.data();
+    size_t const size = serialized.length();
+    size_t pos = sizeof(BINARY_MAGIC);
+    uint32_t version;
+    uint32_t param_count;
+    uint64_t param_names_hash;
+    uint32_t program_count;
+
+    programs.clear();
+
+    if (!is_binary(serialized)) {
+        return false;
+    }
+
+    memcpy(&version, &data[pos], sizeof(version));
+    pos += sizeof(version);
+    memcpy(&param_count, &data[pos], sizeof(param_count));
+    pos += sizeof(param_count);
+    memcpy(&param_names_hash, &data[pos], sizeof(param_names_hash));
+    pos += sizeof(param_names_hash);
+    memcpy(&program_count, &data[pos], sizeof(program_count));
+    pos += sizeof(program_count);
+
+    if (version != BINARY_VERSION) {
+        return false;
+    }
+
+    bool const is_same_layout = (
+        synth != NULL
+        && param_count == (uint32_t)Synth::ParamId::MAX_PARAM_ID
+        && param_names_hash == hash_param_names(*synth)
+    );
+    std::vector<Synth::ParamId> param_ids(param_count, Synth::ParamId::MAX_PARAM_ID);
+
+    for (uint32_t i = 0; i != param_count; ++i) {
+        if (pos >= size) {
+            return false;
+        }
+
+        size_t const length = (size_t)(uint8_t)data[pos++];
+
+        if (pos + length > size) {
+            return false;
+        }
+
+        if (is_same_layout) {
+            param_ids[i] = (Synth::ParamId)i;
+        } else if (synth != NULL && length > 0) {
+            param_ids[i] = synth->get_param_id(std::string(&data[pos], length));
+        }
+
+        pos += length;
+    }
+
+    /* Each program takes at least a name length and an entry count. */
+    if (program_count > (size - pos) / (1 + sizeof(uint32_t))) {
+        return false;
+    }
+
+    programs.resize(program_count);
+
+    for (uint32_t i = 0; i != program_count; ++i) {
+        if (!parse_binary_program(synth, param_ids, serialized, pos, programs[i])) {
+            programs.clear();
+
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+bool Serializer::parse_binary_program(
+        Synth const* const synth,
+        std::vector<Synth::ParamId> const& param_ids,
+        std::string const& serialized,
+        size_t& pos,
+        BinaryProgram& program
+) noexcept {
+    char const* const data = serialized.data();
+    size_t const size = serialized.length();
+    uint32_t entry_count;
+
+    if (pos >= size) {
+        return false;
+    }
+
+    size_t const name_length = (size_t)(uint8_t)data[pos++];
+
+    if (pos + name_length + sizeof(entry_count) > size) {
+        return false;
+    }
+
+    program.name.assign(&data[pos], name_length);
+    pos += name_length;
+
+    memcpy(&entry_count, &data[pos], sizeof(entry_count));
+    pos += sizeof(entry_count);
+
+    if (entry_count > (size - pos) / BINARY_ENTRY_SIZE) {
+        return false;
+    }
+
+    char const* const entries = &data[pos];
+
+    pos += entry_count * BINARY_ENTRY_SIZE;
+
+    if (synth == NULL) {
+        return true;
+    }
+
+    program.messages.reserve(Synth::ParamId::MAX_PARAM_ID);
+
+    for (int toggles = 1; toggles != -1; --toggles) {
+        for (uint32_t i = 0; i != entry_count; ++i) {
+            char const* const entry = &entries[i * BINARY_ENTRY_SIZE];
+            uint16_t param_index;
+            uint8_t controller_id;
+            double ratio;
+
+            memcpy(&param_index, entry, sizeof(param_index));
+            memcpy(&controller_id, &entry[sizeof(param_index)], sizeof(controller_id));
+            memcpy(
+                &ratio,
+                &entry[sizeof(param_index) + sizeof(controller_id)],
+                sizeof(ratio)
+            );
+
+            if ((size_t)param_index >= param_ids.size()) {
+                continue;
+            }
+
+            Synth::ParamId const param_id = param_ids[param_index];
+
+            if (
+                    param_id == Synth::ParamId::MAX_PARAM_ID
+                    || synth->is_toggle_param(param_id) != (toggles == 1)
+            ) {
+                continue;
+            }
+
+            if (controller_id == Synth::ControllerId::NONE) {
+                program.messages.push_back(
+                    Synth::Message(
+                        Synth::MessageType::SET_PARAM, param_id, (Number)ratio, 0
+                    )
+                );
+            } else {
+                program.messages.push_back(
+                    Synth::Message(
+                        Synth::MessageType::ASSIGN_CONTROLLER,
+                        param_id,
+                        0.0,
+                        (Byte)controller_id
+                    )
+                );
+            }
+        }
+    }
+
+    return true;
+}
+
+
 void Serializer::trim_excess_zeros_from_end_after_snprintf(
         char* number,
         int const length,
@@ -170,13 +539,120 @@ void Serializer::import_patch_in_audio_thread(
 }
 
 
+void Serializer::import_patch_in_audio_thread(
+        Synth& synth,
+        Messages const& messages
+) noexcept {
+    synth.process_messages();
+    send_messages<Thread::AUDIO>(synth, messages);
+}
+
+
+bool Serializer::compile_patch(
+        Synth const& synth,
+        std::string const& serialized,
+        Messages& messages
+) noexcept {
+    if (!is_binary(serialized)) {
+        compile_text(synth, serialized, messages);
+
+        return true;
+    }
+
+    BinaryPrograms programs;
+
+    messages.clear();
+
+    if (!parse_binary(synth, serialized, programs) || programs.empty()) {
+        return false;
+    }
+
+    messages.swap(programs[0].messages);
+
+    return true;
+}
+
+
+void Serializer::compile_text(
+        Synth const& synth,
+        std::string const& serialized,
+        Messages& messages
+) noexcept {
+    Lines* lines = parse_lines(serialized);
+    process_lines(synth, lines, messages);
+
+    delete lines;
+}
+
+
+void Serializer::compile_patch(Synth const& synth, Messages& messages) noexcept
+{
+    messages.clear();
+
+    for (int i = 0; i != Synth::ParamId::MAX_PARAM_ID; ++i) {
+        Synth::ParamId const param_id = (Synth::ParamId)i;
+
+        if (synth.is_toggle_param(param_id)) {
+            compile_param(synth, param_id, messages);
+        }
+    }
+
+    for (int i = 0; i != Synth::ParamId::MAX_PARAM_ID; ++i) {
+        Synth::ParamId const param_id = (Synth::ParamId)i;
+
+        if (!synth.is_toggle_param(param_id)) {
+            compile_param(synth, param_id, messages);
+        }
+    }
+}
+
+
+void Serializer::compile_param(
+        Synth const& synth,
+        Synth::ParamId const param_id,
+        Messages& messages
+) noexcept {
+    if (synth.get_param_name(param_id).length() == 0) {
+        return;
+    }
+
+    Synth::ControllerId const controller_id = (
+        synth.get_param_controller_id_atomic(param_id)
+    );
+
+    if (controller_id == Synth::ControllerId::NONE) {
+        Number const set_ratio = synth.get_param_ratio_atomic(param_id);
+        Number const default_ratio = synth.get_param_default_ratio(param_id);
+
+        if (std::fabs(default_ratio - set_ratio) > 0.000001) {
+            messages.push_back(
+                Synth::Message(
+                    Synth::MessageType::SET_PARAM, param_id, set_ratio, 0
+                )
+            );
+        }
+    } else {
+        messages.push_back(
+            Synth::Message(
+                Synth::MessageType::ASSIGN_CONTROLLER,
+                param_id,
+                0.0,
+                (Byte)controller_id
+            )
+        );
+    }
+}
+
+
 template<Serializer::Thread thread>
 void Serializer::import_patch(Synth& synth, std::string const& serialized) noexcept
 {
-    Lines* lines = parse_lines(serialized);
-    process_lines<thread>(synth, lines);
+    Messages messages;
 
-    delete lines;
+    /* A damaged binary patch is ignored instead of resetting the synth. */
+    if (compile_patch(synth, serialized, messages)) {
+        send_messages<thread>(synth, messages);
+    }
 }
 
 
@@ -268,16 +744,16 @@ bool Serializer::is_section_name_char(char const c) noexcept
 }
 
 
-template<Serializer::Thread thread>
-void Serializer::process_lines(Synth& synth, Lines* lines) noexcept
-{
-    typedef std::vector<Synth::Message> Messages;
-
-    Messages messages;
+void Serializer::process_lines(
+        Synth const& synth,
+        Lines* lines,
+        Messages& messages
+) noexcept {
+    Messages parsed_messages;
     char section_name[8];
     bool inside_js80p_section = false;
 
-    messages.reserve(800);
+    parsed_messages.reserve(800);
 
     for (Lines::const_iterator it = lines->begin(); it != lines->end(); ++it) {
         std::string line = *it;
@@ -290,10 +766,30 @@ void Serializer::process_lines(Synth& synth, Lines* lines) noexcept
                 continue;
             }
         } else if (inside_js80p_section) {
-            process_line(messages, synth, line);
+            process_line(parsed_messages, synth, line);
         }
     }
 
+    messages.clear();
+    messages.reserve(parsed_messages.size());
+
+    for (Messages::const_iterator it = parsed_messages.begin(); it != parsed_messages.end(); ++it) {
+        if (synth.is_toggle_param(it->param_id)) {
+            messages.push_back(*it);
+        }
+    }
+
+    for (Messages::const_iterator it = parsed_messages.begin(); it != parsed_messages.end(); ++it) {
+        if (!synth.is_toggle_param(it->param_id)) {
+            messages.push_back(*it);
+        }
+    }
+}
+
+
+template<Serializer::Thread thread>
+void Serializer::send_messages(Synth& synth, Messages const& messages) noexcept
+{
     send_message<thread>(
         synth,
         Synth::Message(
@@ -301,16 +797,12 @@ void Serializer::process_lines(Synth& synth, Lines* lines) noexcept
         )
     );
 
-    for (Messages::const_iterator it = messages.begin(); it != messages.end(); ++it) {
-        if (synth.is_toggle_param(it->param_id)) {
-            send_message<thread>(synth, *it);
-        }
-    }
-
-    for (Messages::const_iterator it = messages.begin(); it != messages.end(); ++it) {
-        if (!synth.is_toggle_param(it->param_id)) {
+    if constexpr (thread == Thread::AUDIO) {
+        for (Messages::const_iterator it = messages.begin(); it != messages.end(); ++it) {
             send_message<thread>(synth, *it);
         }
+    } else {
+        synth.push_messages(messages.data(), (Integer)messages.size());
     }
 }
 
@@ -395,8 +887,8 @@ bool Serializer::parse_line_until_value(
 
 
 void Serializer::process_line(
-        std::vector<Synth::Message>& messages,
-        Synth& synth,
+        Messages& messages,
+        Synth const& synth,
         std::string const& line
 ) noexcept {
     std::string::const_iterator it = line.begin();
@@ -19,6 +19,7 @@
 #ifndef JS80P__SERIALIZER_HPP
 #define JS80P__SERIALIZER_HPP
 
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -34,10 +35,66 @@ class Serializer
     public:
         static constexpr Integer MAX_SIZE = 256 * 1024;
 
+        /*
+        Binary layout (native byte order, which is little-endian on all
+        supported platforms):
+
+            BINARY_MAGIC            8 bytes
+            version                 uint32_t
+            param_count             uint32_t
+            param_names_hash        uint64_t
+            program_count           uint32_t
+            param names             param_count x (uint8_t length, chars)
+            programs                program_count x
+                name                    uint8_t length, chars
+                entry_count             uint32_t
+                entries                 entry_count x
+                    param index             uint16_t
+                    controller              uint8_t
+                    ratio                   double
+
+        Like compile_patch(), only those params are stored which are either
+        controlled, or set to a value other than their default, so a patch
+        is usually much smaller than param_count entries. The ratio of a
+        controlled param is not used.
+
+        Text patches never contain null bytes, and BINARY_MAGIC begins with
+        one, so anything that doesn't start with BINARY_MAGIC is treated as
+        a text patch (see serialize()).
+
+        The param names are used only when param_names_hash is different from
+        the current version's, e.g. after params were added or reordered.
+        */
+        static constexpr char BINARY_MAGIC[8] = {
+            '\x00', 'J', 'S', '8', '0', 'P', 'B', '\x00'
+        };
+        static constexpr uint32_t BINARY_VERSION = 2;
+        static constexpr size_t BINARY_HEADER_SIZE = (
+            sizeof(BINARY_MAGIC) + 3 * sizeof(uint32_t) + sizeof(uint64_t)
+        );
+        static constexpr size_t BINARY_ENTRY_SIZE = (
+            sizeof(uint16_t) + sizeof(uint8_t) + sizeof(double)
+        );
+
         static std::string const LINE_END;
 
         typedef std::vector<std::string> Lines;
 
+        /**
+         * \brief Messages which load a patch into a synth. Toggle params come
+         *        before other params.
+         */
+        typedef std::vector<Synth::Message> Messages;
+
+        class BinaryProgram
+        {
+            public:
+                std::string name;
+                Messages messages;
+        };
+
+        typedef std::vector<BinaryProgram> BinaryPrograms;
+
         static Lines* parse_lines(std::string const& serialized) noexcept;
 
         static bool parse_section_name(
@@ -60,6 +117,74 @@ class Serializer
 
         static std::string serialize(Synth const& synth) noexcept;
 
+        /**
+         * \brief Turn messages which were produced by compile_patch() back
+         *        into the same text that serialize() would have produced for
+         *        the synth state that they were compiled from, without
+         *        parsing.
+         */
+        static std::string serialize(
+            Synth const& synth,
+            Messages const& messages
+        ) noexcept;
+
+        /**
+         * \brief Serialize the synth into a binary patch with a single
+         *        unnamed program (see the binary layout above), which can be
+         *        loaded without text parsing. The import_patch_*() and
+         *        compile_patch() methods recognize both formats.
+         */
+        static std::string serialize_binary(Synth const& synth) noexcept;
+
+        /**
+         * \brief Serialize messages which were produced by compile_patch()
+         *        into a binary patch with a single program.
+         */
+        static std::string serialize_binary(
+            Synth const& synth,
+            std::string const& name,
+            Messages const& messages
+        ) noexcept;
+
+        /**
+         * \brief Start a binary patch or bank which will contain
+         *        \c program_count programs, to be appended one by one with
+         *        serialize_binary_program().
+         */
+        static void serialize_binary_header(
+            Synth const& synth,
+            uint32_t const program_count,
+            std::string& serialized
+        ) noexcept;
+
+        static void serialize_binary_program(
+            std::string const& name,
+            Messages const& messages,
+            std::string& serialized
+        ) noexcept;
+
+        static bool is_binary(std::string const& serialized) noexcept;
+
+        /**
+         * \brief Parse all the programs of a binary patch or bank. Returns
+         *        \c false if the data is truncated or has an unsupported
+         *        version.
+         */
+        static bool parse_binary(
+            Synth const& synth,
+            std::string const& serialized,
+            BinaryPrograms& programs
+        ) noexcept;
+
+        /**
+         * \brief Same as parse_binary(), but only the program names are
+         *        loaded, the messages are left empty.
+         */
+        static bool parse_binary_names(
+            std::string const& serialized,
+            BinaryPrograms& programs
+        ) noexcept;
+
         static void import_patch_in_gui_thread(
             Synth& synth,
             std::string const& serialized
@@ -70,6 +195,36 @@ class Serializer
             std::string const& serialized
         ) noexcept;
 
+        /**
+         * \brief Load a patch which has been compiled with compile_patch(),
+         *        without parsing or allocating memory.
+         */
+        static void import_patch_in_audio_thread(
+            Synth& synth,
+            Messages const& messages
+        ) noexcept;
+
+        /**
+         * \brief Parse a patch into messages in advance, so that it can be
+         *        imported in the audio thread quickly. Must not be called from
+         *        the audio thread. Binary patches yield their first program.
+         *        Returns \c false and leaves \c messages empty if the patch
+         *        is binary, but it is truncated or has an unsupported version.
+         */
+        static bool compile_patch(
+            Synth const& synth,
+            std::string const& serialized,
+            Messages& messages
+        ) noexcept;
+
+        /**
+         * \brief Produce the same messages that compiling the result of
+         *        serialize() would, but without serializing and parsing. Does
+         *        not allocate memory if the capacity of \c messages is at
+         *        least Synth::ParamId::MAX_PARAM_ID.
+         */
+        static void compile_patch(Synth const& synth, Messages& messages) noexcept;
+
         static void trim_excess_zeros_from_end_after_snprintf(
             char* number,
             int const length,
@@ -110,8 +265,52 @@ class Serializer
             std::string const& serialized
         ) noexcept;
 
+        static void serialize_line(
+            std::string& serialized,
+            std::string const& param_name,
+            char const* const suffix,
+            Number const value
+        ) noexcept;
+
+        static uint64_t hash_param_names(Synth const& synth) noexcept;
+
+        static bool parse_binary(
+            Synth const* const synth,
+            std::string const& serialized,
+            BinaryPrograms& programs
+        ) noexcept;
+
+        static bool parse_binary_program(
+            Synth const* const synth,
+            std::vector<Synth::ParamId> const& param_ids,
+            std::string const& serialized,
+            size_t& pos,
+            BinaryProgram& program
+        ) noexcept;
+
+        static void compile_text(
+            Synth const& synth,
+            std::string const& serialized,
+            Messages& messages
+        ) noexcept;
+
+        static void compile_param(
+            Synth const& synth,
+            Synth::ParamId const param_id,
+            Messages& messages
+        ) noexcept;
+
+        static void process_lines(
+            Synth const& synth,
+            Lines* lines,
+            Messages& messages
+        ) noexcept;
+
         template<Thread thread>
-        static void process_lines(Synth& synth, Lines* lines) noexcept;
+        static void send_messages(
+            Synth& synth,
+            Messages const& messages
+        ) noexcept;
 
         template<Thread thread>
         static void send_message(
@@ -128,8 +327,8 @@ class Serializer
         static bool is_comment_leader(char const c) noexcept;
 
         static void process_line(
-            std::vector<Synth::Message>& messages,
-            Synth& synth,
+            Messages& messages,
+            Synth const& synth,
             std::string const& line
         ) noexcept;
 
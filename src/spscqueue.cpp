@@ -29,18 +29,37 @@ namespace JS80P
 
 template<class ItemClass>
 SPSCQueue<ItemClass>::SPSCQueue(SizeType const capacity) noexcept
-    : capacity(capacity + 1),
+    : capacity(capacity),
+    mask(calculate_size(capacity) - 1),
     next_push(0),
-    next_pop(0)
+    cached_next_pop(0),
+    next_pop(0),
+    cached_next_push(0)
 {
-    items.reserve(this->capacity);
+    SizeType const size = mask + 1;
 
-    for (SizeType i = 0; i != this->capacity; ++i) {
+    items.reserve(size);
+
+    for (SizeType i = 0; i != size; ++i) {
         items.push_back(ItemClass());
     }
 }
 
 
+template<class ItemClass>
+typename SPSCQueue<ItemClass>::SizeType SPSCQueue<ItemClass>::calculate_size(
+        SizeType const capacity
+) noexcept {
+    SizeType size = 1;
+
+    while (size < capacity) {
+        size <<= 1;
+    }
+
+    return size;
+}
+
+
 template<class ItemClass>
 bool SPSCQueue<ItemClass>::is_empty() const noexcept
 {
@@ -51,14 +70,16 @@ bool SPSCQueue<ItemClass>::is_empty() const noexcept
 template<class ItemClass>
 typename SPSCQueue<ItemClass>::SizeType SPSCQueue<ItemClass>::length() const noexcept
 {
-    size_t const next_pop = this->next_pop.load();
-    size_t const next_push = this->next_push.load();
-
-    if (next_push < next_pop) {
-        return capacity + next_push - next_pop;
-    } else {
-        return next_push - next_pop;
-    }
+    SizeType const next_pop = this->next_pop.load(std::memory_order_acquire);
+    SizeType const next_push = this->next_push.load(std::memory_order_acquire);
+    SizeType const length = next_push - next_pop;
+
+    /*
+    If the other thread has moved both indices between the two loads, then the
+    difference may be larger than the number of items which were in the queue
+    at any given moment.
+    */
+    return length > capacity ? capacity : length;
 }
 
 
@@ -72,51 +93,103 @@ bool SPSCQueue<ItemClass>::is_lock_free() const noexcept
 template<class ItemClass>
 bool SPSCQueue<ItemClass>::push(ItemClass const& item) noexcept
 {
-    size_t const old_next_push = next_push.load();
-    size_t const next_pop = this->next_pop.load();
-    size_t const new_next_push = advance(old_next_push);
+    SizeType const next_push = this->next_push.load(std::memory_order_relaxed);
 
-    if (next_pop == new_next_push) {
-        return false;
+    if (next_push - cached_next_pop == capacity) {
+        cached_next_pop = next_pop.load(std::memory_order_acquire);
+
+        if (next_push - cached_next_pop == capacity) {
+            return false;
+        }
     }
 
-    items[old_next_push] = item;
-    next_push.store(new_next_push);
+    items[next_push & mask] = item;
+    this->next_push.store(next_push + 1, std::memory_order_release);
 
     return true;
 }
 
 
 template<class ItemClass>
-typename SPSCQueue<ItemClass>::SizeType SPSCQueue<ItemClass>::advance(
-        SizeType const index
-) const noexcept {
-    SizeType const new_index = index + 1;
+typename SPSCQueue<ItemClass>::SizeType SPSCQueue<ItemClass>::push_bulk(
+        ItemClass const* const items,
+        SizeType const count
+) noexcept {
+    SizeType const next_push = this->next_push.load(std::memory_order_relaxed);
+    SizeType free = capacity - (next_push - cached_next_pop);
+
+    if (free < count) {
+        cached_next_pop = next_pop.load(std::memory_order_acquire);
+        free = capacity - (next_push - cached_next_pop);
+    }
+
+    SizeType const pushed = free < count ? free : count;
+
+    for (SizeType i = 0; i != pushed; ++i) {
+        this->items[(next_push + i) & mask] = items[i];
+    }
 
-    return new_index >= capacity ? new_index - capacity : new_index;
+    if (pushed > 0) {
+        this->next_push.store(next_push + pushed, std::memory_order_release);
+    }
+
+    return pushed;
 }
 
 
 template<class ItemClass>
 bool SPSCQueue<ItemClass>::pop(ItemClass& item) noexcept
 {
-    size_t const next_pop = this->next_pop.load();
-    size_t const next_push = this->next_push.load();
+    SizeType const next_pop = this->next_pop.load(std::memory_order_relaxed);
 
-    if (next_push == next_pop) {
-        return false;
+    if (next_pop == cached_next_push) {
+        cached_next_push = next_push.load(std::memory_order_acquire);
+
+        if (next_pop == cached_next_push) {
+            return false;
+        }
     }
 
     ItemClass replacement;
 
-    std::swap(items[next_pop], replacement);
+    std::swap(items[next_pop & mask], replacement);
     item = std::move(replacement);
 
-    this->next_pop.store(advance(next_pop));
+    this->next_pop.store(next_pop + 1, std::memory_order_release);
 
     return true;
 }
 
+
+template<class ItemClass>
+typename SPSCQueue<ItemClass>::SizeType SPSCQueue<ItemClass>::pop_bulk(
+        ItemClass* const items,
+        SizeType const max_count
+) noexcept {
+    SizeType const next_pop = this->next_pop.load(std::memory_order_relaxed);
+    SizeType available = cached_next_push - next_pop;
+
+    if (available < max_count) {
+        cached_next_push = next_push.load(std::memory_order_acquire);
+        available = cached_next_push - next_pop;
+    }
+
+    SizeType const popped = available < max_count ? available : max_count;
+
+    for (SizeType i = 0; i != popped; ++i) {
+        ItemClass replacement;
+
+        std::swap(this->items[(next_pop + i) & mask], replacement);
+        items[i] = std::move(replacement);
+    }
+
+    if (popped > 0) {
+        this->next_pop.store(next_pop + popped, std::memory_order_release);
+    }
+
+    return popped;
+}
+
 }
 
 #endif
@@ -29,6 +29,9 @@ namespace JS80P
 /*
 See Timur Doumler [ACCU 2017]: Lock-free programming with modern C++
   https://www.youtube.com/watch?v=qdrp6k4rcP4
+
+See Erik Rigtorp: Optimizing a ring buffer for throughput
+  https://rigtorp.se/ringbuffer/
 */
 
 /**
@@ -51,15 +54,48 @@ class SPSCQueue
         bool push(ItemClass const& item) noexcept;
         bool pop(ItemClass& item) noexcept;
 
+        /**
+         * \brief Push as many of the given items as there is room for, and
+         *        publish them to the consumer at once.
+         *
+         * \return                  The number of items that were pushed.
+         */
+        SizeType push_bulk(
+            ItemClass const* const items,
+            SizeType const count
+        ) noexcept;
+
+        /**
+         * \brief Pop at most \c max_count items with a single synchronization
+         *        with the producer.
+         *
+         * \return                  The number of items that were popped.
+         */
+        SizeType pop_bulk(ItemClass* const items, SizeType const max_count) noexcept;
+
     private:
-        SizeType advance(SizeType const index) const noexcept;
+        /*
+        The indices are shared between the threads, so they are kept in
+        separate cache lines in order to avoid false sharing. Each thread also
+        keeps a cached copy of the other thread's index next to its own, so
+        that it needs to read the other index only when the queue seems to be
+        full or empty. The indices are never wrapped, only the positions
+        which they are masked into.
+        */
+        static constexpr SizeType CACHE_LINE_SIZE = 64;
+
+        static SizeType calculate_size(SizeType const capacity) noexcept;
 
         SizeType const capacity;
+        SizeType const mask;
 
         std::vector<ItemClass> items;
 
-        std::atomic<SizeType> next_push;
-        std::atomic<SizeType> next_pop;
+        alignas(CACHE_LINE_SIZE) std::atomic<SizeType> next_push;
+        SizeType cached_next_pop;
+
+        alignas(CACHE_LINE_SIZE) std::atomic<SizeType> next_pop;
+        SizeType cached_next_push;
 };
 
 }
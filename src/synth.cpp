@@ -17,6 +17,7 @@
  */
 
 #include <algorithm>
+#include <chrono>
 #include <cmath>
 #include <cstring>
 #include <limits>
@@ -109,15 +110,19 @@ Synth::Synth(Integer const samples_between_gc) noexcept
         POLYPHONY,
         modulator_add_volume
     ),
+    param_states_sequence(0),
+    published_tail_length(0.0),
     samples_since_gc(0),
     samples_between_gc(samples_between_gc),
     next_voice(0),
     next_note_id(0),
     previous_note(Midi::NOTE_MAX + 1),
+    is_wavetable_builder_running(false),
     is_learning(false),
     is_sustaining(false),
     is_polyphonic(true),
     was_polyphonic(true),
+    was_output_silent(false),
     is_dirty_(false),
     effects("E", bus),
     midi_controllers((MidiController* const*)midi_controllers_rw),
@@ -129,7 +134,12 @@ Synth::Synth(Integer const samples_between_gc) noexcept
 
     initialize_supported_midi_controllers();
 
-    for (int i = 0; i != 4; ++i) {
+    constexpr Integer biquad_filter_shared_caches_count = (
+        BIQUAD_FILTER_SHARED_CACHES_PER_EXECUTOR
+        * (MAX_VOICE_RENDERING_THREADS + 1)
+    );
+
+    for (Integer i = 0; i != biquad_filter_shared_caches_count; ++i) {
         biquad_filter_shared_caches[i] = new BiquadFilterSharedCache();
     }
 
@@ -139,6 +149,12 @@ Synth::Synth(Integer const samples_between_gc) noexcept
         param_names_by_id[i] = "";
     }
 
+    for (Integer i = 0; i != ParamStateChanges::WORDS; ++i) {
+        param_state_changes[i].store(0);
+        controlled_params[i] = 0;
+        settling_params[i] = ~(uint64_t)0;
+    }
+
     for (Midi::Note note = 0; note != Midi::NOTES; ++note) {
         /*
          * Not using Math::exp() and friends here, for 2 reasons:
@@ -478,15 +494,42 @@ void Synth::create_voices() noexcept
 }
 
 
+void Synth::assign_biquad_filter_shared_caches() noexcept
+{
+    Integer const executors = bus.get_workers() + 1;
+
+    for (Integer i = 0; i != POLYPHONY; ++i) {
+        Integer const first_cache = (
+            (i % executors) * BIQUAD_FILTER_SHARED_CACHES_PER_EXECUTOR
+        );
+
+        modulators[i]->set_filter_shared_caches(
+            biquad_filter_shared_caches[first_cache],
+            biquad_filter_shared_caches[first_cache + 1]
+        );
+        carriers[i]->set_filter_shared_caches(
+            biquad_filter_shared_caches[first_cache + 2],
+            biquad_filter_shared_caches[first_cache + 3]
+        );
+    }
+}
+
+
 void Synth::create_midi_controllers() noexcept
 {
     for (Integer i = 0; i != MIDI_CONTROLLERS; ++i) {
-        midi_controllers_rw[i] = (
-            is_supported_midi_controller((ControllerId)i)
-                ? new MidiController()
-                : NULL
-        );
+        if (is_supported_midi_controller((ControllerId)i)) {
+            midi_controllers_rw[i] = new MidiController();
+            midi_controllers_rw[i]->set_coalescing_tolerance(
+                MIDI_BYTE_COALESCING_TOLERANCE
+            );
+        } else {
+            midi_controllers_rw[i] = NULL;
+        }
     }
+
+    pitch_wheel.set_coalescing_tolerance(MIDI_WORD_COALESCING_TOLERANCE);
+    channel_pressure_ctl.set_coalescing_tolerance(MIDI_BYTE_COALESCING_TOLERANCE);
 }
 
 
@@ -611,11 +654,23 @@ void Synth::register_param(ParamId const param_id, ParamClass& param) noexcept
 
 Synth::~Synth()
 {
+    set_background_wavetable_building(false);
+    bus.set_workers(0);
+
     for (Integer i = 0; i != POLYPHONY; ++i) {
         delete carriers[i];
         delete modulators[i];
     }
 
+    constexpr Integer biquad_filter_shared_caches_count = (
+        BIQUAD_FILTER_SHARED_CACHES_PER_EXECUTOR
+        * (MAX_VOICE_RENDERING_THREADS + 1)
+    );
+
+    for (Integer i = 0; i != biquad_filter_shared_caches_count; ++i) {
+        delete biquad_filter_shared_caches[i];
+    }
+
     for (Integer i = 0; i != ENVELOPES; ++i) {
         delete envelopes[i];
     }
@@ -640,11 +695,21 @@ void Synth::reset() noexcept
 {
     SignalProducer::reset();
 
+    /*
+    Resetting leaves a cancel event in the queue of every parameter, so all
+    leaders need to be visited at least once more.
+    */
+    for (Integer i = 0; i != ParamStateChanges::WORDS; ++i) {
+        settling_params[i] = ~(uint64_t)0;
+    }
+
     osc_1_peak_tracker.reset();
     osc_2_peak_tracker.reset();
     vol_1_peak_tracker.reset();
     vol_2_peak_tracker.reset();
     vol_3_peak_tracker.reset();
+
+    was_output_silent = false;
 }
 
 
@@ -659,7 +724,16 @@ bool Synth::is_lock_free() const noexcept
         );
     }
 
-    return is_lock_free && messages.is_lock_free();
+    for (Integer i = 0; is_lock_free && i != ParamStateChanges::WORDS; ++i) {
+        is_lock_free = param_state_changes[i].is_lock_free();
+    }
+
+    return (
+        is_lock_free
+        && param_states_sequence.is_lock_free()
+        && published_tail_length.is_lock_free()
+        && messages.is_lock_free()
+    );
 }
 
 
@@ -686,6 +760,90 @@ void Synth::suspend() noexcept
 }
 
 
+void Synth::set_voice_rendering_threads(Integer const threads) noexcept
+{
+    Integer const new_threads = std::min(
+        MAX_VOICE_RENDERING_THREADS, std::max((Integer)0, threads)
+    );
+
+    if (new_threads == bus.get_workers()) {
+        return;
+    }
+
+    bus.set_workers(new_threads);
+    assign_biquad_filter_shared_caches();
+}
+
+
+Integer Synth::get_voice_rendering_threads() const noexcept
+{
+    return bus.get_workers();
+}
+
+
+Integer Synth::get_default_voice_rendering_threads() noexcept
+{
+    return std::min(
+        MAX_VOICE_RENDERING_THREADS,
+        (Integer)std::thread::hardware_concurrency() / 4
+    );
+}
+
+
+void Synth::set_voice_culling_window(Seconds const window) noexcept
+{
+    for (Integer v = 0; v != POLYPHONY; ++v) {
+        modulators[v]->set_culling_window(window);
+        carriers[v]->set_culling_window(window);
+    }
+}
+
+
+void Synth::set_background_wavetable_building(bool const is_enabled) noexcept
+{
+    if (is_enabled == wavetable_builder.joinable()) {
+        return;
+    }
+
+    if (is_enabled) {
+        modulator_params.custom_waveform.set_background_building(true);
+        carrier_params.custom_waveform.set_background_building(true);
+
+        is_wavetable_builder_running.store(true);
+        wavetable_builder = std::thread(&Synth::run_wavetable_builder, this);
+    } else {
+        is_wavetable_builder_running.store(false);
+        wavetable_builder.join();
+
+        modulator_params.custom_waveform.set_background_building(false);
+        carrier_params.custom_waveform.set_background_building(false);
+    }
+}
+
+
+void Synth::run_wavetable_builder() noexcept
+{
+    /*
+    Wavetable changes are not time critical, so polling at a slow pace is good
+    enough, and it doesn't steal CPU time from the audio and voice threads.
+    */
+    while (is_wavetable_builder_running.load()) {
+        modulator_params.custom_waveform.build();
+        carrier_params.custom_waveform.build();
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+}
+
+
+void Synth::get_voice_culling_statistics(
+        Integer& culled_voices,
+        Integer& culled_voice_blocks
+) const noexcept {
+    bus.get_culling_statistics(culled_voices, culled_voice_blocks);
+}
+
+
 void Synth::stop_lfos() noexcept
 {
     for (Integer i = 0; i != LFOS; ++i) {
@@ -1176,6 +1334,90 @@ void Synth::all_notes_off(
 }
 
 
+bool Synth::is_idle() const noexcept
+{
+    if (!was_output_silent || !events.is_empty() || !effects.is_tail_silent()) {
+        return false;
+    }
+
+    return !has_active_voices();
+}
+
+
+bool Synth::has_active_voices() const noexcept
+{
+    for (Integer v = 0; v != POLYPHONY; ++v) {
+        if (modulators[v]->is_on() || carriers[v]->is_on()) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+void Synth::update_custom_waveforms(Integer const round) noexcept
+{
+    if (modulator_params.waveform.get_value() == SimpleOscillator::CUSTOM) {
+        modulator_params.custom_waveform.update(round);
+    }
+
+    if (carrier_params.waveform.get_value() == SimpleOscillator::CUSTOM) {
+        carrier_params.custom_waveform.update(round);
+    }
+}
+
+
+bool Synth::has_unreleased_voices() const noexcept
+{
+    for (Integer v = 0; v != POLYPHONY; ++v) {
+        if (!modulators[v]->is_released() || !carriers[v]->is_released()) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+Seconds Synth::get_tail_length() const noexcept
+{
+    Seconds voices_tail_length = 0.0;
+
+    /*
+    Held notes may keep sounding for as long as the host keeps the plugin
+    running, so hosts must not suspend the plugin until they are released.
+    */
+    if (has_unreleased_voices()) {
+        return INFINITE_TAIL_LENGTH;
+    }
+
+    if (has_active_voices()) {
+        for (Integer i = 0; i != ENVELOPES; ++i) {
+            voices_tail_length = std::max(
+                voices_tail_length, envelopes_rw[i]->release_time.get_value()
+            );
+        }
+    } else if (was_output_silent && effects.is_tail_silent()) {
+        return 0.0;
+    }
+
+    return voices_tail_length + effects.get_tail_length();
+}
+
+
+Seconds Synth::get_published_tail_length() const noexcept
+{
+    return published_tail_length.load();
+}
+
+
+void Synth::publish_tail_length() noexcept
+{
+    published_tail_length.store(get_tail_length());
+}
+
+
 Sample const* const* Synth::generate_samples(
         Integer const round,
         Integer const sample_count
@@ -1202,6 +1444,14 @@ void Synth::push_message(Message const& message) noexcept
 }
 
 
+void Synth::push_messages(
+        Message const* const messages,
+        Integer const count
+) noexcept {
+    this->messages.push_bulk(messages, (SPSCQueue<Message>::SizeType)count);
+}
+
+
 std::string const& Synth::get_param_name(ParamId const param_id) const noexcept
 {
     return param_names_by_id[param_id];
@@ -1888,11 +2138,52 @@ Synth::ControllerId Synth::get_param_controller_id_atomic(
 }
 
 
+void Synth::get_param_state_atomic(
+        ParamId const param_id,
+        Number& ratio,
+        ControllerId& controller_id
+) const noexcept {
+    /*
+    Seqlock reader: the audio thread makes the sequence number odd while it is
+    updating the published states, so a read which overlaps with an update is
+    detected and retried. Updates are short and never block, so this spins
+    only rarely, and only in the reader.
+    */
+    Integer sequence;
+
+    do {
+        sequence = param_states_sequence.load(std::memory_order_acquire);
+        ratio = param_ratios[param_id].load(std::memory_order_relaxed);
+        controller_id = (ControllerId)controller_assignments[param_id].load(
+            std::memory_order_relaxed
+        );
+        std::atomic_thread_fence(std::memory_order_acquire);
+    } while (
+        (sequence & 1) != 0
+        || sequence != param_states_sequence.load(std::memory_order_relaxed)
+    );
+}
+
+
+void Synth::collect_param_state_changes(ParamStateChanges& changes) noexcept
+{
+    for (Integer i = 0; i != ParamStateChanges::WORDS; ++i) {
+        changes.words[i] = param_state_changes[i].exchange(
+            0, std::memory_order_acquire
+        );
+    }
+}
+
+
 void Synth::update_param_states() noexcept
 {
+    begin_param_states_update();
+
     for (int i = 0; i != ParamId::MAX_PARAM_ID; ++i) {
-        handle_refresh_param((ParamId)i);
+        publish_param_ratio((ParamId)i);
     }
+
+    end_param_states_update();
 }
 
 
@@ -1901,6 +2192,7 @@ Sample const* const* Synth::initialize_rendering(
         Integer const sample_count
 ) noexcept {
     process_messages();
+    publish_controlled_param_ratios();
 
     was_polyphonic = is_polyphonic;
     is_polyphonic = polyphonic.get_value() == ToggleParam::ON;
@@ -1916,129 +2208,48 @@ Sample const* const* Synth::initialize_rendering(
         samples_since_gc = 0;
     }
 
-    raw_output = SignalProducer::produce< Effects::Effects<Bus> >(
-        effects, round, sample_count
-    );
+    /*
+    Macros, envelopes, and parameter leaders are shared by all voices, so they
+    are brought up to date before the voices are rendered, possibly on
+    multiple threads. Voices will only read them: when a voice calls
+    Envelope::update() or Macro::update(), there will be nothing left to
+    update. (Even when the synth is idle, so that LFOs and controller
+    smoothing keep running the same way as if the synth was rendered.)
+
+    Envelope parameters may be controlled by macros, so macros go first.
+    Envelopes which are not dynamic are also updated, because voices update
+    them when an envelope is started.
+    */
+    for (Integer i = 0; i != MACROS; ++i) {
+        macros_rw[i]->update();
+    }
+
+    for (Integer i = 0; i != ENVELOPES; ++i) {
+        envelopes_rw[i]->update();
+    }
+
+    produce_dirty_leaders(round, sample_count);
+
+    update_custom_waveforms(round);
 
-    FloatParamS::produce_if_not_constant(modulator_add_volume, round, sample_count);
-
-    FloatParamS::produce_if_not_constant(phase_modulation_level, round, sample_count);
-    FloatParamS::produce_if_not_constant(frequency_modulation_level, round, sample_count);
-    FloatParamS::produce_if_not_constant(amplitude_modulation_level, round, sample_count);
-
-    FloatParamS::produce_if_not_constant(modulator_params.amplitude, round, sample_count);
-    FloatParamB::produce_if_not_constant(modulator_params.velocity_sensitivity, round, sample_count);
-    FloatParamS::produce_if_not_constant(modulator_params.folding, round, sample_count);
-    FloatParamB::produce_if_not_constant(modulator_params.portamento_length, round, sample_count);
-    FloatParamB::produce_if_not_constant(modulator_params.portamento_depth, round, sample_count);
-    FloatParamS::produce_if_not_constant(modulator_params.detune, round, sample_count);
-    FloatParamS::produce_if_not_constant(modulator_params.fine_detune, round, sample_count);
-    FloatParamB::produce_if_not_constant(modulator_params.width, round, sample_count);
-    FloatParamS::produce_if_not_constant(modulator_params.panning, round, sample_count);
-    FloatParamS::produce_if_not_constant(modulator_params.volume, round, sample_count);
-
-    FloatParamB::produce_if_not_constant(modulator_params.harmonic_0, round, sample_count);
-    FloatParamB::produce_if_not_constant(modulator_params.harmonic_1, round, sample_count);
-    FloatParamB::produce_if_not_constant(modulator_params.harmonic_2, round, sample_count);
-    FloatParamB::produce_if_not_constant(modulator_params.harmonic_3, round, sample_count);
-    FloatParamB::produce_if_not_constant(modulator_params.harmonic_4, round, sample_count);
-    FloatParamB::produce_if_not_constant(modulator_params.harmonic_5, round, sample_count);
-    FloatParamB::produce_if_not_constant(modulator_params.harmonic_6, round, sample_count);
-    FloatParamB::produce_if_not_constant(modulator_params.harmonic_7, round, sample_count);
-    FloatParamB::produce_if_not_constant(modulator_params.harmonic_8, round, sample_count);
-    FloatParamB::produce_if_not_constant(modulator_params.harmonic_9, round, sample_count);
-
-    FloatParamS::produce_if_not_constant(modulator_params.filter_1_frequency, round, sample_count);
-    FloatParamS::produce_if_not_constant(modulator_params.filter_1_q, round, sample_count);
-    FloatParamS::produce_if_not_constant(modulator_params.filter_1_gain, round, sample_count);
-
-    FloatParamS::produce_if_not_constant(modulator_params.filter_2_frequency, round, sample_count);
-    FloatParamS::produce_if_not_constant(modulator_params.filter_2_q, round, sample_count);
-    FloatParamS::produce_if_not_constant(modulator_params.filter_2_gain, round, sample_count);
-
-    FloatParamS::produce_if_not_constant(carrier_params.amplitude, round, sample_count);
-    FloatParamB::produce_if_not_constant(carrier_params.velocity_sensitivity, round, sample_count);
-    FloatParamS::produce_if_not_constant(carrier_params.folding, round, sample_count);
-    FloatParamB::produce_if_not_constant(carrier_params.portamento_length, round, sample_count);
-    FloatParamB::produce_if_not_constant(carrier_params.portamento_depth, round, sample_count);
-    FloatParamS::produce_if_not_constant(carrier_params.detune, round, sample_count);
-    FloatParamS::produce_if_not_constant(carrier_params.fine_detune, round, sample_count);
-    FloatParamB::produce_if_not_constant(carrier_params.width, round, sample_count);
-    FloatParamS::produce_if_not_constant(carrier_params.panning, round, sample_count);
-    FloatParamS::produce_if_not_constant(carrier_params.volume, round, sample_count);
-
-    FloatParamB::produce_if_not_constant(carrier_params.harmonic_0, round, sample_count);
-    FloatParamB::produce_if_not_constant(carrier_params.harmonic_1, round, sample_count);
-    FloatParamB::produce_if_not_constant(carrier_params.harmonic_2, round, sample_count);
-    FloatParamB::produce_if_not_constant(carrier_params.harmonic_3, round, sample_count);
-    FloatParamB::produce_if_not_constant(carrier_params.harmonic_4, round, sample_count);
-    FloatParamB::produce_if_not_constant(carrier_params.harmonic_5, round, sample_count);
-    FloatParamB::produce_if_not_constant(carrier_params.harmonic_6, round, sample_count);
-    FloatParamB::produce_if_not_constant(carrier_params.harmonic_7, round, sample_count);
-    FloatParamB::produce_if_not_constant(carrier_params.harmonic_8, round, sample_count);
-    FloatParamB::produce_if_not_constant(carrier_params.harmonic_9, round, sample_count);
-
-    FloatParamS::produce_if_not_constant(carrier_params.filter_1_frequency, round, sample_count);
-    FloatParamS::produce_if_not_constant(carrier_params.filter_1_q, round, sample_count);
-    FloatParamS::produce_if_not_constant(carrier_params.filter_1_gain, round, sample_count);
-
-    FloatParamS::produce_if_not_constant(carrier_params.filter_2_frequency, round, sample_count);
-    FloatParamS::produce_if_not_constant(carrier_params.filter_2_q, round, sample_count);
-    FloatParamS::produce_if_not_constant(carrier_params.filter_2_gain, round, sample_count);
-
-    FloatParamS::produce_if_not_constant(effects.volume_1_gain, round, sample_count);
-
-    FloatParamS::produce_if_not_constant(effects.overdrive.level, round, sample_count);
-
-    FloatParamS::produce_if_not_constant(effects.distortion.level, round, sample_count);
-
-    FloatParamS::produce_if_not_constant(effects.filter_1.frequency, round, sample_count);
-    FloatParamS::produce_if_not_constant(effects.filter_1.q, round, sample_count);
-    FloatParamS::produce_if_not_constant(effects.filter_1.gain, round, sample_count);
-
-    FloatParamS::produce_if_not_constant(effects.filter_2.frequency, round, sample_count);
-    FloatParamS::produce_if_not_constant(effects.filter_2.q, round, sample_count);
-    FloatParamS::produce_if_not_constant(effects.filter_2.gain, round, sample_count);
-
-    FloatParamS::produce_if_not_constant(effects.volume_2_gain, round, sample_count);
-
-    FloatParamS::produce_if_not_constant(effects.chorus.delay_time, round, sample_count);
-    FloatParamS::produce_if_not_constant(effects.chorus.frequency, round, sample_count);
-    FloatParamS::produce_if_not_constant(effects.chorus.depth, round, sample_count);
-    FloatParamS::produce_if_not_constant(effects.chorus.feedback, round, sample_count);
-    FloatParamS::produce_if_not_constant(effects.chorus.damping_frequency, round, sample_count);
-    FloatParamS::produce_if_not_constant(effects.chorus.damping_gain, round, sample_count);
-    FloatParamS::produce_if_not_constant(effects.chorus.width, round, sample_count);
-    FloatParamS::produce_if_not_constant(effects.chorus.high_pass_frequency, round, sample_count);
-    FloatParamS::produce_if_not_constant(effects.chorus.wet, round, sample_count);
-    FloatParamS::produce_if_not_constant(effects.chorus.dry, round, sample_count);
-
-    FloatParamS::produce_if_not_constant(effects.echo.delay_time, round, sample_count);
-    FloatParamS::produce_if_not_constant(effects.echo.feedback, round, sample_count);
-    FloatParamS::produce_if_not_constant(effects.echo.damping_frequency, round, sample_count);
-    FloatParamS::produce_if_not_constant(effects.echo.damping_gain, round, sample_count);
-    FloatParamS::produce_if_not_constant(effects.echo.width, round, sample_count);
-    FloatParamS::produce_if_not_constant(effects.echo.high_pass_frequency, round, sample_count);
-    FloatParamB::produce_if_not_constant(effects.echo.side_chain_compression_threshold, round, sample_count);
-    FloatParamB::produce_if_not_constant(effects.echo.side_chain_compression_attack_time, round, sample_count);
-    FloatParamB::produce_if_not_constant(effects.echo.side_chain_compression_release_time, round, sample_count);
-    FloatParamB::produce_if_not_constant(effects.echo.side_chain_compression_ratio, round, sample_count);
-    FloatParamS::produce_if_not_constant(effects.echo.wet, round, sample_count);
-    FloatParamS::produce_if_not_constant(effects.echo.dry, round, sample_count);
-
-    FloatParamS::produce_if_not_constant(effects.reverb.room_size, round, sample_count);
-    FloatParamS::produce_if_not_constant(effects.reverb.damping_frequency, round, sample_count);
-    FloatParamS::produce_if_not_constant(effects.reverb.damping_gain, round, sample_count);
-    FloatParamS::produce_if_not_constant(effects.reverb.width, round, sample_count);
-    FloatParamS::produce_if_not_constant(effects.reverb.high_pass_frequency, round, sample_count);
-    FloatParamB::produce_if_not_constant(effects.reverb.side_chain_compression_threshold, round, sample_count);
-    FloatParamB::produce_if_not_constant(effects.reverb.side_chain_compression_attack_time, round, sample_count);
-    FloatParamB::produce_if_not_constant(effects.reverb.side_chain_compression_release_time, round, sample_count);
-    FloatParamB::produce_if_not_constant(effects.reverb.side_chain_compression_ratio, round, sample_count);
-    FloatParamS::produce_if_not_constant(effects.reverb.wet, round, sample_count);
-    FloatParamS::produce_if_not_constant(effects.reverb.dry, round, sample_count);
-
-    FloatParamS::produce_if_not_constant(effects.volume_3_gain, round, sample_count);
+    Sample const* const* rendered_buffer = NULL;
+
+    if (is_idle()) {
+        /*
+        Nothing would be heard until a new note starts, so the voices and the
+        effects can be left alone.
+        */
+        render_silence(round, 0, sample_count, buffer);
+        mark_round_as_silent(round);
+        effects.chorus.produce_lfos(round, sample_count);
+        rendered_buffer = buffer;
+        publish_tail_length();
+    } else {
+        raw_output = SignalProducer::produce< Effects::Effects<Bus> >(
+            effects, round, sample_count
+        );
+        was_output_silent = effects.is_silent(round, sample_count);
+    }
 
     for (Integer i = 0; i != LFOS; ++i) {
         lfos_rw[i]->skip_round(round, sample_count);
@@ -2048,7 +2259,161 @@ Sample const* const* Synth::initialize_rendering(
 
     clear_midi_controllers();
 
-    return NULL;
+    return rendered_buffer;
+}
+
+
+/*
+Leaders which have no controller assigned to them only change when the GUI or
+the host sets them, and that doesn't involve events, so their buffers would
+never be rendered anyway. Only the controlled leaders, and the ones which have
+just lost their controller or have been reset, and may still have some events
+to process, need to be brought up to date.
+*/
+void Synth::produce_dirty_leaders(
+        Integer const round,
+        Integer const sample_count
+) noexcept {
+    for (Integer i = 0; i != ParamStateChanges::WORDS; ++i) {
+        uint64_t bits = controlled_params[i] | settling_params[i];
+
+        while (bits != 0) {
+            Integer const bit = (Integer)__builtin_ctzll(bits);
+            ParamId const param_id = (ParamId)((i << 6) + bit);
+
+            if (produce_dirty_leader(param_id, round, sample_count)) {
+                settling_params[i] &= ~((uint64_t)1 << bit);
+            }
+
+            bits &= bits - 1;
+        }
+    }
+}
+
+
+bool Synth::produce_dirty_leader(
+        ParamId const param_id,
+        Integer const round,
+        Integer const sample_count
+) noexcept {
+    switch (param_id) {
+        case ParamId::MIX: return produce_leader<FloatParamS>(modulator_add_volume, round, sample_count);
+        case ParamId::PM: return produce_leader<FloatParamS>(phase_modulation_level, round, sample_count);
+        case ParamId::FM: return produce_leader<FloatParamS>(frequency_modulation_level, round, sample_count);
+        case ParamId::AM: return produce_leader<FloatParamS>(amplitude_modulation_level, round, sample_count);
+        case ParamId::MAMP: return produce_leader<FloatParamS>(modulator_params.amplitude, round, sample_count);
+        case ParamId::MVS: return produce_leader<FloatParamB>(modulator_params.velocity_sensitivity, round, sample_count);
+        case ParamId::MFLD: return produce_leader<FloatParamS>(modulator_params.folding, round, sample_count);
+        case ParamId::MPRT: return produce_leader<FloatParamB>(modulator_params.portamento_length, round, sample_count);
+        case ParamId::MPRD: return produce_leader<FloatParamB>(modulator_params.portamento_depth, round, sample_count);
+        case ParamId::MDTN: return produce_leader<FloatParamS>(modulator_params.detune, round, sample_count);
+        case ParamId::MFIN: return produce_leader<FloatParamS>(modulator_params.fine_detune, round, sample_count);
+        case ParamId::MWID: return produce_leader<FloatParamB>(modulator_params.width, round, sample_count);
+        case ParamId::MPAN: return produce_leader<FloatParamS>(modulator_params.panning, round, sample_count);
+        case ParamId::MVOL: return produce_leader<FloatParamS>(modulator_params.volume, round, sample_count);
+        case ParamId::MC1: return produce_leader<FloatParamB>(modulator_params.harmonic_0, round, sample_count);
+        case ParamId::MC2: return produce_leader<FloatParamB>(modulator_params.harmonic_1, round, sample_count);
+        case ParamId::MC3: return produce_leader<FloatParamB>(modulator_params.harmonic_2, round, sample_count);
+        case ParamId::MC4: return produce_leader<FloatParamB>(modulator_params.harmonic_3, round, sample_count);
+        case ParamId::MC5: return produce_leader<FloatParamB>(modulator_params.harmonic_4, round, sample_count);
+        case ParamId::MC6: return produce_leader<FloatParamB>(modulator_params.harmonic_5, round, sample_count);
+        case ParamId::MC7: return produce_leader<FloatParamB>(modulator_params.harmonic_6, round, sample_count);
+        case ParamId::MC8: return produce_leader<FloatParamB>(modulator_params.harmonic_7, round, sample_count);
+        case ParamId::MC9: return produce_leader<FloatParamB>(modulator_params.harmonic_8, round, sample_count);
+        case ParamId::MC10: return produce_leader<FloatParamB>(modulator_params.harmonic_9, round, sample_count);
+        case ParamId::MF1FRQ: return produce_leader<FloatParamS>(modulator_params.filter_1_frequency, round, sample_count);
+        case ParamId::MF1Q: return produce_leader<FloatParamS>(modulator_params.filter_1_q, round, sample_count);
+        case ParamId::MF1G: return produce_leader<FloatParamS>(modulator_params.filter_1_gain, round, sample_count);
+        case ParamId::MF2FRQ: return produce_leader<FloatParamS>(modulator_params.filter_2_frequency, round, sample_count);
+        case ParamId::MF2Q: return produce_leader<FloatParamS>(modulator_params.filter_2_q, round, sample_count);
+        case ParamId::MF2G: return produce_leader<FloatParamS>(modulator_params.filter_2_gain, round, sample_count);
+        case ParamId::CAMP: return produce_leader<FloatParamS>(carrier_params.amplitude, round, sample_count);
+        case ParamId::CVS: return produce_leader<FloatParamB>(carrier_params.velocity_sensitivity, round, sample_count);
+        case ParamId::CFLD: return produce_leader<FloatParamS>(carrier_params.folding, round, sample_count);
+        case ParamId::CPRT: return produce_leader<FloatParamB>(carrier_params.portamento_length, round, sample_count);
+        case ParamId::CPRD: return produce_leader<FloatParamB>(carrier_params.portamento_depth, round, sample_count);
+        case ParamId::CDTN: return produce_leader<FloatParamS>(carrier_params.detune, round, sample_count);
+        case ParamId::CFIN: return produce_leader<FloatParamS>(carrier_params.fine_detune, round, sample_count);
+        case ParamId::CWID: return produce_leader<FloatParamB>(carrier_params.width, round, sample_count);
+        case ParamId::CPAN: return produce_leader<FloatParamS>(carrier_params.panning, round, sample_count);
+        case ParamId::CVOL: return produce_leader<FloatParamS>(carrier_params.volume, round, sample_count);
+        case ParamId::CC1: return produce_leader<FloatParamB>(carrier_params.harmonic_0, round, sample_count);
+        case ParamId::CC2: return produce_leader<FloatParamB>(carrier_params.harmonic_1, round, sample_count);
+        case ParamId::CC3: return produce_leader<FloatParamB>(carrier_params.harmonic_2, round, sample_count);
+        case ParamId::CC4: return produce_leader<FloatParamB>(carrier_params.harmonic_3, round, sample_count);
+        case ParamId::CC5: return produce_leader<FloatParamB>(carrier_params.harmonic_4, round, sample_count);
+        case ParamId::CC6: return produce_leader<FloatParamB>(carrier_params.harmonic_5, round, sample_count);
+        case ParamId::CC7: return produce_leader<FloatParamB>(carrier_params.harmonic_6, round, sample_count);
+        case ParamId::CC8: return produce_leader<FloatParamB>(carrier_params.harmonic_7, round, sample_count);
+        case ParamId::CC9: return produce_leader<FloatParamB>(carrier_params.harmonic_8, round, sample_count);
+        case ParamId::CC10: return produce_leader<FloatParamB>(carrier_params.harmonic_9, round, sample_count);
+        case ParamId::CF1FRQ: return produce_leader<FloatParamS>(carrier_params.filter_1_frequency, round, sample_count);
+        case ParamId::CF1Q: return produce_leader<FloatParamS>(carrier_params.filter_1_q, round, sample_count);
+        case ParamId::CF1G: return produce_leader<FloatParamS>(carrier_params.filter_1_gain, round, sample_count);
+        case ParamId::CF2FRQ: return produce_leader<FloatParamS>(carrier_params.filter_2_frequency, round, sample_count);
+        case ParamId::CF2Q: return produce_leader<FloatParamS>(carrier_params.filter_2_q, round, sample_count);
+        case ParamId::CF2G: return produce_leader<FloatParamS>(carrier_params.filter_2_gain, round, sample_count);
+        case ParamId::EV1V: return produce_leader<FloatParamS>(effects.volume_1_gain, round, sample_count);
+        case ParamId::EOG: return produce_leader<FloatParamS>(effects.overdrive.level, round, sample_count);
+        case ParamId::EDG: return produce_leader<FloatParamS>(effects.distortion.level, round, sample_count);
+        case ParamId::EF1FRQ: return produce_leader<FloatParamS>(effects.filter_1.frequency, round, sample_count);
+        case ParamId::EF1Q: return produce_leader<FloatParamS>(effects.filter_1.q, round, sample_count);
+        case ParamId::EF1G: return produce_leader<FloatParamS>(effects.filter_1.gain, round, sample_count);
+        case ParamId::EF2FRQ: return produce_leader<FloatParamS>(effects.filter_2.frequency, round, sample_count);
+        case ParamId::EF2Q: return produce_leader<FloatParamS>(effects.filter_2.q, round, sample_count);
+        case ParamId::EF2G: return produce_leader<FloatParamS>(effects.filter_2.gain, round, sample_count);
+        case ParamId::EV2V: return produce_leader<FloatParamS>(effects.volume_2_gain, round, sample_count);
+        case ParamId::ECDEL: return produce_leader<FloatParamS>(effects.chorus.delay_time, round, sample_count);
+        case ParamId::ECFRQ: return produce_leader<FloatParamS>(effects.chorus.frequency, round, sample_count);
+        case ParamId::ECDPT: return produce_leader<FloatParamS>(effects.chorus.depth, round, sample_count);
+        case ParamId::ECFB: return produce_leader<FloatParamS>(effects.chorus.feedback, round, sample_count);
+        case ParamId::ECDF: return produce_leader<FloatParamS>(effects.chorus.damping_frequency, round, sample_count);
+        case ParamId::ECDG: return produce_leader<FloatParamS>(effects.chorus.damping_gain, round, sample_count);
+        case ParamId::ECWID: return produce_leader<FloatParamS>(effects.chorus.width, round, sample_count);
+        case ParamId::ECHPF: return produce_leader<FloatParamS>(effects.chorus.high_pass_frequency, round, sample_count);
+        case ParamId::ECWET: return produce_leader<FloatParamS>(effects.chorus.wet, round, sample_count);
+        case ParamId::ECDRY: return produce_leader<FloatParamS>(effects.chorus.dry, round, sample_count);
+        case ParamId::EEDEL: return produce_leader<FloatParamS>(effects.echo.delay_time, round, sample_count);
+        case ParamId::EEFB: return produce_leader<FloatParamS>(effects.echo.feedback, round, sample_count);
+        case ParamId::EEDF: return produce_leader<FloatParamS>(effects.echo.damping_frequency, round, sample_count);
+        case ParamId::EEDG: return produce_leader<FloatParamS>(effects.echo.damping_gain, round, sample_count);
+        case ParamId::EEWID: return produce_leader<FloatParamS>(effects.echo.width, round, sample_count);
+        case ParamId::EEHPF: return produce_leader<FloatParamS>(effects.echo.high_pass_frequency, round, sample_count);
+        case ParamId::EECTH: return produce_leader<FloatParamB>(effects.echo.side_chain_compression_threshold, round, sample_count);
+        case ParamId::EECAT: return produce_leader<FloatParamB>(effects.echo.side_chain_compression_attack_time, round, sample_count);
+        case ParamId::EECRL: return produce_leader<FloatParamB>(effects.echo.side_chain_compression_release_time, round, sample_count);
+        case ParamId::EECR: return produce_leader<FloatParamB>(effects.echo.side_chain_compression_ratio, round, sample_count);
+        case ParamId::EEWET: return produce_leader<FloatParamS>(effects.echo.wet, round, sample_count);
+        case ParamId::EEDRY: return produce_leader<FloatParamS>(effects.echo.dry, round, sample_count);
+        case ParamId::ERRS: return produce_leader<FloatParamS>(effects.reverb.room_size, round, sample_count);
+        case ParamId::ERDF: return produce_leader<FloatParamS>(effects.reverb.damping_frequency, round, sample_count);
+        case ParamId::ERDG: return produce_leader<FloatParamS>(effects.reverb.damping_gain, round, sample_count);
+        case ParamId::ERWID: return produce_leader<FloatParamS>(effects.reverb.width, round, sample_count);
+        case ParamId::ERHPF: return produce_leader<FloatParamS>(effects.reverb.high_pass_frequency, round, sample_count);
+        case ParamId::ERCTH: return produce_leader<FloatParamB>(effects.reverb.side_chain_compression_threshold, round, sample_count);
+        case ParamId::ERCAT: return produce_leader<FloatParamB>(effects.reverb.side_chain_compression_attack_time, round, sample_count);
+        case ParamId::ERCRL: return produce_leader<FloatParamB>(effects.reverb.side_chain_compression_release_time, round, sample_count);
+        case ParamId::ERCR: return produce_leader<FloatParamB>(effects.reverb.side_chain_compression_ratio, round, sample_count);
+        case ParamId::ERWET: return produce_leader<FloatParamS>(effects.reverb.wet, round, sample_count);
+        case ParamId::ERDRY: return produce_leader<FloatParamS>(effects.reverb.dry, round, sample_count);
+        case ParamId::EV3V: return produce_leader<FloatParamS>(effects.volume_3_gain, round, sample_count);
+        default: return true;
+    }
+}
+
+
+template<class FloatParamClass>
+bool Synth::produce_leader(
+        FloatParamClass& leader,
+        Integer const round,
+        Integer const sample_count
+) noexcept {
+    FloatParamClass::produce_if_not_constant(leader, round, sample_count);
+
+    return (
+        !leader.has_events_after(0.0)
+        && leader.is_constant_until(sample_count)
+    );
 }
 
 
@@ -2130,14 +2495,27 @@ void Synth::garbage_collect_voices() noexcept
 
 void Synth::process_messages() noexcept
 {
-    SPSCQueue<Message>::SizeType const message_count = messages.length();
+    /*
+    Only the messages which are already in the queue are processed, so that a
+    busy producer cannot keep the audio thread here indefinitely.
+    */
+    Message batch[MESSAGE_BATCH_SIZE];
+    SPSCQueue<Message>::SizeType remaining = messages.length();
 
-    for (SPSCQueue<Message>::SizeType i = 0; i != message_count; ++i) {
-        Message message;
+    while (remaining > 0) {
+        SPSCQueue<Message>::SizeType const popped = messages.pop_bulk(
+            batch, std::min(remaining, MESSAGE_BATCH_SIZE)
+        );
 
-        if (messages.pop(message)) {
-            process_message(message);
+        if (popped == 0) {
+            break;
         }
+
+        for (SPSCQueue<Message>::SizeType i = 0; i != popped; ++i) {
+            process_message(batch[i]);
+        }
+
+        remaining -= popped;
     }
 }
 
@@ -2176,6 +2554,10 @@ void Synth::process_message(Message const& message) noexcept
             is_dirty_ = true;
             break;
 
+        case MessageType::SET_EVENT_GRID:
+            handle_set_event_grid(message.number_param);
+            break;
+
         default:
             break;
     }
@@ -2560,7 +2942,25 @@ void Synth::handle_assign_controller(
         return;
     }
 
-    controller_assignments[param_id].store(controller_id);
+    uint64_t const param_bit = (uint64_t)1 << (param_id & 63);
+
+    if ((ControllerId)controller_id == ControllerId::NONE) {
+        controlled_params[param_id >> 6] &= ~param_bit;
+        settling_params[param_id >> 6] |= param_bit;
+    } else {
+        controlled_params[param_id >> 6] |= param_bit;
+    }
+
+    std::atomic<Byte>& controller_assignment = controller_assignments[param_id];
+
+    begin_param_states_update();
+
+    if (controller_assignment.load(std::memory_order_relaxed) != controller_id) {
+        controller_assignment.store(controller_id, std::memory_order_relaxed);
+        mark_param_state_as_changed(param_id);
+    }
+
+    end_param_states_update();
 
     if ((ControllerId)controller_id == ControllerId::MIDI_LEARN) {
         is_learning = true;
@@ -2570,7 +2970,77 @@ void Synth::handle_assign_controller(
 
 void Synth::handle_refresh_param(ParamId const param_id) noexcept
 {
-    param_ratios[param_id].store(get_param_ratio(param_id));
+    begin_param_states_update();
+    publish_param_ratio(param_id);
+    end_param_states_update();
+}
+
+
+void Synth::begin_param_states_update() noexcept
+{
+    /* Only the audio thread writes the sequence number. */
+    Integer const sequence = (
+        param_states_sequence.load(std::memory_order_relaxed)
+    );
+
+    param_states_sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+}
+
+
+void Synth::end_param_states_update() noexcept
+{
+    Integer const sequence = (
+        param_states_sequence.load(std::memory_order_relaxed)
+    );
+
+    param_states_sequence.store(sequence + 1, std::memory_order_release);
+}
+
+
+void Synth::publish_param_ratio(ParamId const param_id) noexcept
+{
+    Number const ratio = get_param_ratio(param_id);
+
+    if (param_ratios[param_id].load(std::memory_order_relaxed) == ratio) {
+        return;
+    }
+
+    param_ratios[param_id].store(ratio, std::memory_order_relaxed);
+    mark_param_state_as_changed(param_id);
+}
+
+
+void Synth::publish_controlled_param_ratios() noexcept
+{
+    /*
+    Parameters which have a controller assigned to them may change in every
+    block without any message, so their ratios are published once per block,
+    so that the GUI can poll them without asking the audio thread to refresh
+    them.
+    */
+    begin_param_states_update();
+
+    for (Integer i = 0; i != ParamStateChanges::WORDS; ++i) {
+        uint64_t bits = controlled_params[i];
+
+        while (bits != 0) {
+            Integer const bit = (Integer)__builtin_ctzll(bits);
+
+            publish_param_ratio((ParamId)((i << 6) + bit));
+            bits &= bits - 1;
+        }
+    }
+
+    end_param_states_update();
+}
+
+
+void Synth::mark_param_state_as_changed(ParamId const param_id) noexcept
+{
+    param_state_changes[param_id >> 6].fetch_or(
+        (uint64_t)1 << (param_id & 63), std::memory_order_release
+    );
 }
 
 
@@ -2593,6 +3063,16 @@ void Synth::handle_clear() noexcept
 }
 
 
+void Synth::handle_set_event_grid(Number const grid) noexcept
+{
+    /*
+    Macro and envelope parameters are not children of the synth, but they are
+    only sampled via get_value() anyway, so they stay exact.
+    */
+    set_event_grid((Integer)std::round(grid));
+}
+
+
 bool Synth::assign_controller_to_discrete_param(
         ParamId const param_id,
         ControllerId const controller_id
@@ -3134,7 +3614,7 @@ void Synth::render(
             that happening to us, we are forcing digital clipping here at
             around 9 dB.
             */
-            out[i] = std::min(2.8, std::max(-2.8, raw[i]));
+            out[i] = std::min((Sample)2.8, std::max((Sample)-2.8, raw[i]));
         }
     }
 }
@@ -3152,32 +3632,38 @@ void Synth::finalize_rendering(
     if (osc_1_peak.is_assigned()) {
         bus.find_modulators_peak(sample_count, peak, peak_index);
         osc_1_peak_tracker.update(peak, peak_index, sample_count, sampling_period);
-        osc_1_peak.change(0.0, std::min(1.0, osc_1_peak_tracker.get_peak()));
+        osc_1_peak.change(0.0, std::min<Number>(1.0, osc_1_peak_tracker.get_peak()));
     }
 
     if (osc_2_peak.is_assigned()) {
         bus.find_carriers_peak(sample_count, peak, peak_index);
         osc_2_peak_tracker.update(peak, peak_index, sample_count, sampling_period);
-        osc_2_peak.change(0.0, std::min(1.0, osc_2_peak_tracker.get_peak()));
+        osc_2_peak.change(0.0, std::min<Number>(1.0, osc_2_peak_tracker.get_peak()));
     }
 
     if (vol_1_peak.is_assigned()) {
         effects.volume_1.find_input_peak(round, sample_count, peak, peak_index);
         vol_1_peak_tracker.update(peak, peak_index, sample_count, sampling_period);
-        vol_1_peak.change(0.0, std::min(1.0, vol_1_peak_tracker.get_peak()));
+        vol_1_peak.change(0.0, std::min<Number>(1.0, vol_1_peak_tracker.get_peak()));
     }
 
     if (vol_2_peak.is_assigned()) {
         effects.volume_2.find_input_peak(round, sample_count, peak, peak_index);
         vol_2_peak_tracker.update(peak, peak_index, sample_count, sampling_period);
-        vol_2_peak.change(0.0, std::min(1.0, vol_2_peak_tracker.get_peak()));
+        vol_2_peak.change(0.0, std::min<Number>(1.0, vol_2_peak_tracker.get_peak()));
     }
 
     if (vol_3_peak.is_assigned()) {
         effects.volume_3.find_input_peak(round, sample_count, peak, peak_index);
         vol_3_peak_tracker.update(peak, peak_index, sample_count, sampling_period);
-        vol_3_peak.change(0.0, std::min(1.0, vol_3_peak_tracker.get_peak()));
+        vol_3_peak.change(0.0, std::min<Number>(1.0, vol_3_peak_tracker.get_peak()));
     }
+
+    publish_tail_length();
+
+#ifdef JS80P_PROFILING
+    Profiler::flush();
+#endif
 }
 
 
@@ -3214,6 +3700,31 @@ Synth::Message::Message(
 }
 
 
+Synth::ParamStateChanges::ParamStateChanges() noexcept
+{
+    std::fill_n(words, WORDS, 0);
+}
+
+
+bool Synth::ParamStateChanges::is_empty() const noexcept
+{
+    for (Integer i = 0; i != WORDS; ++i) {
+        if (words[i] != 0) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+bool Synth::ParamStateChanges::is_changed(
+        ParamId const param_id
+) const noexcept {
+    return (words[param_id >> 6] & ((uint64_t)1 << (param_id & 63))) != 0;
+}
+
+
 Synth::Bus::Bus(
         Integer const channels,
         Modulator* const* const modulators,
@@ -3229,22 +3740,71 @@ Synth::Bus::Bus(
     modulators_buffer(NULL),
     carriers_buffer(NULL),
     modulators_on(POLYPHONY),
-    carriers_on(POLYPHONY)
+    carriers_on(POLYPHONY),
+    workers_count(0),
+    executors(1),
+    culled_voices(0),
+    culled_voice_blocks(0)
 {
+    for (Integer i = 0; i != MAX_VOICE_RENDERING_THREADS; ++i) {
+        workers[i] = NULL;
+    }
+
     allocate_buffers();
 }
 
 
 Synth::Bus::~Bus()
 {
+    stop_workers();
     free_buffers();
 }
 
 
+void Synth::Bus::set_workers(Integer const count) noexcept
+{
+    stop_workers();
+    start_workers(count);
+}
+
+
+Integer Synth::Bus::get_workers() const noexcept
+{
+    return workers_count;
+}
+
+
+void Synth::Bus::start_workers(Integer const count) noexcept
+{
+    workers_count = count;
+    executors = count + 1;
+
+    for (Integer i = 0; i != workers_count; ++i) {
+        workers[i] = new Worker(*this, i + 1);
+    }
+}
+
+
+void Synth::Bus::stop_workers() noexcept
+{
+    for (Integer i = 0; i != workers_count; ++i) {
+        delete workers[i];
+        workers[i] = NULL;
+    }
+
+    workers_count = 0;
+    executors = 1;
+}
+
+
 void Synth::Bus::allocate_buffers() noexcept
 {
     modulators_buffer = allocate_buffer();
     carriers_buffer = allocate_buffer();
+
+    for (Integer i = 0; i != MAX_VOICE_RENDERING_THREADS + 1; ++i) {
+        filter_banks[i].set_block_size(block_size);
+    }
 }
 
 
@@ -3283,6 +3843,15 @@ void Synth::Bus::find_carriers_peak(
 }
 
 
+void Synth::Bus::get_culling_statistics(
+        Integer& culled_voices,
+        Integer& culled_voice_blocks
+) const noexcept {
+    culled_voices = this->culled_voices.load(std::memory_order_relaxed);
+    culled_voice_blocks = this->culled_voice_blocks.load(std::memory_order_relaxed);
+}
+
+
 void Synth::Bus::reallocate_buffers() noexcept
 {
     free_buffers();
@@ -3298,20 +3867,19 @@ Sample const* const* Synth::Bus::initialize_rendering(
 
     for (Integer v = 0; v != polyphony; ++v) {
         modulators_on[v] = modulators[v]->is_on();
-
-        if (modulators_on[v]) {
-            is_silent = false;
-            SignalProducer::produce<Modulator>(*modulators[v], round, sample_count);
-        }
-
         carriers_on[v] = carriers[v]->is_on();
 
-        if (carriers_on[v]) {
+        if (modulators_on[v] || carriers_on[v]) {
             is_silent = false;
-            SignalProducer::produce<Carrier>(*carriers[v], round, sample_count);
         }
     }
 
+    if (!is_silent) {
+        render_voices(round, sample_count);
+        cull_voices<Modulator>(modulators, modulators_on, sample_count);
+        cull_voices<Carrier>(carriers, carriers_on, sample_count);
+    }
+
     modulator_add_volume_buffer = FloatParamS::produce_if_not_constant(
         modulator_add_volume, round, sample_count
     );
@@ -3330,6 +3898,112 @@ Sample const* const* Synth::Bus::initialize_rendering(
 }
 
 
+void Synth::Bus::render_voices(
+        Integer const round,
+        Integer const sample_count
+) noexcept {
+    for (Integer i = 0; i != workers_count; ++i) {
+        workers[i]->post(round, sample_count);
+    }
+
+    render_voices(0, round, sample_count);
+
+    for (Integer i = 0; i != workers_count; ++i) {
+        workers[i]->finish();
+    }
+}
+
+
+void Synth::Bus::render_voices(
+        Integer const executor,
+        Integer const round,
+        Integer const sample_count
+) noexcept {
+    /*
+    A carrier produces its modulator when it needs the modulation signal, so
+    a modulator and its carrier must always be rendered by the same executor.
+    */
+    produce_filters<Modulator>(
+        modulators, modulators_on, executor, round, sample_count
+    );
+    produce_filters<Carrier>(
+        carriers, carriers_on, executor, round, sample_count
+    );
+
+    for (Integer v = executor; v < polyphony; v += executors) {
+        if (modulators_on[v]) {
+            SignalProducer::produce<Modulator>(*modulators[v], round, sample_count);
+        }
+
+        if (carriers_on[v]) {
+            SignalProducer::produce<Carrier>(*carriers[v], round, sample_count);
+        }
+    }
+}
+
+
+template<class VoiceClass>
+void Synth::Bus::produce_filters(
+        VoiceClass* const* const voices,
+        std::vector<bool> const& voices_on,
+        Integer const executor,
+        Integer const round,
+        Integer const sample_count
+) noexcept {
+    /*
+    The filters are rendered side by side before the rest of the voices, and
+    the voices will find them in the cache. The filters of modulators must be
+    done before the carriers, since a carrier pulls its modulator when
+    rendering its oscillator.
+    */
+    BiquadFilterBank& filter_bank = filter_banks[executor];
+
+    for (Integer v = executor; v < polyphony; v += executors) {
+        if (voices_on[v]) {
+            voices[v]->produce_filter_1(filter_bank, round, sample_count);
+        }
+    }
+
+    filter_bank.flush();
+
+    for (Integer v = executor; v < polyphony; v += executors) {
+        if (voices_on[v]) {
+            voices[v]->produce_filter_2(filter_bank, round, sample_count);
+        }
+    }
+
+    filter_bank.flush();
+}
+
+
+template<class VoiceClass>
+void Synth::Bus::cull_voices(
+        VoiceClass* const* const voices,
+        std::vector<bool>& voices_on,
+        Integer const sample_count
+) noexcept {
+    /*
+    The voice has already rendered this round, but since it was silent, it can
+    be left out from the mix as well.
+    */
+    for (Integer v = 0; v != polyphony; ++v) {
+        if (!voices_on[v] || !voices[v]->has_decayed_during_release()) {
+            continue;
+        }
+
+        Seconds const skipped_time = voices[v]->cull();
+
+        voices_on[v] = false;
+
+        culled_voices.fetch_add(1, std::memory_order_relaxed);
+        culled_voice_blocks.fetch_add(
+            (Integer)std::ceil(skipped_time * sample_rate / (Number)sample_count),
+            std::memory_order_relaxed
+        );
+    }
+}
+
+
 void Synth::Bus::render(
         Integer const round,
         Integer const first_sample_index,
@@ -3445,6 +4119,111 @@ void Synth::Bus::mix_carriers(
 }
 
 
+Synth::Bus::Worker::Worker(Bus& bus, Integer const executor) noexcept
+    : bus(bus),
+    executor(executor),
+    round(0),
+    sample_count(0),
+    job(0),
+    posted_job(0),
+    claimed_job(0),
+    finished_job(0),
+    is_running(true),
+    thread(&Worker::run, this)
+{
+}
+
+
+Synth::Bus::Worker::~Worker()
+{
+    is_running.store(false);
+    posted_job.store(job + 1, std::memory_order_release);
+    thread.join();
+}
+
+
+void Synth::Bus::Worker::post(
+        Integer const round,
+        Integer const sample_count
+) noexcept {
+    this->round = round;
+    this->sample_count = sample_count;
+
+    ++job;
+
+    posted_job.store(job, std::memory_order_release);
+}
+
+
+void Synth::Bus::Worker::finish() noexcept
+{
+    if (claim(job)) {
+        bus.render_voices(executor, round, sample_count);
+
+        return;
+    }
+
+    while (finished_job.load(std::memory_order_acquire) != job) {
+    }
+}
+
+
+bool Synth::Bus::Worker::claim(unsigned int const job) noexcept
+{
+    unsigned int expected = job - 1;
+
+    return claimed_job.compare_exchange_strong(
+        expected, job, std::memory_order_acq_rel
+    );
+}
+
+
+void Synth::Bus::Worker::run() noexcept
+{
+    ScopedFlushToZero const flush_to_zero;
+
+    unsigned int last_job = 0;
+    Integer idle_iterations = 0;
+
+    while (true) {
+        unsigned int const next_job = posted_job.load(std::memory_order_acquire);
+
+        if (next_job == last_job) {
+            ++idle_iterations;
+
+            if (idle_iterations < SPINS_BEFORE_YIELDING) {
+                continue;
+            }
+
+            if (idle_iterations < SPINS_BEFORE_YIELDING + YIELDS_BEFORE_SLEEPING) {
+                std::this_thread::yield();
+            } else {
+                std::this_thread::sleep_for(std::chrono::microseconds(100));
+            }
+
+            continue;
+        }
+
+        if (!is_running.load()) {
+            break;
+        }
+
+        idle_iterations = 0;
+        last_job = next_job;
+
+        if (claim(next_job)) {
+            bus.render_voices(executor, round, sample_count);
+
+#ifdef JS80P_PROFILING
+            Profiler::flush();
+#endif
+
+            finished_job.store(next_job, std::memory_order_release);
+        }
+    }
+}
+
+
 Synth::ParamIdHashTable::ParamIdHashTable() noexcept
 {
 }
@@ -20,7 +20,9 @@
 #define JS80P__SYNTH_HPP
 
 #include <atomic>
+#include <limits>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "js80p.hpp"
@@ -67,6 +69,8 @@ class Synth : public Midi::EventHandler, public SignalProducer
     private:
         static constexpr Integer NEXT_VOICE_MASK = 0x3f;
 
+        static constexpr Integer BIQUAD_FILTER_SHARED_CACHES_PER_EXECUTOR = 4;
+
     public:
         typedef Voice<SignalProducer> Modulator;
         typedef Voice<Modulator::ModulationOut> Carrier;
@@ -75,6 +79,8 @@ class Synth : public Midi::EventHandler, public SignalProducer
 
         static constexpr Integer OUT_CHANNELS = Carrier::CHANNELS;
 
+        static constexpr Integer MAX_VOICE_RENDERING_THREADS = 7;
+
         static constexpr Integer ENVELOPES = 6;
         static constexpr Integer ENVELOPE_FLOAT_PARAMS = 10;
 
@@ -86,6 +92,14 @@ class Synth : public Midi::EventHandler, public SignalProducer
         static constexpr Integer LFOS = 8;
         static constexpr Integer LFO_FLOAT_PARAMS = 7;
 
+        /**
+         * \brief Tail length reported while there are notes which have not
+         *        been released yet.
+         */
+        static constexpr Seconds INFINITE_TAIL_LENGTH = (
+            std::numeric_limits<Seconds>::max()
+        );
+
         enum MessageType {
             SET_PARAM = 1,          ///< Set the given parameter's ratio to
                                     ///< \c number_param.
@@ -95,12 +109,20 @@ class Synth : public Midi::EventHandler, public SignalProducer
 
             REFRESH_PARAM = 3,      ///< Make sure that \c get_param_ratio_atomic()
                                     ///< will return the most recent value of
-                                    ///< the given parameter.
+                                    ///< the given parameter. (Not needed for
+                                    ///< polling, since the audio thread
+                                    ///< publishes parameter states on its
+                                    ///< own.)
 
             CLEAR = 4,              ///< Clear all buffers, release all
                                     ///< controller assignments, and reset all
                                     ///< parameters to their default values.
 
+            SET_EVENT_GRID = 5,     ///< Let parameters postpone the start of
+                                    ///< ramps to every \c number_param th
+                                    ///< sample of a block (see
+                                    ///< \c SignalProducer::set_event_grid()).
+
             INVALID,
         };
 
@@ -728,6 +750,26 @@ class Synth : public Midi::EventHandler, public SignalProducer
                 Byte byte_param;
         };
 
+        /**
+         * \brief Set of parameters whose published ratio or controller
+         *        assignment has changed, see
+         *        \c Synth::collect_param_state_changes().
+         */
+        class ParamStateChanges
+        {
+            public:
+                static constexpr Integer WORDS = (
+                    ((Integer)ParamId::MAX_PARAM_ID + 63) / 64
+                );
+
+                ParamStateChanges() noexcept;
+
+                bool is_empty() const noexcept;
+                bool is_changed(ParamId const param_id) const noexcept;
+
+                uint64_t words[WORDS];
+        };
+
         class ModeParam : public Param<Mode, ParamEvaluation::BLOCK>
         {
             public:
@@ -756,6 +798,89 @@ class Synth : public Midi::EventHandler, public SignalProducer
         void suspend() noexcept;
         void resume() noexcept;
 
+        /**
+         * \brief Render voices on \c threads additional worker threads
+         *        besides the audio thread. (Use \c 0 to render everything on
+         *        the audio thread.)
+         *
+         * \note The voices are distributed among the threads in a fixed way,
+         *       and each thread has its own filter coefficient caches, so the
+         *       output is the same regardless of the number of threads.
+         *
+         * \warning This method is not real-time safe (it starts and stops
+         *          threads), and it must not be called while rendering is in
+         *          progress.
+         */
+        void set_voice_rendering_threads(Integer const threads) noexcept;
+        Integer get_voice_rendering_threads() const noexcept;
+
+        /**
+         * \brief Number of voice rendering threads for a plugin instance: a
+         *        quarter of the CPU cores, so that most of them are left to
+         *        the host and to other plugin instances.
+         */
+        static Integer get_default_voice_rendering_threads() noexcept;
+
+        /**
+         * \brief Stop released voices as soon as their output stays below
+         *        \c SignalProducer::SILENCE_THRESHOLD for \c window seconds,
+         *        instead of rendering their inaudible tails until the next
+         *        garbage collection.
+         *
+         * \warning This method must not be called while rendering is in
+         *          progress.
+         */
+        void set_voice_culling_window(Seconds const window) noexcept;
+
+        /**
+         * \brief Rebuild the wavetables of custom waveforms on a background
+         *        thread instead of the audio thread. A new wavetable is used
+         *        from the first round after it's ready, so the exact timing of
+         *        a waveform change is not deterministic.
+         *
+         * \warning This method must not be called while rendering is in
+         *          progress.
+         */
+        void set_background_wavetable_building(bool const is_enabled) noexcept;
+
+        /**
+         * \brief Get the number of culled voices, and the number of
+         *        voice-blocks (voice renderings of block size samples) which
+         *        were skipped due to culling since the synth was created.
+         */
+        void get_voice_culling_statistics(
+            Integer& culled_voices,
+            Integer& culled_voice_blocks
+        ) const noexcept;
+
+        /**
+         * \brief Tell whether the synth would keep producing silence if no
+         *        more events arrived: no voices are on, the last rendered
+         *        block was silent, and the delay lines of the effects are
+         *        drained. Voices and effects are not rendered while idle.
+         */
+        bool is_idle() const noexcept;
+
+        /**
+         * \brief Estimate how long the synth may keep producing sound if no
+         *        more events arrived, based on the release times of the
+         *        envelopes if there are active voices, and on the feedback
+         *        settings of the echo and the reverb unless their delay lines
+         *        are drained. Returns 0.0 when the synth is idle, and
+         *        \c INFINITE_TAIL_LENGTH while there are voices which have not
+         *        been released yet.
+         *
+         * \warning Not thread-safe, use \c get_published_tail_length() outside
+         *          the audio thread.
+         */
+        Seconds get_tail_length() const noexcept;
+
+        /**
+         * \brief Thread-safe way to retrieve the value of \c get_tail_length()
+         *        as of the end of the last rendered block.
+         */
+        Seconds get_published_tail_length() const noexcept;
+
         Sample const* const* generate_samples(
             Integer const round, Integer const sample_count
         ) noexcept;
@@ -777,6 +902,15 @@ class Synth : public Midi::EventHandler, public SignalProducer
          */
         void push_message(Message const& message) noexcept;
 
+        /**
+         * \brief Thread-safe way to change the state of the synthesizer outside
+         *        the audio thread, sending multiple messages at once.
+         */
+        void push_messages(
+            Message const* const messages,
+            Integer const count
+        ) noexcept;
+
         void process_messages() noexcept;
 
         /**
@@ -823,6 +957,28 @@ class Synth : public Midi::EventHandler, public SignalProducer
             ParamId const param_id
         ) const noexcept;
 
+        /**
+         * \brief Read the ratio and the controller assignment of a parameter
+         *        as they were published together by the audio thread, without
+         *        sending any messages to it.
+         */
+        void get_param_state_atomic(
+            ParamId const param_id,
+            Number& ratio,
+            ControllerId& controller_id
+        ) const noexcept;
+
+        /**
+         * \brief Move the set of parameters whose published state has
+         *        changed since the previous call into \c changes.
+         *
+         * \warning Only a single thread (normally the GUI) may collect the
+         *          changes.
+         */
+        void collect_param_state_changes(
+            ParamStateChanges& changes
+        ) noexcept;
+
         void note_off(
             Seconds const time_offset,
             Midi::Channel const channel,
@@ -920,6 +1076,52 @@ class Synth : public Midi::EventHandler, public SignalProducer
         {
             friend class SignalProducer;
 
+            private:
+                /**
+                 * \brief A thread which renders every voice whose index is
+                 *        congruent to \c executor modulo the number of
+                 *        executors. (The audio thread is executor \c 0.)
+                 *
+                 * \note Jobs are claimed with a compare-and-swap, so when the
+                 *       audio thread runs out of work while a worker is still
+                 *       idle, then it can take over that worker's job instead
+                 *       of waiting for it to wake up.
+                 */
+                class Worker
+                {
+                    public:
+                        Worker(Bus& bus, Integer const executor) noexcept;
+                        ~Worker();
+
+                        void post(
+                            Integer const round,
+                            Integer const sample_count
+                        ) noexcept;
+
+                        void finish() noexcept;
+
+                    private:
+                        static constexpr Integer SPINS_BEFORE_YIELDING = 4096;
+                        static constexpr Integer YIELDS_BEFORE_SLEEPING = 256;
+
+                        void run() noexcept;
+                        bool claim(unsigned int const job) noexcept;
+
+                        Bus& bus;
+                        Integer const executor;
+
+                        Integer round;
+                        Integer sample_count;
+                        unsigned int job;
+
+                        alignas(64) std::atomic<unsigned int> posted_job;
+                        alignas(64) std::atomic<unsigned int> claimed_job;
+                        alignas(64) std::atomic<unsigned int> finished_job;
+                        std::atomic<bool> is_running;
+
+                        std::thread thread;
+                };
+
             public:
                 Bus(
                     Integer const channels,
@@ -935,6 +1137,9 @@ class Synth : public Midi::EventHandler, public SignalProducer
                     Integer const new_block_size
                 ) noexcept override;
 
+                void set_workers(Integer const count) noexcept;
+                Integer get_workers() const noexcept;
+
                 void find_modulators_peak(
                     Integer const sample_count,
                     Sample& peak,
@@ -947,6 +1152,11 @@ class Synth : public Midi::EventHandler, public SignalProducer
                     Integer& peak_index
                 ) noexcept;
 
+                void get_culling_statistics(
+                    Integer& culled_voices,
+                    Integer& culled_voice_blocks
+                ) const noexcept;
+
             protected:
                 Sample const* const* initialize_rendering(
                     Integer const round,
@@ -986,6 +1196,36 @@ class Synth : public Midi::EventHandler, public SignalProducer
                     Integer const last_sample_index
                 ) const noexcept;
 
+                void render_voices(
+                    Integer const round,
+                    Integer const sample_count
+                ) noexcept;
+
+                void render_voices(
+                    Integer const executor,
+                    Integer const round,
+                    Integer const sample_count
+                ) noexcept;
+
+                template<class VoiceClass>
+                void produce_filters(
+                    VoiceClass* const* const voices,
+                    std::vector<bool> const& voices_on,
+                    Integer const executor,
+                    Integer const round,
+                    Integer const sample_count
+                ) noexcept;
+
+                template<class VoiceClass>
+                void cull_voices(
+                    VoiceClass* const* const voices,
+                    std::vector<bool>& voices_on,
+                    Integer const sample_count
+                ) noexcept;
+
+                void start_workers(Integer const count) noexcept;
+                void stop_workers() noexcept;
+
                 Integer const polyphony;
                 Synth::Modulator* const* const modulators;
                 Synth::Carrier* const* const carriers;
@@ -995,6 +1235,12 @@ class Synth : public Midi::EventHandler, public SignalProducer
                 Sample** carriers_buffer;
                 std::vector<bool> modulators_on;
                 std::vector<bool> carriers_on;
+                Worker* workers[MAX_VOICE_RENDERING_THREADS];
+                BiquadFilterBank filter_banks[MAX_VOICE_RENDERING_THREADS + 1];
+                Integer workers_count;
+                Integer executors;
+                std::atomic<Integer> culled_voices;
+                std::atomic<Integer> culled_voice_blocks;
         };
 
         class ParamIdHashTable
@@ -1097,10 +1343,19 @@ class Synth : public Midi::EventHandler, public SignalProducer
         };
 
         static constexpr SPSCQueue<Message>::SizeType MESSAGE_QUEUE_SIZE = 8192;
+        static constexpr SPSCQueue<Message>::SizeType MESSAGE_BATCH_SIZE = 64;
 
         static constexpr Number MIDI_WORD_SCALE = 1.0 / 16384.0;
         static constexpr Number MIDI_BYTE_SCALE = 1.0 / 127.0;
 
+        /*
+        Dense automation (e.g. a ramp drawn in the host) is coalesced into
+        linear segments which stay within half a step of the resolution of the
+        MIDI messages that carry it.
+        */
+        static constexpr Number MIDI_WORD_COALESCING_TOLERANCE = MIDI_WORD_SCALE * 0.5;
+        static constexpr Number MIDI_BYTE_COALESCING_TOLERANCE = MIDI_BYTE_SCALE * 0.5;
+
         static constexpr Integer INVALID_VOICE = -1;
 
         static constexpr Integer NOTE_ID_MASK = 0x7fffffff;
@@ -1117,6 +1372,7 @@ class Synth : public Midi::EventHandler, public SignalProducer
         void register_carrier_params() noexcept;
         void register_effects_params() noexcept;
         void create_voices() noexcept;
+        void assign_biquad_filter_shared_caches() noexcept;
         void create_midi_controllers() noexcept;
         void create_macros() noexcept;
         void create_envelopes() noexcept;
@@ -1159,8 +1415,16 @@ class Synth : public Midi::EventHandler, public SignalProducer
 
         void handle_refresh_param(ParamId const param_id) noexcept;
 
+        void begin_param_states_update() noexcept;
+        void end_param_states_update() noexcept;
+        void publish_param_ratio(ParamId const param_id) noexcept;
+        void publish_controlled_param_ratios() noexcept;
+        void mark_param_state_as_changed(ParamId const param_id) noexcept;
+
         void handle_clear() noexcept;
 
+        void handle_set_event_grid(Number const grid) noexcept;
+
         bool assign_controller_to_discrete_param(
             ParamId const param_id,
             ControllerId const controller_id
@@ -1219,11 +1483,36 @@ class Synth : public Midi::EventHandler, public SignalProducer
             Midi::Note const note
         ) noexcept;
 
+        void produce_dirty_leaders(
+            Integer const round,
+            Integer const sample_count
+        ) noexcept;
+
+        bool produce_dirty_leader(
+            ParamId const param_id,
+            Integer const round,
+            Integer const sample_count
+        ) noexcept;
+
+        template<class FloatParamClass>
+        bool produce_leader(
+            FloatParamClass& leader,
+            Integer const round,
+            Integer const sample_count
+        ) noexcept;
+
         void stop_polyphonic_notes() noexcept;
 
         void update_param_states() noexcept;
 
         void garbage_collect_voices() noexcept;
+        bool has_active_voices() const noexcept;
+        bool has_unreleased_voices() const noexcept;
+
+        void publish_tail_length() noexcept;
+
+        void update_custom_waveforms(Integer const round) noexcept;
+        void run_wavetable_builder() noexcept;
 
         std::string const to_string(Integer const) const noexcept;
 
@@ -1239,9 +1528,17 @@ class Synth : public Midi::EventHandler, public SignalProducer
 
         Sample const* const* raw_output;
         MidiControllerMessage previous_controller_message[ControllerId::MAX_CONTROLLER_ID];
-        BiquadFilterSharedCache* biquad_filter_shared_caches[4];
+        BiquadFilterSharedCache* biquad_filter_shared_caches[
+            BIQUAD_FILTER_SHARED_CACHES_PER_EXECUTOR
+            * (MAX_VOICE_RENDERING_THREADS + 1)
+        ];
         std::atomic<Number> param_ratios[ParamId::MAX_PARAM_ID];
         std::atomic<Byte> controller_assignments[ParamId::MAX_PARAM_ID];
+        std::atomic<uint64_t> param_state_changes[ParamStateChanges::WORDS];
+        std::atomic<Integer> param_states_sequence;
+        std::atomic<Seconds> published_tail_length;
+        uint64_t controlled_params[ParamStateChanges::WORDS];
+        uint64_t settling_params[ParamStateChanges::WORDS];
         Envelope* envelopes_rw[ENVELOPES];
         LFO* lfos_rw[LFOS];
         Macro* macros_rw[MACROS];
@@ -1254,10 +1551,13 @@ class Synth : public Midi::EventHandler, public SignalProducer
         Integer next_voice;
         Integer next_note_id;
         Midi::Note previous_note;
+        std::atomic<bool> is_wavetable_builder_running;
+        std::thread wavetable_builder;
         bool is_learning;
         bool is_sustaining;
         bool is_polyphonic;
         bool was_polyphonic;
+        bool was_output_silent;
         bool is_dirty_;
 
     public:
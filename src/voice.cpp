@@ -19,6 +19,9 @@
 #ifndef JS80P__VOICE_CPP
 #define JS80P__VOICE_CPP
 
+#include <algorithm>
+#include <cmath>
+
 #include "dsp/math.hpp"
 
 #include "voice.hpp"
@@ -68,6 +71,19 @@ Voice<ModulatorSignalProducerClass>::Params::Params(std::string const name) noex
     harmonic_8(name + "C9", -1.0, 1.0, 0.0),
     harmonic_9(name + "C10", -1.0, 1.0, 0.0),
 
+    custom_waveform(
+        harmonic_0,
+        harmonic_1,
+        harmonic_2,
+        harmonic_3,
+        harmonic_4,
+        harmonic_5,
+        harmonic_6,
+        harmonic_7,
+        harmonic_8,
+        harmonic_9
+    ),
+
     filter_1_type(name + "F1TYP"),
     filter_1_log_scale(name + "F1LOG", ToggleParam::OFF),
     filter_1_frequency(
@@ -251,7 +267,8 @@ Voice<ModulatorSignalProducerClass>::Voice(
         modulator,
         amplitude_modulation_level_leader,
         frequency_modulation_level_leader,
-        phase_modulation_level_leader
+        phase_modulation_level_leader,
+        &param_leaders.custom_waveform
     ),
     filter_1(
         oscillator,
@@ -279,6 +296,8 @@ Voice<ModulatorSignalProducerClass>::Voice(
     volume(param_leaders.volume),
     volume_applier(filter_2, note_velocity, volume),
     frequencies(frequencies),
+    culling_window(DEFAULT_CULLING_WINDOW),
+    silent_release_time(0.0),
     state(OFF),
     note_id(0),
     note(0),
@@ -306,6 +325,7 @@ void Voice<ModulatorSignalProducerClass>::reset() noexcept
 {
     SignalProducer::reset();
 
+    silent_release_time = 0.0;
     state = OFF;
     note_id = 0;
     note = 0;
@@ -313,6 +333,16 @@ void Voice<ModulatorSignalProducerClass>::reset() noexcept
 }
 
 
+template<class ModulatorSignalProducerClass>
+void Voice<ModulatorSignalProducerClass>::set_filter_shared_caches(
+        BiquadFilterSharedCache* filter_1_shared_cache,
+        BiquadFilterSharedCache* filter_2_shared_cache
+) noexcept {
+    filter_1.set_shared_cache(filter_1_shared_cache);
+    filter_2.set_shared_cache(filter_2_shared_cache);
+}
+
+
 template<class ModulatorSignalProducerClass>
 bool Voice<ModulatorSignalProducerClass>::is_on() const noexcept
 {
@@ -680,6 +710,65 @@ bool Voice<ModulatorSignalProducerClass>::has_decayed_during_envelope_dahds() co
 }
 
 
+template<class ModulatorSignalProducerClass>
+void Voice<ModulatorSignalProducerClass>::set_culling_window(
+        Seconds const window
+) noexcept {
+    culling_window = window;
+}
+
+
+template<class ModulatorSignalProducerClass>
+bool Voice<ModulatorSignalProducerClass>::has_decayed_during_release() const noexcept
+{
+    return (
+        culling_window > 0.0
+        && silent_release_time >= culling_window
+        && state == OFF
+        && (
+            is_releasing_to_silence(volume)
+            || is_releasing_to_silence(oscillator.amplitude)
+        )
+    );
+}
+
+
+template<class ModulatorSignalProducerClass>
+Seconds Voice<ModulatorSignalProducerClass>::cull() noexcept
+{
+    Seconds const remaining_release_time = (
+        oscillator.get_last_event_time_offset()
+    );
+
+    silent_release_time = 0.0;
+
+    oscillator.cancel_events();
+    oscillator.stop(0.0);
+
+    return std::max(0.0, remaining_release_time);
+}
+
+
+template<class ModulatorSignalProducerClass>
+void Voice<ModulatorSignalProducerClass>::produce_filter_1(
+        BiquadFilterBank& filter_bank,
+        Integer const round,
+        Integer const sample_count
+) noexcept {
+    filter_bank.produce<Oscillator_>(filter_1, round, sample_count);
+}
+
+
+template<class ModulatorSignalProducerClass>
+void Voice<ModulatorSignalProducerClass>::produce_filter_2(
+        BiquadFilterBank& filter_bank,
+        Integer const round,
+        Integer const sample_count
+) noexcept {
+    filter_bank.produce<Wavefolder_>(filter_2, round, sample_count);
+}
+
+
 template<class ModulatorSignalProducerClass>
 bool Voice<ModulatorSignalProducerClass>::has_decayed(
         FloatParamS const& param
@@ -694,12 +783,72 @@ bool Voice<ModulatorSignalProducerClass>::has_decayed(
 
     return (
         !param.has_events_after(0.0)
+        && !param.is_rendering_envelope_dahds()
         && param.get_value() < threshold
         && envelope->final_value.get_value() < threshold
     );
 }
 
 
+template<class ModulatorSignalProducerClass>
+bool Voice<ModulatorSignalProducerClass>::is_releasing_to_silence(
+        FloatParamS const& param
+) const noexcept {
+    constexpr Number threshold = 0.000001;
+
+    Envelope* envelope = param.get_envelope();
+
+    if (envelope == NULL) {
+        return false;
+    }
+
+    /*
+    The note-off may be scheduled for the future, so the state of the voice is
+    not enough to tell if the release has already begun.
+    */
+    return (
+        param.is_envelope_releasing()
+        && envelope->final_value.get_value() < threshold
+    );
+}
+
+
+template<class ModulatorSignalProducerClass>
+void Voice<ModulatorSignalProducerClass>::finalize_rendering(
+        Integer const round,
+        Integer const sample_count
+) noexcept {
+    if (
+            state != OFF
+            || !(
+                is_releasing_to_silence(volume)
+                || is_releasing_to_silence(oscillator.amplitude)
+            )
+    ) {
+        silent_release_time = 0.0;
+
+        return;
+    }
+
+    /*
+    The modulation output of the voice is the same signal as its output before
+    panning, so a silent voice is safe to cull even if it's a modulator.
+    */
+    Sample const* const volume_applier_buffer = this->volume_applier_buffer;
+    Sample peak = 0.0;
+
+    for (Integer i = 0; i != sample_count; ++i) {
+        peak = std::max(peak, std::fabs(volume_applier_buffer[i]));
+    }
+
+    if (peak < (Sample)SILENCE_THRESHOLD) {
+        silent_release_time += (Seconds)sample_count * sampling_period;
+    } else {
+        silent_release_time = 0.0;
+    }
+}
+
+
 template<class ModulatorSignalProducerClass>
 Integer Voice<ModulatorSignalProducerClass>::get_note_id() const noexcept
 {
@@ -812,7 +961,7 @@ void Voice<ModulatorSignalProducerClass>::render(
     } else {
         for (Integer i = first_sample_index; i != last_sample_index; ++i) {
             Number const panning = std::min(
-                1.0, std::max(panning_buffer[i] + note_panning_buffer[i], -1.0)
+                1.0, std::max<Number>(panning_buffer[i] + note_panning_buffer[i], -1.0)
             );
             Number const x = (panning + 1.0) * Math::PI_QUARTER;
 
@@ -83,6 +83,8 @@ class Voice : public SignalProducer
                 FloatParamB harmonic_8;
                 FloatParamB harmonic_9;
 
+                CustomWaveform custom_waveform;
+
                 typename Filter1::TypeParam filter_1_type;
                 ToggleParam filter_1_log_scale;
                 FloatParamS filter_1_frequency;
@@ -132,6 +134,11 @@ class Voice : public SignalProducer
 
         static constexpr Integer CHANNELS = 2;
 
+        /**
+         * \brief Culling is disabled by default, see set_culling_window().
+         */
+        static constexpr Seconds DEFAULT_CULLING_WINDOW = 0.0;
+
         Voice(
             Frequency const* frequencies,
             Midi::Note const notes,
@@ -146,6 +153,11 @@ class Voice : public SignalProducer
 
         virtual void reset() noexcept override;
 
+        void set_filter_shared_caches(
+            BiquadFilterSharedCache* filter_1_shared_cache,
+            BiquadFilterSharedCache* filter_2_shared_cache
+        ) noexcept;
+
         bool is_on() const noexcept;
         bool is_off_after(Seconds const time_offset) const noexcept;
         bool is_released() const noexcept;
@@ -190,6 +202,54 @@ class Voice : public SignalProducer
 
         bool has_decayed_during_envelope_dahds() const noexcept;
 
+        /**
+         * \brief Set how long the output of a released voice needs to stay
+         *        below \c SignalProducer::SILENCE_THRESHOLD before the voice
+         *        may be culled. Zero disables culling.
+         */
+        void set_culling_window(Seconds const window) noexcept;
+
+        /**
+         * \brief Tell whether the release stage of an amplitude or volume
+         *        envelope which ends in silence has already begun, and the
+         *        output of the voice has been below
+         *        \c SignalProducer::SILENCE_THRESHOLD for at least the
+         *        culling window since then.
+         */
+        bool has_decayed_during_release() const noexcept;
+
+        /**
+         * \brief Stop a released voice immediately.
+         *
+         * \return                  The remaining duration of the release
+         *                          which is skipped.
+         */
+        Seconds cull() noexcept;
+
+        /**
+         * \brief Let the given bank render the first filter of the voice
+         *        together with other voices' filters.
+         */
+        void produce_filter_1(
+            BiquadFilterBank& filter_bank,
+            Integer const round,
+            Integer const sample_count
+        ) noexcept;
+
+        /**
+         * \brief Let the given bank render the second filter of the voice
+         *        together with other voices' filters.
+         *
+         * \warning The bank must be flushed after \c produce_filter_1() was
+         *          called on it, because the second filter depends on the
+         *          output of the first one.
+         */
+        void produce_filter_2(
+            BiquadFilterBank& filter_bank,
+            Integer const round,
+            Integer const sample_count
+        ) noexcept;
+
         Integer get_note_id() const noexcept;
         Midi::Note get_note() const noexcept;
         Midi::Channel get_channel() const noexcept;
@@ -207,6 +267,11 @@ class Voice : public SignalProducer
             Sample** buffer
         ) noexcept;
 
+        void finalize_rendering(
+            Integer const round,
+            Integer const sample_count
+        ) noexcept;
+
     private:
         static constexpr Number NOTE_PANNING_SCALE = 2.0 / (Number)Midi::NOTE_MAX;
 
@@ -228,6 +293,7 @@ class Voice : public SignalProducer
         ) noexcept;
 
         bool has_decayed(FloatParamS const& param) const noexcept;
+        bool is_releasing_to_silence(FloatParamS const& param) const noexcept;
 
         Midi::Note const notes;
 
@@ -250,6 +316,8 @@ class Voice : public SignalProducer
         Frequency const* frequencies;
         Number panning_value;
         Number note_panning_value;
+        Seconds culling_window;
+        Seconds silent_release_time;
         State state;
         Integer note_id;
         Midi::Note note;
@@ -0,0 +1,374 @@
+/*
+ * This file is part of JS80P, a synthesizer plugin.
+ * Copyright (C) 2023  Attila M. Magyar
+ *
+ * JS80P is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * JS80P is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/*
+Render every built-in program with various block sizes, sample rates, numbers
+of simultaneous notes and polyphonic/monophonic mode, and print the results
+as tab separated values. Only the generate_samples() calls are timed. E.g.:
+
+    ./build/x86_64-gpp-avx/bench --block-sizes=128,1024 --sample-rates=48000
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "js80p.hpp"
+#include "midi.hpp"
+
+#include "bank.cpp"
+#include "serializer.cpp"
+#include "synth.cpp"
+
+
+using namespace JS80P;
+
+
+typedef std::vector<Integer> Integers;
+typedef std::vector<Number> Numbers;
+
+
+class Options
+{
+    public:
+        Options()
+            : programs(),
+            block_sizes({32, 128, 512, 1024, 4096}),
+            sample_rates({44100.0, 48000.0, 96000.0, 192000.0}),
+            polyphony({1, 8, 32}),
+            modes({ToggleParam::ON, ToggleParam::OFF}),
+            length(2.0)
+        {
+        }
+
+        Integers programs;
+        Integers block_sizes;
+        Numbers sample_rates;
+        Integers polyphony;
+        Integers modes;
+        Seconds length;
+};
+
+
+class Result
+{
+    public:
+        Integer samples;
+        Number elapsed_seconds;
+        Number samples_per_second;
+        Number realtime_factor;
+        Number p50_us;
+        Number p99_us;
+        Number max_us;
+};
+
+
+constexpr Midi::Note NOTES[] = {
+    Midi::NOTE_C_2, Midi::NOTE_G_2, Midi::NOTE_C_3, Midi::NOTE_E_3,
+    Midi::NOTE_G_3, Midi::NOTE_B_FLAT_3, Midi::NOTE_C_4, Midi::NOTE_D_4,
+    Midi::NOTE_E_4, Midi::NOTE_G_4, Midi::NOTE_B_FLAT_4, Midi::NOTE_C_5,
+    Midi::NOTE_D_5, Midi::NOTE_E_5, Midi::NOTE_G_5, Midi::NOTE_C_6,
+};
+
+constexpr Integer NUMBER_OF_NOTES = (Integer)(sizeof(NOTES) / sizeof(NOTES[0]));
+
+constexpr Number NOTE_OFF_AT = 0.75;
+
+
+void usage(char const* const name)
+{
+    fprintf(stderr, "Usage: %s [options]\n", name);
+    fprintf(stderr, "\n");
+    fprintf(stderr, "    --programs=N,...        programs to render (default: all non-blank)\n");
+    fprintf(stderr, "    --block-sizes=N,...     default: 32,128,512,1024,4096\n");
+    fprintf(stderr, "    --sample-rates=N,...    default: 44100,48000,96000,192000\n");
+    fprintf(stderr, "    --polyphony=N,...       simultaneous notes, default: 1,8,32\n");
+    fprintf(stderr, "    --modes=MODE,...        poly and/or mono, default: poly,mono\n");
+    fprintf(stderr, "    --length=SECONDS        rendered length per case, default: 2.0\n");
+}
+
+
+bool starts_with(char const* const arg, char const* const prefix, char const*& value)
+{
+    size_t const length = strlen(prefix);
+
+    if (strncmp(arg, prefix, length) != 0) {
+        return false;
+    }
+
+    value = &arg[length];
+
+    return true;
+}
+
+
+template<typename NumberType>
+bool parse_list(char const* value, std::vector<NumberType>& list)
+{
+    list.clear();
+
+    while (*value != '\x00') {
+        char* end = NULL;
+        Number const number = strtod(value, &end);
+
+        if (end == value || number <= 0.0) {
+            return false;
+        }
+
+        list.push_back((NumberType)number);
+        value = *end == ',' ? end + 1 : end;
+    }
+
+    return !list.empty();
+}
+
+
+bool parse_modes(char const* value, Integers& modes)
+{
+    std::string const list(value);
+    std::string::size_type start = 0;
+
+    modes.clear();
+
+    while (start <= list.length()) {
+        std::string::size_type end = list.find(',', start);
+
+        if (end == std::string::npos) {
+            end = list.length();
+        }
+
+        std::string const mode = list.substr(start, end - start);
+
+        if (mode == "poly") {
+            modes.push_back(ToggleParam::ON);
+        } else if (mode == "mono") {
+            modes.push_back(ToggleParam::OFF);
+        } else {
+            return false;
+        }
+
+        start = end + 1;
+    }
+
+    return !modes.empty();
+}
+
+
+bool parse_options(int const argc, char const* const* const argv, Options& options)
+{
+    for (int i = 1; i != argc; ++i) {
+        char const* const arg = argv[i];
+        char const* value;
+        bool is_valid;
+
+        if (starts_with(arg, "--programs=", value)) {
+            is_valid = parse_list<Integer>(value, options.programs);
+
+            if (is_valid && std::any_of(
+                    options.programs.begin(),
+                    options.programs.end(),
+                    [](Integer const p) { return p >= (Integer)Bank::NUMBER_OF_PROGRAMS; }
+            )) {
+                is_valid = false;
+            }
+        } else if (starts_with(arg, "--block-sizes=", value)) {
+            is_valid = parse_list<Integer>(value, options.block_sizes);
+        } else if (starts_with(arg, "--sample-rates=", value)) {
+            is_valid = parse_list<Number>(value, options.sample_rates);
+        } else if (starts_with(arg, "--polyphony=", value)) {
+            is_valid = parse_list<Integer>(value, options.polyphony);
+        } else if (starts_with(arg, "--modes=", value)) {
+            is_valid = parse_modes(value, options.modes);
+        } else if (starts_with(arg, "--length=", value)) {
+            options.length = strtod(value, NULL);
+            is_valid = options.length > 0.0;
+        } else {
+            is_valid = false;
+        }
+
+        if (!is_valid) {
+            fprintf(stderr, "ERROR: invalid argument: \"%s\"\n\n", arg);
+
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+Number percentile(Numbers const& sorted, Number const p)
+{
+    Integer const size = (Integer)sorted.size();
+    Integer const index = (Integer)std::ceil(p * (Number)size) - 1;
+
+    return sorted[std::min(size - 1, std::max((Integer)0, index))];
+}
+
+
+void run_case(
+        Bank::Program const& program,
+        Integer const block_size,
+        Frequency const sample_rate,
+        Integer const polyphony,
+        Integer const mode,
+        Seconds const length,
+        Numbers& block_times,
+        Result& result
+) {
+    Synth* const synth = new Synth();
+    Integer const rounds = (Integer)std::ceil(length * sample_rate / (Number)block_size);
+    Seconds const note_off_at = length * NOTE_OFF_AT;
+
+    Serializer::import_patch_in_audio_thread(*synth, program.serialize());
+
+    synth->suspend();
+    synth->set_block_size(block_size);
+    synth->set_sample_rate(sample_rate);
+    synth->resume();
+    synth->process_message(
+        Synth::MessageType::SET_PARAM,
+        Synth::ParamId::POLY,
+        synth->polyphonic.value_to_ratio(mode),
+        0
+    );
+
+    for (Integer i = 0; i != polyphony; ++i) {
+        Midi::Channel const channel = (Midi::Channel)(i / NUMBER_OF_NOTES);
+        Midi::Note const note = NOTES[i % NUMBER_OF_NOTES];
+
+        synth->note_on(0.0, channel, note, 100);
+        synth->note_off(note_off_at, channel, note, 64);
+    }
+
+    block_times.clear();
+    block_times.reserve((Numbers::size_type)rounds);
+
+    std::chrono::steady_clock::time_point const start = (
+        std::chrono::steady_clock::now()
+    );
+    std::chrono::steady_clock::time_point block_start = start;
+
+    for (Integer round = 0; round != rounds; ++round) {
+        synth->generate_samples(round, block_size);
+
+        std::chrono::steady_clock::time_point const block_end = (
+            std::chrono::steady_clock::now()
+        );
+        std::chrono::duration<double, std::micro> const block_time = (
+            block_end - block_start
+        );
+
+        block_times.push_back(block_time.count());
+        block_start = block_end;
+    }
+
+    std::chrono::duration<double> const elapsed = block_start - start;
+
+    delete synth;
+
+    std::sort(block_times.begin(), block_times.end());
+
+    result.samples = rounds * block_size;
+    result.elapsed_seconds = elapsed.count();
+    result.samples_per_second = (Number)result.samples / result.elapsed_seconds;
+    result.realtime_factor = result.samples_per_second / sample_rate;
+    result.p50_us = percentile(block_times, 0.50);
+    result.p99_us = percentile(block_times, 0.99);
+    result.max_us = block_times.back();
+}
+
+
+int main(int const argc, char const* const* const argv)
+{
+    Options options;
+
+    if (!parse_options(argc, argv, options)) {
+        usage(argv[0]);
+
+        return 1;
+    }
+
+    Bank bank;
+    Numbers block_times;
+    Result result;
+
+    if (options.programs.empty()) {
+        for (Integer i = 0; i != (Integer)Bank::NUMBER_OF_PROGRAMS; ++i) {
+            if (!bank[i].is_blank()) {
+                options.programs.push_back(i);
+            }
+        }
+    }
+
+    fprintf(
+        stdout,
+        "program\tname\tsample_rate\tblock_size\tpolyphony\tmode"
+        "\tsamples\tseconds\tsamples_per_sec\trealtime_factor"
+        "\tp50_us\tp99_us\tmax_us\n"
+    );
+
+    for (Integer const program_index : options.programs) {
+        Bank::Program const& program = bank[program_index];
+
+        for (Number const sample_rate : options.sample_rates) {
+            for (Integer const block_size : options.block_sizes) {
+                for (Integer const polyphony : options.polyphony) {
+                    for (Integer const mode : options.modes) {
+                        run_case(
+                            program,
+                            block_size,
+                            sample_rate,
+                            polyphony,
+                            mode,
+                            options.length,
+                            block_times,
+                            result
+                        );
+
+                        fprintf(
+                            stdout,
+                            "%d\t%s\t%.0f\t%d\t%d\t%s\t%lld\t%.6f\t%.1f\t%.3f\t%.3f\t%.3f\t%.3f\n",
+                            (int)program_index,
+                            program.get_name().c_str(),
+                            sample_rate,
+                            (int)block_size,
+                            (int)polyphony,
+                            mode == ToggleParam::ON ? "poly" : "mono",
+                            (long long)result.samples,
+                            result.elapsed_seconds,
+                            result.samples_per_second,
+                            result.realtime_factor,
+                            result.p50_us,
+                            result.p99_us,
+                            result.max_us
+                        );
+                        fflush(stdout);
+                    }
+                }
+            }
+        }
+    }
+
+    return 0;
+}
@@ -246,6 +246,10 @@ void render_sound(
 
         Sample const* const* samples = synth.generate_samples(r, BLOCK_SIZE);
 
+#ifdef JS80P_PROFILING
+        Profiler::collect();
+#endif
+
         for (size_t i = 0; i != BLOCK_SIZE; ++i) {
             buffer.append24(sample_to_wav(samples[0][i]));
             buffer.append24(sample_to_wav(samples[1][i]));
@@ -312,6 +316,10 @@ int main(int const argc, char const* argv[])
 
     render_sound((size_t)program_index, (Midi::Byte)velocity, out_file);
 
+#ifdef JS80P_PROFILING
+    Profiler::dump(stderr);
+#endif
+
     return 0;
 }
 
@@ -0,0 +1,248 @@
+/*
+ * This file is part of JS80P, a synthesizer plugin.
+ * Copyright (C) 2023  Attila M. Magyar
+ *
+ * JS80P is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * JS80P is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/*
+Render strummed chords with decreasing velocities and dense mod wheel
+automation with various event grids (see Synth::MessageType::SET_EVENT_GRID),
+and
+print the rendering time and the deviation from the exactly timed rendering
+as tab separated values. E.g.:
+
+    ./build/x86_64-gpp-avx/perf_event_grid 0 128 4.0
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "js80p.hpp"
+#include "midi.hpp"
+
+#include "bank.cpp"
+#include "serializer.cpp"
+#include "synth.cpp"
+
+
+using namespace JS80P;
+
+
+typedef std::vector<Sample> Samples;
+
+
+constexpr Frequency SAMPLE_RATE = 44100.0;
+
+constexpr Midi::Note NOTES[] = {
+    Midi::NOTE_E_2, Midi::NOTE_B_2, Midi::NOTE_E_3, Midi::NOTE_G_SHARP_3,
+    Midi::NOTE_B_3, Midi::NOTE_E_4, Midi::NOTE_G_SHARP_4, Midi::NOTE_B_4,
+    Midi::NOTE_E_5, Midi::NOTE_G_SHARP_5,
+};
+
+constexpr Integer NUMBER_OF_NOTES = (Integer)(sizeof(NOTES) / sizeof(NOTES[0]));
+
+constexpr Seconds CHORD_LENGTH = 0.5;
+constexpr Seconds NOTE_OFF_AT = 0.4;
+constexpr Seconds STRUM_GAP = 0.0004;
+constexpr Midi::Byte VELOCITY_DECREASE = 9;
+
+constexpr Seconds CONTROL_CHANGE_GAP = 0.002;
+
+constexpr Integer EVENT_GRIDS[] = {1, 4, 8, 16, 32};
+
+
+void usage(char const* const name)
+{
+    fprintf(stderr, "Usage: %s PROGRAM BLOCK_SIZE LENGTH\n", name);
+    fprintf(stderr, "\n");
+    fprintf(stderr, "    PROGRAM      preset number (0-%d)\n", (int)Bank::NUMBER_OF_PROGRAMS - 1);
+    fprintf(stderr, "    BLOCK_SIZE   number of samples per rendering round\n");
+    fprintf(stderr, "    LENGTH       rendered length in seconds\n");
+}
+
+
+void schedule_block_events(
+        Synth& synth,
+        Integer const round,
+        Integer const block_size
+) {
+    Seconds const block_start = (Seconds)(round * block_size) / SAMPLE_RATE;
+    Seconds const block_end = (Seconds)((round + 1) * block_size) / SAMPLE_RATE;
+
+    /* Chords start and stop at multiples of CHORD_LENGTH. */
+    Seconds const chord_start = std::floor(block_start / CHORD_LENGTH) * CHORD_LENGTH;
+
+    for (Seconds start = chord_start; start < block_end; start += CHORD_LENGTH) {
+        Midi::Byte velocity = 127;
+
+        for (Integer i = 0; i != NUMBER_OF_NOTES; ++i) {
+            Seconds const note_on = start + (Seconds)i * STRUM_GAP;
+            Seconds const note_off = start + NOTE_OFF_AT + (Seconds)i * STRUM_GAP;
+
+            if (note_on >= block_start && note_on < block_end) {
+                synth.note_on(note_on - block_start, 0, NOTES[i], velocity);
+            }
+
+            if (note_off >= block_start && note_off < block_end) {
+                synth.note_off(note_off - block_start, 0, NOTES[i], 64);
+            }
+
+            velocity -= VELOCITY_DECREASE;
+        }
+    }
+
+    Integer first_change = (Integer)std::ceil(block_start / CONTROL_CHANGE_GAP);
+
+    for (
+            Seconds time_offset = (Seconds)first_change * CONTROL_CHANGE_GAP;
+            time_offset < block_end;
+            time_offset += CONTROL_CHANGE_GAP, ++first_change
+    ) {
+        synth.control_change(
+            time_offset - block_start,
+            0,
+            Midi::MODULATION_WHEEL,
+            (Midi::Byte)(64.0 + 63.0 * std::sin((Number)first_change * 0.05))
+        );
+    }
+}
+
+
+Number render(
+        Bank::Program const& program,
+        Integer const block_size,
+        Seconds const length,
+        Integer const event_grid,
+        Samples& rendered
+) {
+    Synth* const synth = new Synth();
+    Integer const rounds = (Integer)std::ceil(length * SAMPLE_RATE / (Number)block_size);
+    Number elapsed_seconds = 0.0;
+
+    Serializer::import_patch_in_audio_thread(*synth, program.serialize());
+
+    synth->suspend();
+    synth->set_block_size(block_size);
+    synth->set_sample_rate(SAMPLE_RATE);
+    synth->resume();
+    synth->process_message(
+        Synth::MessageType::SET_EVENT_GRID,
+        Synth::ParamId::MAX_PARAM_ID,
+        (Number)event_grid,
+        0
+    );
+
+    rendered.clear();
+    rendered.reserve((Samples::size_type)(rounds * block_size * Synth::OUT_CHANNELS));
+
+    for (Integer round = 0; round != rounds; ++round) {
+        schedule_block_events(*synth, round, block_size);
+
+        std::chrono::steady_clock::time_point const start = (
+            std::chrono::steady_clock::now()
+        );
+
+        Sample const* const* const samples = synth->generate_samples(round, block_size);
+
+        elapsed_seconds += std::chrono::duration<Number>(
+            std::chrono::steady_clock::now() - start
+        ).count();
+
+        for (Integer c = 0; c != Synth::OUT_CHANNELS; ++c) {
+            rendered.insert(rendered.end(), samples[c], samples[c] + block_size);
+        }
+    }
+
+    delete synth;
+
+    return elapsed_seconds;
+}
+
+
+int main(int const argc, char const* const* const argv)
+{
+    if (argc != 4) {
+        usage(argv[0]);
+
+        return 1;
+    }
+
+    Integer const program_index = (Integer)atol(argv[1]);
+    Integer const block_size = (Integer)atol(argv[2]);
+    Seconds const length = (Seconds)strtod(argv[3], NULL);
+
+    if (
+            program_index < 0
+            || program_index >= (Integer)Bank::NUMBER_OF_PROGRAMS
+            || block_size < 1
+            || length <= 0.0
+    ) {
+        usage(argv[0]);
+
+        return 1;
+    }
+
+    Bank bank;
+    Bank::Program const& program = bank[program_index];
+    Samples reference;
+    Samples rendered;
+    Number reference_seconds = 0.0;
+
+    fprintf(
+        stdout,
+        "program\tname\tblock_size\tevent_grid\tseconds\tspeedup"
+        "\tmax_deviation\trms_deviation\n"
+    );
+
+    for (Integer const event_grid : EVENT_GRIDS) {
+        Number const seconds = render(
+            program, block_size, length, event_grid, rendered
+        );
+        Number max_deviation = 0.0;
+        Number sum_of_squares = 0.0;
+
+        if (event_grid == 1) {
+            reference.swap(rendered);
+            reference_seconds = seconds;
+        } else {
+            for (Samples::size_type i = 0; i != reference.size(); ++i) {
+                Number const deviation = std::fabs(rendered[i] - reference[i]);
+
+                max_deviation = std::max(max_deviation, deviation);
+                sum_of_squares += deviation * deviation;
+            }
+        }
+
+        fprintf(
+            stdout,
+            "%d\t%s\t%d\t%d\t%.6f\t%.3f\t%.6f\t%.6f\n",
+            (int)program_index,
+            program.get_name().c_str(),
+            (int)block_size,
+            (int)event_grid,
+            seconds,
+            reference_seconds / seconds,
+            max_deviation,
+            std::sqrt(sum_of_squares / (Number)reference.size())
+        );
+        fflush(stdout);
+    }
+
+    return 0;
+}
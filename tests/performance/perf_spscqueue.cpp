@@ -0,0 +1,189 @@
+/*
+ * This file is part of JS80P, a synthesizer plugin.
+ * Copyright (C) 2023  Attila M. Magyar
+ *
+ * JS80P is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * JS80P is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/*
+Measure the throughput of SPSCQueue with a producer and a consumer thread,
+moving items one by one and in batches of various sizes, and print the
+results as tab separated values. The items are as big as Synth::Message. E.g.:
+
+    ./build/x86_64-gpp-avx/perf_spscqueue 10000000 8192
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+
+#include "js80p.hpp"
+
+#include "spscqueue.cpp"
+
+
+using namespace JS80P;
+
+
+class Item
+{
+    public:
+        Item() : type(0), param_id(0), number_param(0.0), byte_param(0)
+        {
+        }
+
+        Integer type;
+        Integer param_id;
+        Number number_param;
+        Byte byte_param;
+};
+
+
+typedef SPSCQueue<Item> Queue;
+
+
+constexpr Queue::SizeType MAX_BATCH_SIZE = 256;
+
+Queue::SizeType const BATCH_SIZES[] = {1, 4, 16, 64, 256};
+
+
+void usage(char const* const name)
+{
+    fprintf(stderr, "Usage: %s N CAPACITY\n", name);
+    fprintf(stderr, "\n");
+    fprintf(stderr, "    N          number of items to move through the queue\n");
+    fprintf(stderr, "    CAPACITY   capacity of the queue\n");
+}
+
+
+void produce(Queue& queue, Integer const n, Queue::SizeType const batch_size)
+{
+    Item batch[MAX_BATCH_SIZE];
+    Integer next = 0;
+
+    while (next != n) {
+        if (batch_size == 1) {
+            batch[0].param_id = next;
+
+            if (queue.push(batch[0])) {
+                ++next;
+            } else {
+                std::this_thread::yield();
+            }
+
+            continue;
+        }
+
+        Queue::SizeType const count = (
+            std::min((Queue::SizeType)(n - next), batch_size)
+        );
+
+        for (Queue::SizeType i = 0; i != count; ++i) {
+            batch[i].param_id = next + (Integer)i;
+        }
+
+        Queue::SizeType const pushed = queue.push_bulk(batch, count);
+
+        if (pushed == 0) {
+            std::this_thread::yield();
+        }
+
+        next += (Integer)pushed;
+    }
+}
+
+
+bool consume(Queue& queue, Integer const n, Queue::SizeType const batch_size)
+{
+    Item batch[MAX_BATCH_SIZE];
+    Integer next = 0;
+    bool is_in_order = true;
+
+    while (next != n) {
+        Queue::SizeType const count = (
+            batch_size == 1
+                ? (queue.pop(batch[0]) ? 1 : 0)
+                : queue.pop_bulk(batch, batch_size)
+        );
+
+        if (count == 0) {
+            std::this_thread::yield();
+        }
+
+        for (Queue::SizeType i = 0; i != count; ++i) {
+            is_in_order = is_in_order && batch[i].param_id == next;
+            ++next;
+        }
+    }
+
+    return is_in_order;
+}
+
+
+int main(int const argc, char const* const* const argv)
+{
+    if (argc != 3) {
+        usage(argv[0]);
+
+        return 1;
+    }
+
+    Integer const n = (Integer)atol(argv[1]);
+    Queue::SizeType const capacity = (Queue::SizeType)atol(argv[2]);
+
+    if (n < 1 || capacity < MAX_BATCH_SIZE) {
+        usage(argv[0]);
+
+        return 1;
+    }
+
+    fprintf(stdout, "batch_size\titems\tseconds\titems_per_sec\tin_order\n");
+
+    for (Queue::SizeType const batch_size : BATCH_SIZES) {
+        Queue queue(capacity);
+        bool is_in_order = false;
+
+        std::chrono::steady_clock::time_point const start = (
+            std::chrono::steady_clock::now()
+        );
+
+        std::thread consumer(
+            [&queue, &is_in_order, n, batch_size]() {
+                is_in_order = consume(queue, n, batch_size);
+            }
+        );
+
+        produce(queue, n, batch_size);
+        consumer.join();
+
+        Number const elapsed_seconds = std::chrono::duration<Number>(
+            std::chrono::steady_clock::now() - start
+        ).count();
+
+        fprintf(
+            stdout,
+            "%d\t%lld\t%.6f\t%.1f\t%s\n",
+            (int)batch_size,
+            (long long)n,
+            elapsed_seconds,
+            (Number)n / elapsed_seconds,
+            is_in_order ? "yes" : "no"
+        );
+        fflush(stdout);
+    }
+
+    return 0;
+}
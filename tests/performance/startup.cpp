@@ -0,0 +1,202 @@
+/*
+ * This file is part of JS80P, a synthesizer plugin.
+ * Copyright (C) 2023  Attila M. Magyar
+ *
+ * JS80P is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * JS80P is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/*
+Measure how long it takes for the FST plugin to get from being loaded by the
+host to rendering its first block, e.g.:
+
+    ./build/x86_64-gpp-avx/startup dist/js80p-dev-linux-x86_64-avx-fst/js80p.so
+*/
+
+#include <chrono>
+#include <cstdio>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <dlfcn.h>
+#endif
+
+#include <fst/fst.h>
+
+
+constexpr float SAMPLE_RATE = 44100.0f;
+constexpr int BLOCK_SIZE = 128;
+
+
+typedef AEffect* (*VSTPluginMainFunc)(audioMasterCallback host_callback);
+
+
+#ifdef _WIN32
+typedef HMODULE LibraryHandle;
+
+LibraryHandle load_library(char const* const path)
+{
+    return LoadLibraryA(path);
+}
+
+
+VSTPluginMainFunc find_entry_point(LibraryHandle const handle)
+{
+    return (VSTPluginMainFunc)GetProcAddress(handle, "VSTPluginMain");
+}
+
+
+void unload_library(LibraryHandle const handle)
+{
+    FreeLibrary(handle);
+}
+#else
+typedef void* LibraryHandle;
+
+LibraryHandle load_library(char const* const path)
+{
+    return dlopen(path, RTLD_NOW | RTLD_LOCAL);
+}
+
+
+VSTPluginMainFunc find_entry_point(LibraryHandle const handle)
+{
+    return (VSTPluginMainFunc)dlsym(handle, "VSTPluginMain");
+}
+
+
+void unload_library(LibraryHandle const handle)
+{
+    dlclose(handle);
+}
+#endif
+
+
+VstIntPtr VSTCALLBACK host_callback(
+        AEffect* effect,
+        VstInt32 op_code,
+        VstInt32 index,
+        VstIntPtr value,
+        void* pointer,
+        float opt
+) {
+    if (op_code == audioMasterVersion) {
+        return 2400;
+    }
+
+    return 0;
+}
+
+
+class Stopwatch
+{
+    public:
+        Stopwatch() : last(std::chrono::steady_clock::now())
+        {
+        }
+
+        double lap()
+        {
+            std::chrono::steady_clock::time_point const now = (
+                std::chrono::steady_clock::now()
+            );
+            std::chrono::duration<double, std::milli> const elapsed = now - last;
+
+            last = now;
+
+            return elapsed.count();
+        }
+
+    private:
+        std::chrono::steady_clock::time_point last;
+};
+
+
+int main(int const argc, char const* const* const argv)
+{
+    if (argc != 2) {
+        fprintf(stderr, "Usage: %s path/to/js80p.so\n", argv[0]);
+
+        return 1;
+    }
+
+    Stopwatch stopwatch;
+
+    LibraryHandle const handle = load_library(argv[1]);
+
+    if (handle == NULL) {
+        fprintf(stderr, "Unable to load %s\n", argv[1]);
+
+        return 2;
+    }
+
+    double const load_time = stopwatch.lap();
+
+    VSTPluginMainFunc const vst_plugin_main = find_entry_point(handle);
+
+    if (vst_plugin_main == NULL) {
+        fprintf(stderr, "Unable to find VSTPluginMain() in %s\n", argv[1]);
+        unload_library(handle);
+
+        return 3;
+    }
+
+    AEffect* const effect = vst_plugin_main(&host_callback);
+
+    if (effect == NULL || effect->magic != kEffectMagic) {
+        fprintf(stderr, "Unable to create plugin instance\n");
+        unload_library(handle);
+
+        return 4;
+    }
+
+    double const create_time = stopwatch.lap();
+
+    effect->dispatcher(effect, effOpen, 0, 0, NULL, 0.0f);
+    effect->dispatcher(effect, effSetSampleRate, 0, 0, NULL, SAMPLE_RATE);
+    effect->dispatcher(effect, effSetBlockSize, 0, BLOCK_SIZE, NULL, 0.0f);
+    effect->dispatcher(effect, effMainsChanged, 0, 1, NULL, 0.0f);
+
+    double const open_time = stopwatch.lap();
+
+    float left[BLOCK_SIZE];
+    float right[BLOCK_SIZE];
+    float* outputs[] = {left, right};
+
+    effect->processReplacing(effect, NULL, outputs, BLOCK_SIZE);
+
+    double const first_block_time = stopwatch.lap();
+
+    fprintf(
+        stdout,
+        (
+            "load:        %10.3f ms\n"
+            "create:      %10.3f ms\n"
+            "open:        %10.3f ms\n"
+            "first block: %10.3f ms\n"
+            "total:       %10.3f ms\n"
+        ),
+        load_time,
+        create_time,
+        open_time,
+        first_block_time,
+        load_time + create_time + open_time + first_block_time
+    );
+
+    effect->dispatcher(effect, effMainsChanged, 0, 0, NULL, 0.0f);
+    effect->dispatcher(effect, effClose, 0, 0, NULL, 0.0f);
+    unload_library(handle);
+
+    return 0;
+}
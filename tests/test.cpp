@@ -780,13 +780,20 @@ static bool _name(                                                          \
 
 
 #define _ASSERT_A_OP_B_WITH_DELTA_METHOD(_name, _cmp, _op, _type, _zero)    \
+    _ASSERT_MIXED_A_OP_B_WITH_DELTA_METHOD(                                 \
+        _name, _cmp, _op, _type, _type, _type, = _zero                      \
+    )
+
+#define _ASSERT_MIXED_A_OP_B_WITH_DELTA_METHOD(                             \
+        _name, _cmp, _op, _type_a, _type_b, _type, _default                 \
+)                                                                           \
 static bool _name(                                                          \
         _TEST_ARGS,                                                         \
         char const* a_src,                                                  \
         char const* b_src,                                                  \
-        _type const a,                                                      \
-        _type const b,                                                      \
-        _type const tolerance = _zero,                                      \
+        _type_a const a,                                                    \
+        _type_b const b,                                                    \
+        _type const tolerance _default,                                     \
         _TEST_VARGS                                                         \
 ) {                                                                         \
     if (std::fabs(a - b) _cmp tolerance) {                                  \
@@ -812,6 +819,19 @@ static bool _name(                                                          \
         _ASSERT_A_OP_B_WITH_DELTA_METHOD(neq, >, !=, float, 0.0f)
         _ASSERT_A_OP_B_WITH_DELTA_METHOD(neq, >, !=, double, 0.0)
 
+        /*
+        Comparing single precision samples to double precision numbers or
+        tolerances (e.g. when the tests are built with float samples) would
+        be ambiguous without these.
+        */
+        _ASSERT_MIXED_A_OP_B_WITH_DELTA_METHOD(eq, <=, ==, float, float, double, )
+        _ASSERT_MIXED_A_OP_B_WITH_DELTA_METHOD(eq, <=, ==, float, double, double, = 0.0)
+        _ASSERT_MIXED_A_OP_B_WITH_DELTA_METHOD(eq, <=, ==, double, float, double, = 0.0)
+
+        _ASSERT_MIXED_A_OP_B_WITH_DELTA_METHOD(neq, >, !=, float, float, double, )
+        _ASSERT_MIXED_A_OP_B_WITH_DELTA_METHOD(neq, >, !=, float, double, double, = 0.0)
+        _ASSERT_MIXED_A_OP_B_WITH_DELTA_METHOD(neq, >, !=, double, float, double, = 0.0)
+
 
 #define _ASSERT_ARRAY_OP_METHOD(_name, _op, _type, _type_f, _abs_fn)        \
 static bool _name(                                                          \
@@ -134,6 +134,82 @@ TEST(program_can_be_imported, {
 })
 
 
+TEST(program_can_be_compiled_until_it_is_changed, {
+    Synth synth;
+    Bank::Program program("Name", "Default Name", "[js80p]\nPM = 0.42");
+
+    assert_true(program.get_compiled_messages() == NULL);
+
+    program.compile(synth);
+
+    assert_false(program.get_compiled_messages() == NULL);
+    assert_eq(1, (int)program.get_compiled_messages()->size());
+
+    program.set_name("New Name");
+
+    assert_false(program.get_compiled_messages() == NULL);
+
+    program.import("[js80p]\nPM = 0.5");
+
+    assert_true(program.get_compiled_messages() == NULL);
+
+    synth.process_message(
+        Synth::MessageType::SET_PARAM, Synth::ParamId::PM, 0.123, 0
+    );
+    program.import(synth);
+
+    assert_eq("New Name", program.get_name());
+    assert_false(program.get_compiled_messages() == NULL);
+
+    Serializer::Messages const& messages = *program.get_compiled_messages();
+    Number pm = 0.0;
+
+    for (size_t i = 0; i != messages.size(); ++i) {
+        if (messages[i].param_id == Synth::ParamId::PM) {
+            pm = messages[i].number_param;
+        }
+    }
+
+    assert_eq(0.123, pm, DOUBLE_DELTA);
+})
+
+
+TEST(program_can_capture_the_state_of_the_synth_without_serializing_it, {
+    Synth synth;
+    Bank::Program program("Name", "Default Name", "[js80p]\nPM = 0.5");
+    std::string const original = program.serialize();
+
+    synth.process_message(
+        Synth::MessageType::SET_PARAM, Synth::ParamId::PM, 0.123, 0
+    );
+    synth.process_message(
+        Synth::MessageType::ASSIGN_CONTROLLER,
+        Synth::ParamId::MIX,
+        0.0,
+        Synth::ControllerId::MACRO_1
+    );
+    program.compile(synth);
+    program.capture(synth);
+
+    assert_false(program.get_compiled_messages() == NULL);
+    assert_eq(original, program.serialize());
+
+    program.serialize_captured(synth);
+
+    Bank::Program expected("Name", "Default Name", Serializer::serialize(synth));
+
+    assert_eq("Name", program.get_name());
+    assert_eq(expected.serialize(), program.serialize());
+    assert_false(program.get_compiled_messages() == NULL);
+
+    program.set_name("New Name");
+    program.serialize_captured(synth);
+    expected.set_name("New Name");
+
+    assert_eq(expected.serialize(), program.serialize());
+})
+
+
 TEST(an_imported_program_may_be_empty, {
     Bank::Program program("Name", "Default Name", "[js80p]\nMIX = 1.0");
 
@@ -350,6 +426,144 @@ TEST(serialization, {
 })
 
 
+TEST(imported_bank_can_be_compiled_in_advance_and_swapped_in_for_program_changes, {
+    Synth synth;
+    Bank bank;
+    Bank* const imported_bank = new Bank();
+
+    bank.set_current_program_index(1);
+
+    imported_bank->import(
+        "[js80p]\n"
+        "NAME = preset 1\n"
+        "PM = 0.25\n"
+        "\n"
+        "[js80p]\n"
+        "NAME = preset 2\n"
+        "PM = 0.75\n"
+    );
+
+    assert_true((*imported_bank)[1].get_compiled_messages() == NULL);
+
+    imported_bank->compile(synth);
+    bank.swap_programs(*imported_bank);
+
+    assert_eq(1, (int)bank.get_current_program_index());
+    assert_eq("preset 1", bank[0].get_name());
+    assert_eq("preset 2", bank[1].get_name());
+    assert_eq("Blank", (*imported_bank)[0].get_name());
+
+    delete imported_bank;
+
+    for (size_t i = 0; i != Bank::NUMBER_OF_PROGRAMS; ++i) {
+        assert_false(bank[i].get_compiled_messages() == NULL, "i=%d", (int)i);
+    }
+
+    Serializer::import_patch_in_audio_thread(synth, *bank[0].get_compiled_messages());
+
+    assert_eq(
+        0.25, synth.get_param_ratio_atomic(Synth::ParamId::PM), DOUBLE_DELTA
+    );
+
+    Serializer::import_patch_in_audio_thread(synth, *bank[1].get_compiled_messages());
+
+    assert_eq(
+        0.75, synth.get_param_ratio_atomic(Synth::ParamId::PM), DOUBLE_DELTA
+    );
+})
+
+
+TEST(bank_can_be_serialized_into_and_imported_from_the_binary_format, {
+    Synth synth;
+    Bank bank;
+    Bank imported_bank;
+    Bank names;
+
+    bank.import(
+        "[js80p]\n"
+        "NAME = preset 1\n"
+        "PM = 0.25\n"
+        "\n"
+        "[js80p]\n"
+        "NAME = preset 2\n"
+        "MIXctl = 0.5\n"
+    );
+
+    synth.process_message(
+        Synth::MessageType::SET_PARAM, Synth::ParamId::PM, 0.75, 0
+    );
+    bank[2].capture(synth);
+    bank[2].set_name("captured");
+
+    std::string const serialized_bank = bank.serialize_binary(synth);
+
+    assert_true(Serializer::is_binary(serialized_bank));
+
+    imported_bank.import(synth, serialized_bank);
+    names.import_names(serialized_bank);
+
+    for (size_t i = 0; i != Bank::NUMBER_OF_PROGRAMS; ++i) {
+        assert_eq(bank[i].get_name(), imported_bank[i].get_name(), "i=%d", (int)i);
+        assert_eq(bank[i].get_name(), names[i].get_name(), "i=%d", (int)i);
+        assert_false(imported_bank[i].get_compiled_messages() == NULL, "i=%d", (int)i);
+    }
+
+    assert_false(imported_bank[0].is_blank());
+    assert_true(imported_bank[3].is_blank());
+
+    Serializer::import_patch_in_audio_thread(synth, *imported_bank[0].get_compiled_messages());
+
+    assert_eq(
+        0.25, synth.get_param_ratio_atomic(Synth::ParamId::PM), DOUBLE_DELTA
+    );
+
+    Serializer::import_patch_in_audio_thread(synth, *imported_bank[1].get_compiled_messages());
+
+    assert_eq(
+        (int)Synth::ControllerId::PITCH_WHEEL,
+        (int)synth.get_param_controller_id_atomic(Synth::ParamId::MIX)
+    );
+
+    Serializer::import_patch_in_audio_thread(synth, imported_bank[2].serialize_binary(synth));
+
+    assert_eq(
+        0.75, synth.get_param_ratio_atomic(Synth::ParamId::PM), DOUBLE_DELTA
+    );
+
+    imported_bank.serialize_captured_programs(synth);
+
+    assert_false(imported_bank[0].is_blank());
+    assert_true(
+        imported_bank[0].serialize().find("PM = 0.25") != std::string::npos
+    );
+})
+
+
+TEST(text_bank_is_compiled_when_imported_along_with_a_synth, {
+    Synth synth;
+    Bank bank;
+
+    bank.import(
+        synth,
+        "[js80p]\n"
+        "NAME = preset 1\n"
+        "PM = 0.25\n"
+    );
+
+    assert_eq("preset 1", bank[0].get_name());
+
+    for (size_t i = 0; i != Bank::NUMBER_OF_PROGRAMS; ++i) {
+        assert_false(bank[i].get_compiled_messages() == NULL, "i=%d", (int)i);
+    }
+
+    Serializer::import_patch_in_audio_thread(synth, *bank[0].get_compiled_messages());
+
+    assert_eq(
+        0.25, synth.get_param_ratio_atomic(Synth::ParamId::PM), DOUBLE_DELTA
+    );
+})
+
+
 TEST(can_convert_normalized_parameter_value_to_program_index, {
     assert_eq(0, (int)Bank::normalized_parameter_value_to_program_index(-0.5));
 
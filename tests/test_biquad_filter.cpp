@@ -900,7 +900,7 @@ void assert_filter_rendering_is_independent_of_chunk_size(
     set_up_chunk_size_independent_test(filter_2, type, input_2);
 
     assert_rendering_is_independent_from_chunk_size< BiquadFilter<SumOfSines> >(
-        filter_1, filter_2, DOUBLE_DELTA, message
+        filter_1, filter_2, SAMPLE_DELTA, message
     );
 }
 
@@ -928,3 +928,116 @@ TEST(filter_rendering_is_independent_of_chunk_size, {
         BiquadFilter<SumOfSines>::HIGH_SHELF, "high shelf"
     );
 })
+
+
+void set_up_bank_test_filter(
+        BiquadFilter<SumOfSines>& filter,
+        Integer const index
+) {
+    constexpr BiquadFilter<SumOfSines>::Type types[] = {
+        BiquadFilter<SumOfSines>::LOW_PASS,
+        BiquadFilter<SumOfSines>::HIGH_PASS,
+        BiquadFilter<SumOfSines>::BAND_PASS,
+        BiquadFilter<SumOfSines>::NOTCH,
+        BiquadFilter<SumOfSines>::PEAKING,
+        BiquadFilter<SumOfSines>::LOW_SHELF,
+        BiquadFilter<SumOfSines>::HIGH_SHELF,
+    };
+
+    filter.set_sample_rate(SAMPLE_RATE);
+    filter.set_block_size(BLOCK_SIZE);
+    filter.type.set_value(types[index % 7]);
+    filter.frequency.set_value(500.0 + 300.0 * (Number)index);
+    filter.q.set_value(1.0);
+    filter.gain.set_value(-6.0);
+
+    if (index % 5 == 4) {
+        filter.frequency.schedule_linear_ramp(0.01, 5000.0);
+    }
+}
+
+
+TEST(filter_bank_renders_the_same_signal_as_individual_filters, {
+    constexpr Integer filters_count = 9;
+    constexpr Integer rounds = 10;
+    constexpr Integer sample_counts[] = {BLOCK_SIZE, 1, 37, BLOCK_SIZE, 100};
+
+    BiquadFilterSharedCache shared_caches[2];
+    BiquadFilterBank bank;
+    SumOfSines* expected_inputs[filters_count];
+    SumOfSines* actual_inputs[filters_count];
+    BiquadFilter<SumOfSines>::TypeParam* filter_types[filters_count];
+    BiquadFilter<SumOfSines>* expected_filters[filters_count];
+    BiquadFilter<SumOfSines>* actual_filters[filters_count];
+
+    bank.set_block_size(BLOCK_SIZE);
+
+    for (Integer i = 0; i != filters_count; ++i) {
+        BiquadFilterSharedCache* const shared_cache = (
+            i < 4 ? &shared_caches[i % 2] : NULL
+        );
+        Integer const index = shared_cache == NULL ? i : i % 2;
+
+        Frequency const frequency = 110.0 * (Number)(i + 1);
+
+        expected_inputs[i] = new SumOfSines(
+            0.3, frequency, 0.3, 3520.0, 0.3, 7040.0, CHANNELS
+        );
+        actual_inputs[i] = new SumOfSines(
+            0.3, frequency, 0.3, 3520.0, 0.3, 7040.0, CHANNELS
+        );
+        expected_inputs[i]->set_sample_rate(SAMPLE_RATE);
+        expected_inputs[i]->set_block_size(BLOCK_SIZE);
+        actual_inputs[i]->set_sample_rate(SAMPLE_RATE);
+        actual_inputs[i]->set_block_size(BLOCK_SIZE);
+        filter_types[i] = new BiquadFilter<SumOfSines>::TypeParam("");
+        expected_filters[i] = new BiquadFilter<SumOfSines>(
+            "", *expected_inputs[i], *filter_types[i]
+        );
+        actual_filters[i] = new BiquadFilter<SumOfSines>(
+            "", *actual_inputs[i], *filter_types[i], shared_cache
+        );
+        set_up_bank_test_filter(*expected_filters[i], index);
+        set_up_bank_test_filter(*actual_filters[i], index);
+    }
+
+    for (Integer round = 0; round != rounds; ++round) {
+        Integer const sample_count = sample_counts[round % 5];
+
+        for (Integer i = 0; i != filters_count; ++i) {
+            bank.produce<SumOfSines>(*actual_filters[i], round, sample_count);
+        }
+
+        bank.flush();
+
+        for (Integer i = 0; i != filters_count; ++i) {
+            Sample const* const* const actual = SignalProducer::produce<
+                BiquadFilter<SumOfSines>
+            >(*actual_filters[i], round, sample_count);
+            Sample const* const* const expected = SignalProducer::produce<
+                BiquadFilter<SumOfSines>
+            >(*expected_filters[i], round, sample_count);
+
+            for (Integer c = 0; c != CHANNELS; ++c) {
+                assert_eq(
+                    expected[c],
+                    actual[c],
+                    sample_count,
+                    DOUBLE_DELTA,
+                    "round=%d, filter=%d, channel=%d",
+                    (int)round,
+                    (int)i,
+                    (int)c
+                );
+            }
+        }
+    }
+
+    for (Integer i = 0; i != filters_count; ++i) {
+        delete actual_filters[i];
+        delete expected_filters[i];
+        delete filter_types[i];
+        delete actual_inputs[i];
+        delete expected_inputs[i];
+    }
+})
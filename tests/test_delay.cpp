@@ -197,6 +197,86 @@ TEST(block_size_may_be_larger_than_max_delay_time, {
 })
 
 
+void test_constant_delay_time(Seconds const time, Number const gain_value)
+{
+    constexpr Integer block_size = 5;
+    constexpr Integer rounds = 30;
+    constexpr Integer sample_count = rounds * block_size;
+    constexpr Frequency sample_rate = 10.0;
+    constexpr Sample input_samples[CHANNELS][block_size] = {
+        {0.10, 0.20, 0.30, 0.40, 0.50},
+        {0.20, 0.40, 0.60, 0.80, 1.00},
+    };
+    Sample const* input_buffer[CHANNELS] = {
+        (Sample const*)&input_samples[0],
+        (Sample const*)&input_samples[1]
+    };
+    FixedSignalProducer input(input_buffer);
+    FloatParamS gain("", 0.0, 1.0, gain_value);
+    Buffer output(sample_count, CHANNELS);
+    Sample expected_output[CHANNELS][sample_count];
+
+    /* The delay buffer is short, so that reading it wraps around many times. */
+    Delay<FixedSignalProducer> delay(input, gain, time, 1.0);
+
+    input.set_sample_rate(sample_rate);
+    input.set_block_size(block_size);
+    gain.set_sample_rate(sample_rate);
+    gain.set_block_size(block_size);
+
+    delay.set_sample_rate(sample_rate);
+    delay.set_block_size(block_size);
+
+    Number const delay_samples = time * sample_rate;
+    Integer const delay_floor = (Integer)std::floor(delay_samples);
+    Number const after_weight = delay_samples - (Number)delay_floor;
+
+    for (Integer c = 0; c != CHANNELS; ++c) {
+        for (Integer i = 0; i != sample_count; ++i) {
+            Integer const before_index = i - delay_floor;
+            Integer const after_index = before_index - 1;
+            Number const before = (
+                before_index >= 0 ? input_samples[c][before_index % block_size] : 0.0
+            );
+            Number const after = (
+                after_index >= 0 ? input_samples[c][after_index % block_size] : 0.0
+            );
+
+            expected_output[c][i] = gain_value * (
+                (1.0 - after_weight) * before + after_weight * after
+            );
+        }
+    }
+
+    render_rounds< Delay<FixedSignalProducer> >(delay, output, rounds);
+
+    for (Integer c = 0; c != CHANNELS; ++c) {
+        assert_eq(
+            expected_output[c],
+            output.samples[c],
+            sample_count,
+            0.000001,
+            "channel=%d, time=%f, gain=%f",
+            (int)c,
+            time,
+            gain_value
+        );
+    }
+}
+
+
+TEST(constant_delay_time_is_read_in_spans_between_wraparounds, {
+    test_constant_delay_time(0.0, 1.0);
+    test_constant_delay_time(0.3, 1.0);
+    test_constant_delay_time(0.3, 0.5);
+    test_constant_delay_time(0.9, 0.5);
+    test_constant_delay_time(0.23, 1.0);
+    test_constant_delay_time(0.23, 0.5);
+    test_constant_delay_time(0.045, 0.5);
+    test_constant_delay_time(0.97, 0.5);
+})
+
+
 void test_delay_with_feedback(
         Number const time_scale,
         Number const bpm,
@@ -52,7 +52,7 @@ constexpr Integer SAMPLE_COUNT = BLOCK_SIZE * ROUNDS;
 
 TEST(while_distortion_level_is_close_to_zero_the_original_signal_is_barely_affected, {
     SumOfSines input(1.0, 110.0, 0.0, 0.0, 0.0, 0.0, CHANNELS);
-    Distortion_ distortion("D", 10.0, input);
+    Distortion_ distortion("D", DistortionTables::TANH_10, input);
     Buffer expected_output(SAMPLE_COUNT, CHANNELS);
     Buffer actual_output(SAMPLE_COUNT, CHANNELS);
 
@@ -91,7 +91,7 @@ void naive_distort(Number const level, Buffer &buffer)
         for (Integer i = 0; i != SAMPLE_COUNT; ++i) {
             buffer.samples[c][i] *= level;
             buffer.samples[c][i] = std::min(
-                1.0, std::max(-1.0, buffer.samples[c][i])
+                (Sample)1.0, std::max((Sample)-1.0, buffer.samples[c][i])
             );
         }
     }
@@ -101,7 +101,7 @@ void naive_distort(Number const level, Buffer &buffer)
 void test_distortion(Number const original_signal_level)
 {
     SumOfSines input(original_signal_level, 110.0, 0.0, 0.0, 0.0, 0.0, CHANNELS);
-    Distortion_ distortion("D", 10.0, input);
+    Distortion_ distortion("D", DistortionTables::TANH_10, input);
     Buffer expected_output(SAMPLE_COUNT, CHANNELS);
     Buffer actual_output(SAMPLE_COUNT, CHANNELS);
 
@@ -145,7 +145,7 @@ TEST(when_distortion_level_is_high_then_the_signal_is_distorted, {
 
 TEST(when_input_is_silent_then_distortion_is_no_op, {
     SumOfSines input(1e-9, 110.0, 0.0, 0.0, 0.0, 0.0, CHANNELS);
-    Distortion_ distortion("D", 10.0, input);
+    Distortion_ distortion("D", DistortionTables::TANH_10, input);
     Sample const* const* input_buffer;
     Sample const* const* distorted_buffer;
 
@@ -162,3 +162,16 @@ TEST(when_input_is_silent_then_distortion_is_no_op, {
 
     assert_eq(input_buffer, distorted_buffer);
 })
+
+
+TEST(distortions_with_the_same_shape_share_their_tables, {
+    assert_eq(
+        (void*)&DistortionTables::get(DistortionTables::TANH_10),
+        (void*)&DistortionTables::get(DistortionTables::TANH_10)
+    );
+    assert_neq(
+        (void*)&DistortionTables::get(DistortionTables::TANH_3),
+        (void*)&DistortionTables::get(DistortionTables::TANH_10)
+    );
+})
+
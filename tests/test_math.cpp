@@ -221,6 +221,74 @@ TEST(detune, {
 })
 
 
+TEST(exp2, {
+    for (Number x = -60.0; x < 60.0; x += 0.0123) {
+        Number const expected = std::pow(2.0, x);
+
+        assert_eq(expected, Math::exp2(x), expected * 1e-14, "x=%f", x);
+    }
+
+    assert_eq(1.0, Math::exp2(0.0), 0.0);
+    assert_eq(0.25, Math::exp2(-2.0), 0.0);
+    assert_eq(1024.0, Math::exp2(10.0), 0.0);
+
+    assert_eq(std::pow(2.0, Math::EXP2_MIN), Math::exp2(-2000.0), 0.0);
+    assert_eq(std::pow(2.0, Math::EXP2_MAX), Math::exp2(2000.0), 0.0);
+})
+
+
+void assert_detune_ratios(std::vector<Frequency> const& cents)
+{
+    constexpr Number max_error_cents = 0.000000001;
+
+    std::vector<Frequency> ratios(cents);
+
+    Math::detune_ratios(ratios.data(), (Integer)ratios.size());
+
+    for (std::vector<Frequency>::size_type i = 0; i != cents.size(); ++i) {
+        Number const expected_cents = cents[i];
+        Number const actual_cents = 1200.0 * std::log2(ratios[i]);
+
+        assert_eq(
+            expected_cents,
+            actual_cents,
+            max_error_cents,
+            "i=%d, cents=%f",
+            (int)i,
+            expected_cents
+        );
+    }
+}
+
+
+TEST(detune_ratios, {
+    constexpr Integer size = 1000;
+
+    std::vector<Frequency> cents(size);
+
+    for (Integer i = 0; i != size; ++i) {
+        cents[i] = 4800.0 * std::sin((Number)i * 0.01);
+    }
+
+    assert_detune_ratios(cents);
+
+    for (Integer i = 0; i != size; ++i) {
+        cents[i] = -2400.0 + 3.7 * (Number)i;
+    }
+
+    assert_detune_ratios(cents);
+
+    for (Integer i = 0; i != size; ++i) {
+        cents[i] = 123.0;
+    }
+
+    assert_detune_ratios(cents);
+
+    cents.resize(7);
+    assert_detune_ratios(cents);
+})
+
+
 TEST(combine, {
     assert_eq(42.0, Math::combine(1.0, 42.0, 123.0), DOUBLE_DELTA);
     assert_eq(123.0, Math::combine(0.0, 42.0, 123.0), DOUBLE_DELTA);
@@ -85,3 +85,46 @@ TEST(keeps_track_of_assignments, {
     midi_controller.assigned();
     assert_true(midi_controller.is_assigned());
 })
+
+
+TEST(when_coalescing_is_enabled_then_changes_along_a_straight_line_are_merged, {
+    constexpr Number tolerance = 0.01;
+
+    MidiController midi_controller;
+
+    midi_controller.set_coalescing_tolerance(tolerance);
+
+    /* Rise from 0.0 to 0.5, with some jitter. */
+    for (Integer i = 0; i != 11; ++i) {
+        Number const jitter = (i & 1) ? tolerance * 0.4 : -tolerance * 0.4;
+
+        midi_controller.change(0.01 * (Seconds)i, 0.05 * (Number)i + jitter);
+    }
+
+    /* Then fall back to 0.0. */
+    for (Integer i = 1; i != 11; ++i) {
+        midi_controller.change(0.1 + 0.01 * (Seconds)i, 0.5 - 0.05 * (Number)i);
+    }
+
+    /* And jump. */
+    midi_controller.change(0.3, 1.0);
+
+    assert_eq(4, (int)midi_controller.events.length());
+    assert_eq(0.0, midi_controller.events[0].time_offset, DOUBLE_DELTA);
+    assert_eq(0.1, midi_controller.events[1].time_offset, DOUBLE_DELTA);
+    assert_eq(0.2, midi_controller.events[2].time_offset, DOUBLE_DELTA);
+    assert_eq(0.0, midi_controller.events[2].number_param_1, DOUBLE_DELTA);
+    assert_eq(0.3, midi_controller.events[3].time_offset, DOUBLE_DELTA);
+    assert_eq(1.0, midi_controller.events[3].number_param_1, DOUBLE_DELTA);
+    assert_eq(1.0, midi_controller.get_value(), DOUBLE_DELTA);
+
+    midi_controller.clear();
+    midi_controller.change(0.0, 0.0);
+    midi_controller.change(0.0, 0.1);
+    midi_controller.change(0.01, 0.2);
+    midi_controller.change(0.02, 0.3);
+
+    assert_eq(3, (int)midi_controller.events.length());
+    assert_eq(0.1, midi_controller.events[1].number_param_1, DOUBLE_DELTA);
+    assert_eq(0.3, midi_controller.events[2].number_param_1, DOUBLE_DELTA);
+})
@@ -0,0 +1,218 @@
+/*
+ * This file is part of JS80P, a synthesizer plugin.
+ * Copyright (C) 2023  Attila M. Magyar
+ *
+ * JS80P is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * JS80P is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <initializer_list>
+#include <string>
+
+#include "test.cpp"
+#include "utils.cpp"
+
+#include "midi_file.cpp"
+
+
+using namespace JS80P;
+
+
+std::string bytes(std::initializer_list<int> const values)
+{
+    std::string result;
+
+    for (int const value : values) {
+        result.push_back((char)value);
+    }
+
+    return result;
+}
+
+
+std::string chunk(char const* const type, std::string const& body)
+{
+    uint32_t const size = (uint32_t)body.size();
+
+    return (
+        std::string(type)
+        + bytes({
+            (int)(size >> 24) & 0xff,
+            (int)(size >> 16) & 0xff,
+            (int)(size >> 8) & 0xff,
+            (int)size & 0xff,
+        })
+        + body
+    );
+}
+
+
+std::string header(int const format, int const tracks, int const division)
+{
+    return chunk(
+        "MThd",
+        bytes({
+            0, format,
+            0, tracks,
+            (division >> 8) & 0xff, division & 0xff,
+        })
+    );
+}
+
+
+void assert_event(
+        MidiFile const& midi_file,
+        size_t const index,
+        Seconds const expected_time,
+        int const expected_status,
+        int const expected_data_1,
+        int const expected_data_2
+) {
+    assert_lt((int)index, (int)midi_file.events.size());
+
+    MidiFile::Event const& event = midi_file.events[index];
+
+    assert_eq(expected_time, event.time, DOUBLE_DELTA, "index=%d", (int)index);
+    assert_eq(expected_status, (int)event.bytes[0], "index=%d", (int)index);
+    assert_eq(expected_data_1, (int)event.bytes[1], "index=%d", (int)index);
+    assert_eq(expected_data_2, (int)event.bytes[2], "index=%d", (int)index);
+}
+
+
+TEST(format_0_file_is_parsed_using_the_default_tempo, {
+    /* 96 ticks per quarter note at 120 BPM: 1/192 seconds per tick */
+    std::string const data = (
+        header(0, 1, 96)
+        + chunk(
+            "MTrk",
+            bytes({
+                0x00, 0x90, 0x3c, 0x64,             /* note on */
+                0x60, 0x40, 0x50,                   /* running status */
+                0x00, 0xc0, 0x05,                   /* program change */
+                0x81, 0x40, 0x80, 0x3c, 0x40,       /* 192 ticks later */
+                0x00, 0xff, 0x2f, 0x00,             /* end of track */
+            })
+        )
+    );
+    MidiFile midi_file;
+    std::string error;
+
+    assert_true(midi_file.parse(data, error), "error=%s", error.c_str());
+    assert_eq(4, (int)midi_file.events.size());
+
+    assert_event(midi_file, 0, 0.0, 0x90, 0x3c, 0x64);
+    assert_event(midi_file, 1, 0.5, 0x90, 0x40, 0x50);
+    assert_event(midi_file, 2, 0.5, 0xc0, 0x05, 0x00);
+    assert_event(midi_file, 3, 1.5, 0x80, 0x3c, 0x40);
+
+    assert_eq(1.5, midi_file.length, DOUBLE_DELTA);
+})
+
+
+TEST(format_1_file_follows_tempo_changes_of_the_conductor_track, {
+    std::string const data = (
+        header(1, 2, 96)
+        + chunk(
+            "MTrk",
+            bytes({
+                0x00, 0xff, 0x51, 0x03, 0x07, 0xa1, 0x20,   /* 120 BPM */
+                0x60, 0xff, 0x51, 0x03, 0x0f, 0x42, 0x40,   /* 60 BPM */
+                0x00, 0xff, 0x2f, 0x00,
+            })
+        )
+        + chunk(
+            "MTrk",
+            bytes({
+                0x00, 0x91, 0x40, 0x7f,
+                0x60, 0x40, 0x00,                   /* tick 96, at the tempo change */
+                0x60, 0x81, 0x40, 0x00,             /* tick 192 */
+                0x60, 0xff, 0x2f, 0x00,             /* tick 288 */
+            })
+        )
+    );
+    MidiFile midi_file;
+    std::string error;
+
+    assert_true(midi_file.parse(data, error), "error=%s", error.c_str());
+    assert_eq(3, (int)midi_file.events.size());
+
+    assert_event(midi_file, 0, 0.0, 0x91, 0x40, 0x7f);
+    assert_event(midi_file, 1, 0.5, 0x91, 0x40, 0x00);
+    assert_event(midi_file, 2, 1.5, 0x81, 0x40, 0x00);
+
+    assert_eq(2.5, midi_file.length, DOUBLE_DELTA);
+})
+
+
+TEST(meta_and_sysex_events_reset_the_running_status, {
+    std::string const data = (
+        header(0, 1, 96)
+        + chunk(
+            "MTrk",
+            bytes({
+                0x00, 0x90, 0x3c, 0x64,
+                0x00, 0xf0, 0x02, 0x01, 0xf7,       /* sysex */
+                0x00, 0x3c, 0x00,                   /* data without status */
+                0x00, 0xff, 0x2f, 0x00,
+            })
+        )
+    );
+    MidiFile midi_file;
+    std::string error;
+
+    assert_false(midi_file.parse(data, error));
+    assert_eq("data byte without running status", error);
+})
+
+
+TEST(invalid_files_are_rejected, {
+    MidiFile midi_file;
+    std::string error;
+
+    assert_false(midi_file.parse("RIFF", error));
+    assert_eq("not a Standard MIDI File", error);
+
+    assert_false(midi_file.parse(header(2, 1, 96), error));
+    assert_eq("only format 0 and format 1 files are supported", error);
+
+    assert_false(midi_file.parse(header(0, 1, 96), error));
+    assert_eq("missing track", error);
+
+    assert_false(
+        midi_file.parse(
+            header(0, 1, 96) + chunk("MTrk", bytes({0x00, 0x90})).substr(0, 9),
+            error
+        )
+    );
+    assert_eq("truncated chunk", error);
+
+    assert_false(
+        midi_file.parse(
+            header(0, 1, 96) + chunk("MTrk", bytes({0x00, 0x90, 0x3c})),
+            error
+        )
+    );
+    assert_eq("truncated track", error);
+
+    assert_false(
+        midi_file.parse(
+            (
+                header(1, 2, 96)
+                + chunk("MTrk", bytes({0x00, 0x90, 0x3c}))
+                + chunk("MTrk", bytes({0x00, 0xff, 0x2f, 0x00}))
+            ),
+            error
+        )
+    );
+    assert_eq("truncated track", error);
+})
@@ -394,6 +394,110 @@ TEST(custom_waveform_is_updated_before_each_rendering_round, {
 });
 
 
+TEST(oscillators_which_follow_the_same_harmonic_leaders_can_share_the_custom_waveform, {
+    constexpr Frequency sample_rate = 22050.0;
+    constexpr Integer block_size = 2048;
+
+    SumOfSines expected_1(0.5, 440.0, -0.5, 440.0 * 2.0, 0.0, 440.0 * 9.0, 1, 0.0);
+    SumOfSines expected_2(0.5, 440.0, 0.3, 440.0 * 2.0, 0.2, 440.0 * 9.0, 1, (Number)block_size / sample_rate);
+
+    SimpleOscillator::WaveformParam waveform_param("");
+    FloatParamS amplitude("", 0.0, 1.0, 1.0);
+    FloatParamS detune("", Constants::DETUNE_MIN, Constants::DETUNE_MAX, 0.0);
+    FloatParamS fine_detune("", Constants::FINE_DETUNE_MIN, Constants::FINE_DETUNE_MAX, 0.0);
+    FloatParamB harmonic_0("", -1.0, 1.0, 0.5);
+    FloatParamB harmonic_1("", -1.0, 1.0, -0.5);
+    FloatParamB harmonic_2("", -1.0, 1.0, 0.0);
+    FloatParamB harmonic_3("", -1.0, 1.0, 0.0);
+    FloatParamB harmonic_4("", -1.0, 1.0, 0.0);
+    FloatParamB harmonic_5("", -1.0, 1.0, 0.0);
+    FloatParamB harmonic_6("", -1.0, 1.0, 0.0);
+    FloatParamB harmonic_7("", -1.0, 1.0, 0.0);
+    FloatParamB harmonic_8("", -1.0, 1.0, 0.0);
+    FloatParamB harmonic_9("", -1.0, 1.0, 0.0);
+    CustomWaveform custom_waveform(
+        harmonic_0, harmonic_1, harmonic_2, harmonic_3, harmonic_4,
+        harmonic_5, harmonic_6, harmonic_7, harmonic_8, harmonic_9
+    );
+    SimpleOscillator* oscillators[2];
+
+    Buffer actual_output(block_size);
+    Buffer expected_output(block_size);
+
+    expected_1.set_sample_rate(sample_rate);
+    expected_1.set_block_size(block_size);
+
+    expected_2.set_sample_rate(sample_rate);
+    expected_2.set_block_size(block_size);
+
+    waveform_param.set_sample_rate(sample_rate);
+    waveform_param.set_block_size(block_size);
+    waveform_param.set_value(SimpleOscillator::CUSTOM);
+
+    for (Integer i = 0; i != 2; ++i) {
+        oscillators[i] = new SimpleOscillator(
+            waveform_param,
+            amplitude,
+            detune,
+            fine_detune,
+            harmonic_0,
+            harmonic_1,
+            harmonic_2,
+            harmonic_3,
+            harmonic_4,
+            harmonic_5,
+            harmonic_6,
+            harmonic_7,
+            harmonic_8,
+            harmonic_9,
+            NULL,
+            SimpleOscillator::dummy_param,
+            SimpleOscillator::dummy_param,
+            SimpleOscillator::dummy_param,
+            &custom_waveform
+        );
+        oscillators[i]->set_block_size(block_size);
+        oscillators[i]->set_sample_rate(sample_rate);
+        oscillators[i]->frequency.set_value(440.0);
+        oscillators[i]->start(0.0);
+    }
+
+    render_rounds<SumOfSines>(expected_1, expected_output, 1, block_size, 1);
+
+    for (Integer i = 0; i != 2; ++i) {
+        render_rounds<SimpleOscillator>(*oscillators[i], actual_output, 1, block_size, 1);
+        assert_close(
+            expected_output.samples[0],
+            actual_output.samples[0],
+            block_size,
+            0.01,
+            "round=1, oscillator=%d",
+            (int)i
+        );
+    }
+
+    harmonic_1.set_value(0.3);
+    harmonic_8.set_value(0.2);
+
+    render_rounds<SumOfSines>(expected_2, expected_output, 1, block_size, 2);
+
+    for (Integer i = 0; i != 2; ++i) {
+        render_rounds<SimpleOscillator>(*oscillators[i], actual_output, 1, block_size, 2);
+        assert_close(
+            expected_output.samples[0],
+            actual_output.samples[0],
+            block_size,
+            0.01,
+            "round=2, oscillator=%d",
+            (int)i
+        );
+    }
+
+    delete oscillators[0];
+    delete oscillators[1];
+});
+
+
 TEST(sine_chirp_from_100hz_to_400hz, {
     constexpr Frequency start_frequency = 100.0;
     constexpr Frequency end_frequency = 400.0;
@@ -507,6 +611,20 @@ TEST(harmonics_above_the_nyquist_frequency_disappear, {
 })
 
 
+TEST(waveforms_with_many_partials_are_accurate_between_wavetable_levels, {
+    constexpr Frequency frequencies[] = {31.0, 47.0, 73.0, 109.0, 163.0, 251.0};
+
+    for (Integer i = 0; i != 6; ++i) {
+        test_basic_waveform<ReferenceSawtooth>(
+            SimpleOscillator::SAWTOOTH, 0.08, SAMPLE_RATE, frequencies[i], 256, 8
+        );
+        test_basic_waveform<ReferenceSquare>(
+            SimpleOscillator::SQUARE, 0.05, SAMPLE_RATE, frequencies[i], 256, 8
+        );
+    }
+})
+
+
 TEST(frequency_may_be_very_low, {
     test_basic_waveform<ReferenceSawtooth>(
         SimpleOscillator::SAWTOOTH, 0.08, SAMPLE_RATE, 1.0, 1024, 10
@@ -531,12 +649,12 @@ void assert_amplitude_and_frequency_automation_are_independent_of_each_other(
     Sample const* const* block;
     Sample expected_samples[block_size] = {
         /* sin(2 * pi * frequency * time) */
-        amplitudes[0] * std::sin(pi_double * frequency * (0.0 * sample_period)),
-        amplitudes[1] * std::sin(pi_double * frequency * (1.0 * sample_period)),
-        amplitudes[2] * std::sin(pi_double * frequency * (2.0 * sample_period)),
-        amplitudes[3] * std::sin(pi_double * frequency * (3.0 * sample_period)),
-        amplitudes[4] * std::sin(pi_double * frequency * (4.0 * sample_period)),
-        amplitudes[5] * std::sin(pi_double * frequency * (5.0 * sample_period)),
+        (Sample)(amplitudes[0] * std::sin(pi_double * frequency * (0.0 * sample_period))),
+        (Sample)(amplitudes[1] * std::sin(pi_double * frequency * (1.0 * sample_period))),
+        (Sample)(amplitudes[2] * std::sin(pi_double * frequency * (2.0 * sample_period))),
+        (Sample)(amplitudes[3] * std::sin(pi_double * frequency * (3.0 * sample_period))),
+        (Sample)(amplitudes[4] * std::sin(pi_double * frequency * (4.0 * sample_period))),
+        (Sample)(amplitudes[5] * std::sin(pi_double * frequency * (5.0 * sample_period))),
     };
 
     SimpleOscillator::WaveformParam waveform("");
@@ -1202,3 +1320,47 @@ TEST(when_oscillator_is_tempo_synced_then_frequency_is_interpreted_in_terms_of_b
         reference, oscillator, SAMPLE_RATE, block_size, 5, 0.000001, SimpleOscillator::SINE
     );
 });
+
+
+TEST(custom_waveform_can_be_built_outside_the_audio_thread, {
+    FloatParamB harmonic_0("", -1.0, 1.0, 0.5);
+    FloatParamB harmonic_1("", -1.0, 1.0, -0.5);
+    FloatParamB harmonic_2("", -1.0, 1.0, 0.0);
+    FloatParamB harmonic_3("", -1.0, 1.0, 0.0);
+    FloatParamB harmonic_4("", -1.0, 1.0, 0.0);
+    FloatParamB harmonic_5("", -1.0, 1.0, 0.0);
+    FloatParamB harmonic_6("", -1.0, 1.0, 0.0);
+    FloatParamB harmonic_7("", -1.0, 1.0, 0.0);
+    FloatParamB harmonic_8("", -1.0, 1.0, 0.0);
+    FloatParamB harmonic_9("", -1.0, 1.0, 0.0);
+    CustomWaveform custom_waveform(
+        harmonic_0, harmonic_1, harmonic_2, harmonic_3, harmonic_4,
+        harmonic_5, harmonic_6, harmonic_7, harmonic_8, harmonic_9
+    );
+
+    custom_waveform.set_background_building(true);
+
+    custom_waveform.update(1);
+    Wavetable const* const initial_wavetable = custom_waveform.get_wavetable();
+
+    custom_waveform.build();
+    assert_true(initial_wavetable == custom_waveform.get_wavetable());
+
+    custom_waveform.update(2);
+    Wavetable const* const built_wavetable = custom_waveform.get_wavetable();
+    assert_true(initial_wavetable != built_wavetable);
+
+    harmonic_1.set_value(0.3);
+    custom_waveform.update(3);
+    assert_true(built_wavetable == custom_waveform.get_wavetable());
+
+    custom_waveform.build();
+    custom_waveform.update(4);
+    assert_true(built_wavetable != custom_waveform.get_wavetable());
+
+    Wavetable const* const rebuilt_wavetable = custom_waveform.get_wavetable();
+
+    custom_waveform.build();
+    custom_waveform.update(5);
+    assert_true(rebuilt_wavetable == custom_waveform.get_wavetable());
+})
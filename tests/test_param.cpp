@@ -731,6 +731,29 @@ TEST(float_param_linear_ramp_may_start_and_end_between_samples, {
 })
 
 
+TEST(when_event_grid_is_set_then_float_param_ramps_start_at_grid_points_but_end_on_time, {
+    constexpr Integer block_size = 12;
+    constexpr Sample expected_samples[] = {
+        0.0, 0.25, 0.5, 0.5,
+        0.75, 0.875, 1.0, 1.0,
+        1.0, 1.0, 1.0, 1.0,
+    };
+    FloatParamS float_param("float", -1.0, 1.0, 0.0);
+    Sample const* const* rendered_samples;
+
+    float_param.set_sample_rate(1.0);
+    float_param.set_block_size(block_size);
+    float_param.set_value(0.0);
+    float_param.schedule_linear_ramp(2.0, 0.5);
+    float_param.schedule_linear_ramp(4.0, 1.0);
+    float_param.set_event_grid(4);
+
+    rendered_samples = FloatParamS::produce<FloatParamS>(float_param, 1, block_size);
+
+    assert_eq(expected_samples, rendered_samples[0], block_size, DOUBLE_DELTA);
+})
+
+
 TEST(when_float_param_linear_ramp_goes_out_of_bounds_between_samples_then_it_is_clamped, {
     constexpr Integer block_size = 10;
     constexpr Sample expected_samples[] = {
@@ -1086,6 +1109,43 @@ TEST(when_a_float_param_does_have_an_envelope_then_dahds_can_be_applied, {
 })
 
 
+TEST(float_param_envelope_stages_are_rendered_without_events_independently_of_chunk_size, {
+    constexpr Frequency sample_rate = 22050.0;
+    FloatParamS param_1("", -1.0, 1.0, 0.0);
+    FloatParamS param_2("", -1.0, 1.0, 0.0);
+    Envelope envelope("env");
+
+    envelope.amount.set_value(0.9);
+    envelope.initial_value.set_value(0.2);
+    envelope.delay_time.set_value(0.5);
+    envelope.attack_time.set_value(1.0);
+    envelope.peak_value.set_value(1.0);
+    envelope.hold_time.set_value(0.5);
+    envelope.decay_time.set_value(2.0);
+    envelope.sustain_value.set_value(0.6);
+    envelope.release_time.set_value(1.0);
+    envelope.final_value.set_value(0.1);
+
+    param_1.set_sample_rate(sample_rate);
+    param_2.set_sample_rate(sample_rate);
+
+    param_1.set_envelope(&envelope);
+    param_2.set_envelope(&envelope);
+
+    param_1.start_envelope(0.01);
+    param_2.start_envelope(0.01);
+
+    assert_false(param_1.has_events_after(0.01));
+
+    param_1.end_envelope(6.0);
+    param_2.end_envelope(6.0);
+
+    assert_rendering_is_independent_from_chunk_size<FloatParamS>(
+        param_1, param_2, DOUBLE_DELTA
+    );
+})
+
+
 TEST(a_float_param_envelope_may_be_released_before_dahds_is_completed, {
     constexpr Integer block_size = 10;
     constexpr Sample expected_samples[block_size] = {
@@ -1614,6 +1674,48 @@ TEST(float_param_follows_midi_controller_changes_gradually, {
 })
 
 
+TEST(when_a_rounded_float_param_follows_a_midi_controller_then_controller_changes_are_not_coalesced, {
+    constexpr Integer block_size = 1000;
+    constexpr Frequency sample_rate = 1000.0;
+    constexpr Integer changes = 50;
+
+    FloatParamS float_param("float", 0.0, 10.0, 0.0, 1.0);
+    MidiController midi_controller;
+    Sample const* const* rendered_samples;
+
+    midi_controller.set_coalescing_tolerance(0.5 / 127.0);
+    midi_controller.change(0.0, 0.0);
+    midi_controller.clear();
+
+    float_param.set_block_size(block_size);
+    float_param.set_sample_rate(sample_rate);
+    float_param.set_midi_controller(&midi_controller);
+
+    for (Integer i = 0; i != changes + 1; ++i) {
+        midi_controller.change(0.01 * (Seconds)i, (Number)i / (Number)changes);
+    }
+
+    assert_eq((int)changes + 1, (int)midi_controller.events.length());
+
+    rendered_samples = FloatParamS::produce<FloatParamS>(float_param, 1, block_size);
+
+    assert_eq(0.0, rendered_samples[0][5], DOUBLE_DELTA);
+    assert_eq(1.0, rendered_samples[0][55], DOUBLE_DELTA);
+    assert_eq(5.0, rendered_samples[0][255], DOUBLE_DELTA);
+    assert_eq(9.0, rendered_samples[0][455], DOUBLE_DELTA);
+    assert_eq(10.0, rendered_samples[0][555], DOUBLE_DELTA);
+
+    float_param.set_midi_controller(NULL);
+    midi_controller.clear();
+
+    for (Integer i = 0; i != changes + 1; ++i) {
+        midi_controller.change(0.01 * (Seconds)i, (Number)i / (Number)changes);
+    }
+
+    assert_eq(2, (int)midi_controller.events.length());
+})
+
+
 template<class FloatParamClass>
 void test_follower_midi_controller()
 {
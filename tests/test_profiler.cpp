@@ -0,0 +1,167 @@
+/*
+ * This file is part of JS80P, a synthesizer plugin.
+ * Copyright (C) 2023  Attila M. Magyar
+ *
+ * JS80P is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * JS80P is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#define JS80P_PROFILING 1
+
+#include "test.cpp"
+
+#include "js80p.hpp"
+
+#include "dsp/queue.cpp"
+#include "dsp/signal_producer.cpp"
+
+
+using namespace JS80P;
+
+
+class ProfiledChild : public SignalProducer
+{
+    friend class SignalProducer;
+
+    public:
+        ProfiledChild() noexcept : SignalProducer(1, 0)
+        {
+        }
+
+    protected:
+        void render(
+                Integer const round,
+                Integer const first_sample_index,
+                Integer const last_sample_index,
+                Sample** buffer
+        ) noexcept {
+            for (Integer i = first_sample_index; i != last_sample_index; ++i) {
+                buffer[0][i] = 1.0;
+            }
+        }
+};
+
+
+class ProfiledParent : public SignalProducer
+{
+    friend class SignalProducer;
+
+    public:
+        ProfiledParent() noexcept : SignalProducer(1, 1)
+        {
+            register_child(child);
+        }
+
+        ProfiledChild child;
+
+    protected:
+        Sample const* const* initialize_rendering(
+                Integer const round,
+                Integer const sample_count
+        ) noexcept {
+            child_buffer = SignalProducer::produce<ProfiledChild>(
+                child, round, sample_count
+            );
+
+            /* Should be a cache hit. */
+            SignalProducer::produce<ProfiledChild>(child, round, sample_count);
+
+            return NULL;
+        }
+
+        void render(
+                Integer const round,
+                Integer const first_sample_index,
+                Integer const last_sample_index,
+                Sample** buffer
+        ) noexcept {
+            for (Integer i = first_sample_index; i != last_sample_index; ++i) {
+                buffer[0][i] = 2.0 * child_buffer[0][i];
+            }
+        }
+
+    private:
+        Sample const* const* child_buffer;
+};
+
+
+void drain(Profiler::Record* records)
+{
+    Profiler::Record record;
+
+    while (Profiler::pop(record)) {
+        Profiler::Record& total = records[record.node_type];
+
+        total.calls += record.calls;
+        total.cache_hits += record.cache_hits;
+        total.samples += record.samples;
+        total.cycles += record.cycles;
+    }
+}
+
+
+TEST(produce_calls_are_counted_per_signal_producer_class, {
+    constexpr Integer block_size = 128;
+    constexpr Integer rounds = 3;
+
+    Profiler::Record records[Profiler::MAX_NODE_TYPES];
+    ProfiledParent parent;
+
+    parent.set_block_size(block_size);
+
+    for (Integer round = 1; round != rounds + 1; ++round) {
+        SignalProducer::produce<ProfiledParent>(parent, round);
+    }
+
+    drain(records);
+    assert_eq(0, (int)records[Profiler::get_node_type<ProfiledParent>()].calls);
+
+    Profiler::flush();
+    drain(records);
+
+    Integer const parent_type = Profiler::get_node_type<ProfiledParent>();
+    Integer const child_type = Profiler::get_node_type<ProfiledChild>();
+
+    assert_neq((int)parent_type, (int)child_type);
+    assert_true(Profiler::get_node_type_name(parent_type) != NULL);
+    assert_true(Profiler::get_node_type_name(child_type) != NULL);
+
+    assert_eq((int)rounds, (int)records[parent_type].calls);
+    assert_eq(0, (int)records[parent_type].cache_hits);
+    assert_eq((int)(rounds * block_size), (int)records[parent_type].samples);
+
+    assert_eq((int)(2 * rounds), (int)records[child_type].calls);
+    assert_eq((int)rounds, (int)records[child_type].cache_hits);
+    assert_eq((int)(rounds * block_size), (int)records[child_type].samples);
+})
+
+
+TEST(when_the_ring_buffer_is_full_then_records_are_dropped, {
+    Profiler::Record records[Profiler::MAX_NODE_TYPES];
+    ProfiledChild child;
+    Integer round = 1;
+
+    for (size_t i = 0; i != Profiler::RING_BUFFER_SIZE + 10; ++i) {
+        SignalProducer::produce<ProfiledChild>(child, round++);
+        Profiler::flush();
+    }
+
+    assert_eq(10, (int)Profiler::get_dropped_records());
+
+    drain(records);
+
+    assert_eq(
+        (int)Profiler::RING_BUFFER_SIZE,
+        (int)records[Profiler::get_node_type<ProfiledChild>()].calls
+    );
+})
@@ -107,7 +107,16 @@ void test_varaible_size_rounds(RenderMode const mode)
     expected_samples = SignalProducer::produce<SumOfSines>(reference, 1);
 
     for (Integer c = 0; c != channels; ++c) {
-        assert_eq(expected_samples[c], buffer[c], buffer_size, DOUBLE_DELTA);
+        for (Integer i = 0; i != buffer_size; ++i) {
+            assert_eq(
+                expected_samples[c][i],
+                buffer[c][i],
+                SAMPLE_DELTA,
+                "channel=%d, i=%d",
+                (int)c,
+                (int)i
+            );
+        }
     }
 
     for (Integer c = 0; c != channels; ++c) {
@@ -120,3 +129,418 @@ TEST(number_of_samples_to_render_may_vary_between_rounds, {
     test_varaible_size_rounds(OVERWRITE);
     test_varaible_size_rounds(ADD);
 })
+
+
+void render_with_varying_host_buffer_sizes(
+        Synth& synth,
+        Renderer& renderer,
+        Integer const note_on_position,
+        Integer const length,
+        double** buffer
+) {
+    constexpr Integer host_buffer_sizes[] = {
+        1, 16, 300, 7, 128, 64, 1000, 3, 33, 200, 65, 2,
+    };
+    constexpr Integer host_buffer_sizes_count = (
+        sizeof(host_buffer_sizes) / sizeof(Integer)
+    );
+
+    synth.modulator_params.amplitude.set_value(1.0);
+    synth.modulator_params.volume.set_value(1.0);
+    synth.modulator_params.waveform.set_value(SimpleOscillator::SINE);
+    synth.modulator_params.width.set_value(0.0);
+
+    synth.carrier_params.volume.set_value(0.0);
+
+    for (Integer position = 0, i = 0; position != length; ++i) {
+        Integer const sample_count = std::min(
+            host_buffer_sizes[i % host_buffer_sizes_count], length - position
+        );
+        double* batch[Synth::OUT_CHANNELS];
+
+        if (position <= note_on_position && note_on_position < position + sample_count) {
+            synth.note_on(
+                renderer.time_offset(note_on_position - position),
+                1,
+                Midi::NOTE_A_5,
+                127
+            );
+        }
+
+        for (Integer c = 0; c != Synth::OUT_CHANNELS; ++c) {
+            batch[c] = &buffer[c][position];
+        }
+
+        renderer.render<double>(sample_count, batch);
+
+        position += sample_count;
+    }
+}
+
+
+TEST(fixed_size_blocks_are_rendered_with_a_fixed_latency_regardless_of_host_buffer_sizes, {
+    constexpr Integer length = 4096;
+    constexpr Integer host_block_size = 1024;
+    constexpr Integer fixed_block_size = 64;
+    constexpr Integer note_on_position = 500;
+    constexpr Frequency sample_rate = 11025.0;
+
+    Synth reference_synth;
+    Synth synth;
+    Renderer reference_renderer(reference_synth);
+    Renderer renderer(synth, fixed_block_size);
+    double const silence[fixed_block_size] = {};
+    double* expected[Synth::OUT_CHANNELS];
+    double* actual[Synth::OUT_CHANNELS];
+
+    assert_eq(0, (int)reference_renderer.get_latency());
+    assert_eq((int)fixed_block_size, (int)renderer.get_latency());
+    assert_eq(
+        (int)host_block_size,
+        (int)reference_renderer.get_block_size(host_block_size)
+    );
+    assert_eq(
+        (int)fixed_block_size, (int)renderer.get_block_size(host_block_size)
+    );
+
+    reference_synth.set_block_size(host_block_size);
+    reference_synth.set_sample_rate(sample_rate);
+
+    synth.set_block_size(renderer.get_block_size(host_block_size));
+    synth.set_sample_rate(sample_rate);
+
+    for (Integer c = 0; c != Synth::OUT_CHANNELS; ++c) {
+        expected[c] = new double[length];
+        actual[c] = new double[length];
+    }
+
+    render_with_varying_host_buffer_sizes(
+        reference_synth, reference_renderer, note_on_position, length, expected
+    );
+    render_with_varying_host_buffer_sizes(
+        synth, renderer, note_on_position, length, actual
+    );
+
+    for (Integer c = 0; c != Synth::OUT_CHANNELS; ++c) {
+        assert_eq(silence, actual[c], fixed_block_size, DOUBLE_DELTA);
+        assert_gt(std::fabs(expected[c][note_on_position + 100]), 0.01);
+        assert_eq(
+            expected[c],
+            &actual[c][fixed_block_size],
+            length - fixed_block_size,
+            DOUBLE_DELTA
+        );
+    }
+
+    for (Integer c = 0; c != Synth::OUT_CHANNELS; ++c) {
+        delete[] expected[c];
+        delete[] actual[c];
+    }
+})
+
+
+double multiply(double const a, double const b)
+{
+    volatile double const a_ = a;
+    volatile double const b_ = b;
+
+    return a_ * b_;
+}
+
+
+TEST(denormals_are_flushed_to_zero_only_within_the_scope, {
+#ifdef JS80P_HAS_MXCSR
+    constexpr double tiny = 1e-300;
+    constexpr double small = 1e-10;
+
+    unsigned int const original_mode = _mm_getcsr();
+
+    _mm_setcsr(original_mode & ~(0x8000u | 0x0040u));
+
+    assert_gt(multiply(tiny, small), 0.0);
+
+    {
+        ScopedFlushToZero const flush_to_zero;
+
+        assert_eq(0.0, multiply(tiny, small));
+
+        {
+            ScopedFlushToZero const nested_flush_to_zero;
+
+            assert_eq(0.0, multiply(tiny, small));
+        }
+
+        assert_eq(0.0, multiply(tiny, small));
+    }
+
+    assert_gt(multiply(tiny, small), 0.0);
+
+    _mm_setcsr(original_mode);
+#endif
+})
+
+
+TEST(echo_and_reverb_tails_decay_to_silence_without_denormals, {
+    constexpr Frequency sample_rate = 11025.0;
+    constexpr Integer block_size = 256;
+    constexpr Seconds length = 40.0;
+    constexpr Integer rounds = (Integer)(length * sample_rate) / block_size;
+    constexpr Seconds expected_silence = 5.0;
+
+    Synth synth;
+    Renderer renderer(synth);
+    double* buffer[Synth::OUT_CHANNELS];
+    Integer last_non_zero_round = -1;
+    Integer last_non_silent_tail_round = -1;
+
+#ifdef JS80P_HAS_MXCSR
+    /* Hosts may leave denormals enabled for the audio thread. */
+    unsigned int const original_mode = _mm_getcsr();
+
+    _mm_setcsr(original_mode & ~(0x8000u | 0x0040u));
+#endif
+
+    synth.set_block_size(block_size);
+    synth.set_sample_rate(sample_rate);
+
+    synth.effects.echo.wet.set_value(1.0);
+    synth.effects.echo.feedback.set_value(0.5);
+    synth.effects.reverb.wet.set_value(1.0);
+    synth.effects.reverb.room_size.set_value(0.9);
+
+    for (Integer c = 0; c != Synth::OUT_CHANNELS; ++c) {
+        buffer[c] = new double[block_size];
+    }
+
+    synth.note_on(0.0, 1, Midi::NOTE_A_3, 127);
+    synth.note_off(0.1, 1, Midi::NOTE_A_3, 127);
+
+    for (Integer round = 0; round != rounds; ++round) {
+        renderer.render<double>(block_size, buffer);
+
+        /*
+        The output is flushed to zero already, so the state of the effects
+        is checked instead: once their tails are silent, they stop running
+        their feedback loops, so nothing is left to decay into denormals.
+        */
+        if (
+                !synth.effects.echo.is_tail_silent()
+                || !synth.effects.reverb.is_tail_silent()
+        ) {
+            last_non_silent_tail_round = round;
+        }
+
+        for (Integer c = 0; c != Synth::OUT_CHANNELS; ++c) {
+            for (Integer i = 0; i != block_size; ++i) {
+                if (buffer[c][i] != 0.0) {
+                    last_non_zero_round = round;
+                }
+            }
+        }
+    }
+
+#ifdef JS80P_HAS_MXCSR
+    assert_eq((int)(original_mode & ~(0x8000u | 0x0040u)), (int)_mm_getcsr());
+    _mm_setcsr(original_mode);
+#endif
+
+    for (Integer c = 0; c != Synth::OUT_CHANNELS; ++c) {
+        delete[] buffer[c];
+    }
+
+    assert_gt(last_non_zero_round, 0);
+    assert_gt(last_non_silent_tail_round, 0);
+    assert_lte((int)last_non_zero_round, (int)last_non_silent_tail_round);
+    assert_lt(
+        (Seconds)((last_non_silent_tail_round + 1) * block_size) / sample_rate,
+        length - expected_silence
+    );
+    assert_true(synth.effects.echo.is_tail_silent());
+    assert_true(synth.effects.reverb.is_tail_silent());
+})
+
+
+TEST(idle_synth_is_not_rendered_and_its_output_is_reported_as_silent, {
+    constexpr Frequency sample_rate = 11025.0;
+    constexpr Integer block_size = 256;
+    constexpr Integer rounds = (Integer)(40.0 * sample_rate) / block_size;
+
+    Synth synth;
+    Renderer renderer(synth);
+    double* buffer[Synth::OUT_CHANNELS];
+    Integer first_idle_round = -1;
+    Integer last_non_silent_round = -1;
+    bool reported_non_silent_output_as_silent = false;
+    bool rendered_non_zero_while_idle = false;
+
+    synth.set_block_size(block_size);
+    synth.set_sample_rate(sample_rate);
+
+    synth.effects.echo.wet.set_value(1.0);
+    synth.effects.echo.feedback.set_value(0.5);
+    synth.effects.reverb.wet.set_value(1.0);
+    synth.effects.reverb.room_size.set_value(0.9);
+
+    for (Integer c = 0; c != Synth::OUT_CHANNELS; ++c) {
+        buffer[c] = new double[block_size];
+    }
+
+    renderer.render<double>(block_size, buffer);
+
+    assert_true(synth.is_idle());
+    assert_true(renderer.is_silent());
+    assert_eq(0.0, synth.get_tail_length(), DOUBLE_DELTA);
+
+    synth.note_on(0.0, 1, Midi::NOTE_A_3, 127);
+
+    assert_false(synth.is_idle());
+
+    renderer.render<double>(block_size, buffer);
+
+    assert_eq(Synth::INFINITE_TAIL_LENGTH, synth.get_tail_length(), 0.0);
+    assert_eq(Synth::INFINITE_TAIL_LENGTH, synth.get_published_tail_length(), 0.0);
+
+    synth.note_off(0.0, 1, Midi::NOTE_A_3, 127);
+    renderer.render<double>(block_size, buffer);
+
+    assert_lt(synth.get_published_tail_length(), Synth::INFINITE_TAIL_LENGTH);
+    assert_gte(synth.get_published_tail_length(), synth.effects.get_tail_length());
+
+    for (Integer round = 0; round != rounds; ++round) {
+        bool const was_idle = synth.is_idle();
+        bool is_non_silent = false;
+
+        renderer.render<double>(block_size, buffer);
+
+        for (Integer c = 0; c != Synth::OUT_CHANNELS; ++c) {
+            for (Integer i = 0; i != block_size; ++i) {
+                if (std::fabs(buffer[c][i]) > SignalProducer::SILENCE_THRESHOLD) {
+                    is_non_silent = true;
+                }
+
+                if (was_idle && buffer[c][i] != 0.0) {
+                    rendered_non_zero_while_idle = true;
+                }
+            }
+        }
+
+        if (is_non_silent) {
+            last_non_silent_round = round;
+            reported_non_silent_output_as_silent = (
+                reported_non_silent_output_as_silent || renderer.is_silent()
+            );
+        }
+
+        if (first_idle_round == -1 && synth.is_idle()) {
+            first_idle_round = round;
+        }
+    }
+
+    for (Integer c = 0; c != Synth::OUT_CHANNELS; ++c) {
+        delete[] buffer[c];
+    }
+
+    assert_false(reported_non_silent_output_as_silent);
+    assert_false(rendered_non_zero_while_idle);
+    assert_gt((int)last_non_silent_round, 0);
+    assert_gt((int)first_idle_round, (int)last_non_silent_round);
+    assert_lt((int)first_idle_round, (int)rounds - 1);
+    assert_true(synth.is_idle());
+    assert_true(renderer.is_silent());
+    assert_eq(0.0, synth.get_tail_length(), DOUBLE_DELTA);
+    assert_eq(0.0, synth.get_published_tail_length(), DOUBLE_DELTA);
+})
+
+
+TEST(messages_are_processed_and_lfos_keep_running_while_the_synth_is_idle, {
+    constexpr Integer block_size = 128;
+    constexpr Integer rounds = 100;
+
+    Synth synth;
+    Renderer renderer(synth);
+    double* buffer[Synth::OUT_CHANNELS];
+    Number previous_dry = 0.0;
+    Integer dry_changes = 0;
+
+    synth.set_block_size(block_size);
+    synth.resume();
+
+    for (Integer c = 0; c != Synth::OUT_CHANNELS; ++c) {
+        buffer[c] = new double[block_size];
+    }
+
+    synth.push_message(
+        Synth::MessageType::SET_PARAM, Synth::ParamId::L1FRQ, 1.0, 0
+    );
+    synth.push_message(
+        Synth::MessageType::ASSIGN_CONTROLLER,
+        Synth::ParamId::EEDRY,
+        0.0,
+        Synth::ControllerId::LFO_1
+    );
+
+    for (Integer round = 0; round != 20; ++round) {
+        renderer.render<double>(block_size, buffer);
+    }
+
+    assert_true(synth.is_idle());
+    assert_true(renderer.is_silent());
+
+    synth.push_message(
+        Synth::MessageType::SET_PARAM, Synth::ParamId::MVOL, 0.123, 0
+    );
+
+    for (Integer round = 0; round != rounds; ++round) {
+        renderer.render<double>(block_size, buffer);
+
+        Number const dry = synth.effects.echo.dry.get_value();
+
+        if (dry != previous_dry) {
+            ++dry_changes;
+        }
+
+        previous_dry = dry;
+    }
+
+    for (Integer c = 0; c != Synth::OUT_CHANNELS; ++c) {
+        delete[] buffer[c];
+    }
+
+    assert_true(synth.is_idle());
+    assert_true(renderer.is_silent());
+    assert_eq(
+        0.123,
+        synth.modulator_params.volume.get_ratio(),
+        DOUBLE_DELTA
+    );
+    assert_gt((int)dry_changes, (int)rounds / 2);
+})
+
+
+TEST(tail_length_estimate_depends_on_echo_and_reverb_feedback, {
+    Synth synth;
+
+    synth.effects.echo.wet.set_value(0.0);
+    synth.effects.reverb.wet.set_value(0.0);
+
+    assert_eq(0.0, synth.effects.get_tail_length(), DOUBLE_DELTA);
+
+    synth.effects.echo.wet.set_value(1.0);
+    synth.effects.echo.delay_time.set_value(0.5);
+    synth.effects.echo.feedback.set_value(0.25);
+
+    Seconds const short_echo = synth.effects.get_tail_length();
+
+    synth.effects.echo.feedback.set_value(0.9);
+
+    Seconds const long_echo = synth.effects.get_tail_length();
+
+    synth.effects.reverb.wet.set_value(1.0);
+
+    Seconds const echo_and_reverb = synth.effects.get_tail_length();
+
+    /* 0.25^13 is the first repetition below -150 dB. */
+    assert_eq(0.5 * 14.0, short_echo, DOUBLE_DELTA);
+    assert_gt(long_echo, short_echo);
+    assert_gt(echo_and_reverb, long_echo);
+})
@@ -0,0 +1,349 @@
+/*
+ * This file is part of JS80P, a synthesizer plugin.
+ * Copyright (C) 2023  Attila M. Magyar
+ *
+ * JS80P is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * JS80P is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <cmath>
+
+#include "test.cpp"
+#include "utils.cpp"
+
+#include "js80p.hpp"
+
+#include "dsp/biquad_filter.cpp"
+#include "dsp/delay.cpp"
+#include "dsp/effect.cpp"
+#include "dsp/envelope.cpp"
+#include "dsp/filter.cpp"
+#include "dsp/lfo.cpp"
+#include "dsp/macro.cpp"
+#include "dsp/math.cpp"
+#include "dsp/midi_controller.cpp"
+#include "dsp/mixer.cpp"
+#include "dsp/oscillator.cpp"
+#include "dsp/param.cpp"
+#include "dsp/peak_tracker.cpp"
+#include "dsp/queue.cpp"
+#include "dsp/reverb.cpp"
+#include "dsp/side_chain_compressable_effect.cpp"
+#include "dsp/signal_producer.cpp"
+#include "dsp/wavetable.cpp"
+
+
+using namespace JS80P;
+
+
+constexpr Integer CHANNELS = 2;
+constexpr Integer BLOCK_SIZE = 128;
+constexpr Integer ROUNDS = 120;
+constexpr Frequency SAMPLE_RATE = 44100.0;
+
+/* A reverb tail of a few seconds is rendered in each test. */
+constexpr Number TOLERANCE = 0.0001;
+
+
+class Burst : public SignalProducer
+{
+    friend class SignalProducer;
+
+    public:
+        Burst(Integer const length) noexcept
+            : SignalProducer(CHANNELS),
+            length(length),
+            rendered_samples(0)
+        {
+        }
+
+    protected:
+        void render(
+                Integer const round,
+                Integer const first_sample_index,
+                Integer const last_sample_index,
+                Sample** buffer
+        ) noexcept {
+            for (Integer i = first_sample_index; i != last_sample_index; ++i) {
+                Number const time = (Number)rendered_samples * sampling_period;
+                Sample const sample = (
+                    rendered_samples < length
+                        ? (Sample)(
+                            0.3 * std::sin(Math::PI_DOUBLE * 220.0 * time)
+                            + 0.2 * std::sin(Math::PI_DOUBLE * 1320.0 * time)
+                            + 0.1 * std::sin(Math::PI_DOUBLE * 5280.0 * time)
+                        )
+                        : 0.0
+                );
+
+                buffer[0][i] = sample;
+                buffer[1][i] = -sample;
+
+                ++rendered_samples;
+            }
+        }
+
+    private:
+        Integer const length;
+        Integer rendered_samples;
+};
+
+
+typedef Reverb<Burst> Reverb_;
+
+
+/*
+The reverb used to be built from separate HighShelfPannedDelay objects mixed
+together, and the fused comb filters of Reverb must sound the same.
+*/
+class ReferenceReverb
+{
+    public:
+        typedef BiquadFilter<Burst> HighPassedInput;
+        typedef HighShelfPannedDelay<HighPassedInput> CombFilter;
+
+        ReferenceReverb(Burst& input)
+            : room_size("", 0.0, 0.999, 0.75),
+            damping_frequency(
+                "",
+                Constants::BIQUAD_FILTER_FREQUENCY_MIN,
+                Constants::BIQUAD_FILTER_FREQUENCY_MAX,
+                Constants::BIQUAD_FILTER_FREQUENCY_DEFAULT
+            ),
+            damping_gain("", -36.0, -0.01, -6.0),
+            width("", -1.0, 1.0, 0.0),
+            high_pass_frequency(
+                "",
+                Constants::BIQUAD_FILTER_FREQUENCY_MIN,
+                Constants::BIQUAD_FILTER_FREQUENCY_MAX,
+                20.0
+            ),
+            mixer(CHANNELS),
+            high_pass_filter_type(""),
+            high_pass_filter_q("", 0.0, 5.0, 1.0),
+            high_pass_filter_gain("", -48.0, 48.0, 0.0),
+            high_pass_filter(
+                input,
+                high_pass_filter_type,
+                high_pass_frequency,
+                high_pass_filter_q,
+                high_pass_filter_gain
+            )
+        {
+            for (size_t i = 0; i != Reverb_::COMB_FILTERS; ++i) {
+                comb_filters[i] = new CombFilter(
+                    high_pass_filter,
+                    PannedDelayStereoMode::NORMAL,
+                    width,
+                    room_size,
+                    0.1,
+                    Reverb_::DELAY_TIME_MAX,
+                    damping_frequency,
+                    damping_gain
+                );
+                comb_filters[i]->delay.set_feedback_signal_producer(
+                    &comb_filters[i]->high_shelf_filter
+                );
+                comb_filters[i]->high_shelf_filter.set_shared_cache(
+                    &high_shelf_filter_shared_cache
+                );
+                mixer.add(*comb_filters[i]);
+            }
+
+            high_pass_filter_type.set_value(HighPassedInput::HIGH_PASS);
+        }
+
+        ~ReferenceReverb()
+        {
+            for (size_t i = 0; i != Reverb_::COMB_FILTERS; ++i) {
+                delete comb_filters[i];
+            }
+        }
+
+        void set_up(
+                Reverb_& reverb,
+                Reverb_::Type const type,
+                Frequency const sample_rate,
+                Integer const block_size
+        ) {
+            FloatParamS* const params[] = {
+                &room_size,
+                &damping_frequency,
+                &damping_gain,
+                &width,
+                &high_pass_frequency,
+            };
+            FloatParamS const* const reverb_params[] = {
+                &reverb.room_size,
+                &reverb.damping_frequency,
+                &reverb.damping_gain,
+                &reverb.width,
+                &reverb.high_pass_frequency,
+            };
+
+            for (Integer i = 0; i != 5; ++i) {
+                params[i]->set_sample_rate(sample_rate);
+                params[i]->set_block_size(block_size);
+                params[i]->set_value(reverb_params[i]->get_value());
+            }
+
+            high_pass_filter.set_sample_rate(sample_rate);
+            high_pass_filter.set_block_size(block_size);
+            mixer.set_sample_rate(sample_rate);
+            mixer.set_block_size(block_size);
+
+            for (size_t i = 0; i != Reverb_::COMB_FILTERS; ++i) {
+                comb_filters[i]->set_sample_rate(sample_rate);
+                comb_filters[i]->set_block_size(block_size);
+                Reverb_::Tuning const& tuning = Reverb_::TUNINGS[type][i];
+
+                comb_filters[i]->delay.time.set_value(tuning.delay_time);
+                comb_filters[i]->set_panning_scale(tuning.panning_scale);
+                mixer.set_weight(i, tuning.weight);
+            }
+        }
+
+        FloatParamS room_size;
+        FloatParamS damping_frequency;
+        FloatParamS damping_gain;
+        FloatParamS width;
+        FloatParamS high_pass_frequency;
+
+        Mixer<CombFilter> mixer;
+
+    private:
+        HighPassedInput::TypeParam high_pass_filter_type;
+        FloatParamS high_pass_filter_q;
+        FloatParamS high_pass_filter_gain;
+        BiquadFilterSharedCache high_shelf_filter_shared_cache;
+        HighPassedInput high_pass_filter;
+        CombFilter* comb_filters[Reverb_::COMB_FILTERS];
+};
+
+
+void set_up_reverb(
+        Reverb_& reverb,
+        Reverb_::Type const type,
+        Frequency const sample_rate,
+        Integer const block_size
+) {
+    reverb.set_sample_rate(sample_rate);
+    reverb.set_block_size(block_size);
+    reverb.type.set_value(type);
+    reverb.room_size.set_value(0.85);
+    reverb.damping_frequency.set_value(3000.0);
+    reverb.damping_gain.set_value(-9.0);
+    reverb.width.set_value(0.7);
+    reverb.high_pass_frequency.set_value(120.0);
+    reverb.dry.set_value(0.0);
+    reverb.wet.set_value(1.0);
+}
+
+
+void render(
+        Reverb_& reverb,
+        ReferenceReverb& reference,
+        Buffer& actual,
+        Buffer& expected,
+        Integer const rounds,
+        Integer const block_size
+) {
+    Sample* mix[CHANNELS];
+
+    for (Integer round = 0; round != rounds; ++round) {
+        Integer const offset = round * block_size;
+        Sample const* const* const block = (
+            SignalProducer::produce<Reverb_>(reverb, round, block_size)
+        );
+
+        for (Integer c = 0; c != CHANNELS; ++c) {
+            std::copy_n(block[c], block_size, &actual.samples[c][offset]);
+            mix[c] = &expected.samples[c][offset];
+        }
+
+        reference.mixer.set_output_buffer(mix);
+        SignalProducer::produce< Mixer<ReferenceReverb::CombFilter> >(
+            reference.mixer, round, block_size
+        );
+    }
+}
+
+
+void test_reverb_type(
+        Reverb_::Type const type,
+        Frequency const sample_rate,
+        Integer const block_size,
+        Integer const rounds,
+        bool const has_param_changes = false
+) {
+    /* The input stops after a while, so that the tail is tested as well. */
+    Integer const burst_length = (Integer)(sample_rate * 0.2);
+    Integer const sample_count = block_size * rounds;
+    Burst input_1(burst_length);
+    Burst input_2(burst_length);
+    Reverb_ reverb("R", input_1);
+    ReferenceReverb reference(input_2);
+    Buffer expected(sample_count, CHANNELS);
+    Buffer actual(sample_count, CHANNELS);
+
+    input_1.set_sample_rate(sample_rate);
+    input_1.set_block_size(block_size);
+    input_2.set_sample_rate(sample_rate);
+    input_2.set_block_size(block_size);
+
+    set_up_reverb(reverb, type, sample_rate, block_size);
+    reference.set_up(reverb, type, sample_rate, block_size);
+
+    /*
+    The ramps last longer than the test, because the separate delays used to
+    notice the end of a ramp one block late, except for the first one.
+    */
+    if (has_param_changes) {
+        reverb.room_size.schedule_linear_ramp(0.5, 0.6);
+        reverb.width.schedule_linear_ramp(0.6, -0.8);
+        reverb.damping_frequency.schedule_linear_ramp(0.7, 8000.0);
+
+        reference.room_size.schedule_linear_ramp(0.5, 0.6);
+        reference.width.schedule_linear_ramp(0.6, -0.8);
+        reference.damping_frequency.schedule_linear_ramp(0.7, 8000.0);
+    }
+
+    render(reverb, reference, actual, expected, rounds, block_size);
+
+    for (Integer c = 0; c != CHANNELS; ++c) {
+        assert_eq(
+            expected.samples[c],
+            actual.samples[c],
+            sample_count,
+            TOLERANCE,
+            "type=%d, channel=%d",
+            (int)type,
+            (int)c
+        );
+    }
+}
+
+
+TEST(fused_comb_filters_sound_the_same_as_separate_delays, {
+    for (Reverb_::Type type = 0; type != Reverb_::REVERB_10 + 1; ++type) {
+        test_reverb_type(type, SAMPLE_RATE, BLOCK_SIZE, ROUNDS);
+        test_reverb_type(type, 48000.0, 2048, 8);
+    }
+})
+
+
+TEST(fused_comb_filters_follow_parameter_changes, {
+    for (Reverb_::Type type = 0; type != Reverb_::REVERB_10 + 1; ++type) {
+        test_reverb_type(type, SAMPLE_RATE, BLOCK_SIZE, ROUNDS, true);
+    }
+})
@@ -0,0 +1,162 @@
+/*
+ * This file is part of JS80P, a synthesizer plugin.
+ * Copyright (C) 2023  Attila M. Magyar
+ *
+ * JS80P is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * JS80P is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/*
+This file is compiled twice: once normally, and once as a variant with
+JS80P_FLOAT_SAMPLES defined and with the JS80P namespace renamed to
+JS80PFloatSamples, so that both the single and the double precision build of
+the synthesizer can be linked into the same test binary.
+*/
+
+#include <cmath>
+
+#ifndef JS80P_TEST_FLOAT_SAMPLES_VARIANT
+#include "test.cpp"
+#include "utils.cpp"
+#endif
+
+#include "js80p.hpp"
+#include "midi.hpp"
+
+#include "synth.cpp"
+
+
+namespace JS80P
+{
+
+void render_sample_precision_test_patch(
+        Number** const buffer,
+        Integer const rounds,
+        Integer const block_size
+) {
+    Synth synth;
+
+    synth.set_sample_rate(44100.0);
+    synth.set_block_size(block_size);
+    synth.resume();
+
+    synth.process_message(
+        Synth::MessageType::SET_PARAM,
+        Synth::ParamId::CWAV,
+        synth.carrier_params.waveform.value_to_ratio(SimpleOscillator::SAWTOOTH),
+        0
+    );
+    synth.process_message(Synth::MessageType::SET_PARAM, Synth::ParamId::CF1FRQ, 0.6, 0);
+    synth.process_message(Synth::MessageType::SET_PARAM, Synth::ParamId::CF1Q, 0.3, 0);
+    synth.process_message(Synth::MessageType::SET_PARAM, Synth::ParamId::ECWET, 0.4, 0);
+    synth.process_message(Synth::MessageType::SET_PARAM, Synth::ParamId::EEWET, 0.4, 0);
+    synth.process_message(Synth::MessageType::SET_PARAM, Synth::ParamId::ERWET, 0.4, 0);
+
+    synth.note_on(0.0, 1, Midi::NOTE_A_2, 100);
+    synth.note_on(0.0, 1, Midi::NOTE_E_3, 100);
+    synth.note_on(0.0, 1, Midi::NOTE_C_4, 100);
+    synth.note_on(0.0, 1, Midi::NOTE_G_5, 100);
+    synth.note_off(1.0, 1, Midi::NOTE_A_2, 64);
+    synth.note_off(1.0, 1, Midi::NOTE_E_3, 64);
+    synth.note_off(1.0, 1, Midi::NOTE_C_4, 64);
+    synth.note_off(1.0, 1, Midi::NOTE_G_5, 64);
+
+    for (Integer round = 0; round != rounds; ++round) {
+        Sample const* const* const block = synth.generate_samples(
+            round, block_size
+        );
+        Integer const offset = round * block_size;
+
+        for (Integer c = 0; c != Synth::OUT_CHANNELS; ++c) {
+            for (Integer i = 0; i != block_size; ++i) {
+                buffer[c][offset + i] = (Number)block[c][i];
+            }
+        }
+    }
+}
+
+}
+
+
+#ifndef JS80P_TEST_FLOAT_SAMPLES_VARIANT
+
+namespace JS80PFloatSamples
+{
+
+void render_sample_precision_test_patch(
+    JS80P::Number** const buffer,
+    JS80P::Integer const rounds,
+    JS80P::Integer const block_size
+);
+
+}
+
+
+using namespace JS80P;
+
+
+constexpr Number MAX_FLOAT_SAMPLES_ERROR_DB = -50.0;
+
+
+TEST(rendering_with_float_samples_stays_close_to_rendering_with_double_samples, {
+    constexpr Integer block_size = 256;
+    constexpr Integer rounds = 600;
+    constexpr Integer sample_count = block_size * rounds;
+
+    /*
+    Not using Buffer, because its samples would be single precision when the
+    tests themselves are built with float samples.
+    */
+    Number* expected[Synth::OUT_CHANNELS];
+    Number* actual[Synth::OUT_CHANNELS];
+
+    for (Integer c = 0; c != Synth::OUT_CHANNELS; ++c) {
+        expected[c] = new Number[sample_count];
+        actual[c] = new Number[sample_count];
+    }
+
+    JS80P::render_sample_precision_test_patch(expected, rounds, block_size);
+    JS80PFloatSamples::render_sample_precision_test_patch(
+        actual, rounds, block_size
+    );
+
+    for (Integer c = 0; c != Synth::OUT_CHANNELS; ++c) {
+        Number signal_energy = 0.0;
+        Number error_energy = 0.0;
+
+        for (Integer i = 0; i != sample_count; ++i) {
+            Number const error = actual[c][i] - expected[c][i];
+
+            signal_energy += expected[c][i] * expected[c][i];
+            error_energy += error * error;
+        }
+
+        Number const error_db = 10.0 * std::log10(error_energy / signal_energy);
+
+        assert_gt(signal_energy, 1.0);
+        assert_lt(
+            error_db,
+            MAX_FLOAT_SAMPLES_ERROR_DB,
+            "channel=%d, error=%f dB",
+            (int)c,
+            error_db
+        );
+    }
+
+    for (Integer c = 0; c != Synth::OUT_CHANNELS; ++c) {
+        delete[] expected[c];
+        delete[] actual[c];
+    }
+})
+
+#endif
@@ -314,13 +314,13 @@ TEST(toggle_params_are_loaded_before_other_params, {
     Serializer::import_patch_in_audio_thread(synth, patch);
 
     assert_eq(
-        ToggleParam::ON, synth.modulator_params.filter_1_log_scale.get_value(), DOUBLE_DELTA
+        (int)ToggleParam::ON, (int)synth.modulator_params.filter_1_log_scale.get_value()
     );
     assert_eq(
         1928.2, synth.modulator_params.filter_1_frequency.get_value(), 19.282
     );
     assert_eq(
-        ToggleParam::OFF, synth.modulator_params.filter_2_log_scale.get_value(), DOUBLE_DELTA
+        (int)ToggleParam::OFF, (int)synth.modulator_params.filter_2_log_scale.get_value()
     );
     assert_eq(
         18000.0, synth.modulator_params.filter_2_frequency.get_value(), 1.0
@@ -328,6 +328,270 @@ TEST(toggle_params_are_loaded_before_other_params, {
 })
 
 
+TEST(compiled_patch_can_be_imported_inside_the_audio_thread, {
+    Synth synth;
+    Serializer::Messages messages;
+    std::string const patch = (
+        "[js80p]\n"
+        "MF1FRQ = 0.75\n"
+        "PM = 0.42\n"
+        "MF1LOG = 1\n"
+        "CVOLctl = 0.5\n"
+    );
+
+    Serializer::compile_patch(synth, patch, messages);
+
+    assert_eq(4, (int)messages.size());
+    assert_eq((int)Synth::ParamId::MF1LOG, (int)messages[0].param_id);
+
+    synth.process_message(
+        Synth::MessageType::SET_PARAM, Synth::ParamId::MVOL, 0.123, 0
+    );
+    Serializer::import_patch_in_audio_thread(synth, messages);
+
+    assert_eq(
+        (int)ToggleParam::ON, (int)synth.modulator_params.filter_1_log_scale.get_value()
+    );
+    assert_eq(
+        1928.2, synth.modulator_params.filter_1_frequency.get_value(), 19.282
+    );
+    assert_eq(
+        0.42, synth.get_param_ratio_atomic(Synth::ParamId::PM), DOUBLE_DELTA
+    );
+    assert_eq(
+        Synth::ControllerId::PITCH_WHEEL,
+        synth.get_param_controller_id_atomic(Synth::ParamId::CVOL)
+    );
+    assert_eq(
+        synth.get_param_default_ratio(Synth::ParamId::MVOL),
+        synth.get_param_ratio_atomic(Synth::ParamId::MVOL),
+        DOUBLE_DELTA
+    );
+})
+
+
+TEST(compiling_the_state_of_the_synth_is_the_same_as_compiling_its_serialized_form, {
+    Synth synth;
+    Serializer::Messages expected;
+    Serializer::Messages actual;
+
+    synth.process_message(
+        Synth::MessageType::SET_PARAM, Synth::ParamId::MF1FRQ, 0.75, 0
+    );
+    synth.process_message(
+        Synth::MessageType::SET_PARAM, Synth::ParamId::MF1LOG, 1.0, 0
+    );
+    synth.process_message(
+        Synth::MessageType::SET_PARAM, Synth::ParamId::PM, 0.42, 0
+    );
+    synth.process_message(
+        Synth::MessageType::ASSIGN_CONTROLLER,
+        Synth::ParamId::CVOL,
+        0.0,
+        Synth::ControllerId::MACRO_1
+    );
+
+    Serializer::compile_patch(synth, Serializer::serialize(synth), expected);
+
+    actual.reserve(Synth::ParamId::MAX_PARAM_ID);
+    Serializer::compile_patch(synth, actual);
+
+    assert_eq((int)expected.size(), (int)actual.size());
+
+    for (size_t i = 0; i != expected.size(); ++i) {
+        assert_eq((int)expected[i].type, (int)actual[i].type, "i=%d", (int)i);
+        assert_eq((int)expected[i].param_id, (int)actual[i].param_id, "i=%d", (int)i);
+        assert_eq(expected[i].number_param, actual[i].number_param, DOUBLE_DELTA, "i=%d", (int)i);
+        assert_eq((int)expected[i].byte_param, (int)actual[i].byte_param, "i=%d", (int)i);
+    }
+})
+
+
+TEST(compiled_state_of_the_synth_can_be_turned_back_into_text, {
+    Synth synth;
+    Serializer::Messages messages;
+
+    synth.process_message(
+        Synth::MessageType::SET_PARAM, Synth::ParamId::MF1FRQ, 0.75, 0
+    );
+    synth.process_message(
+        Synth::MessageType::SET_PARAM, Synth::ParamId::MF1LOG, 1.0, 0
+    );
+    synth.process_message(
+        Synth::MessageType::SET_PARAM, Synth::ParamId::PM, 0.42, 0
+    );
+    synth.process_message(
+        Synth::MessageType::ASSIGN_CONTROLLER,
+        Synth::ParamId::CVOL,
+        0.0,
+        Synth::ControllerId::MACRO_1
+    );
+
+    Serializer::compile_patch(synth, messages);
+
+    assert_eq(Serializer::serialize(synth), Serializer::serialize(synth, messages));
+})
+
+
+void set_up_binary_patch_test_synth(Synth& synth)
+{
+    synth.process_message(
+        Synth::MessageType::SET_PARAM, Synth::ParamId::MF1FRQ, 0.75, 0
+    );
+    synth.process_message(
+        Synth::MessageType::SET_PARAM, Synth::ParamId::MF1LOG, 1.0, 0
+    );
+    synth.process_message(
+        Synth::MessageType::SET_PARAM, Synth::ParamId::PM, 0.123456789, 0
+    );
+    synth.process_message(
+        Synth::MessageType::ASSIGN_CONTROLLER,
+        Synth::ParamId::CVOL,
+        0.0,
+        Synth::ControllerId::MACRO_1
+    );
+}
+
+
+void assert_same_params(Synth const& expected, Synth const& actual)
+{
+    for (int i = 0; i != Synth::ParamId::MAX_PARAM_ID; ++i) {
+        Synth::ParamId const param_id = (Synth::ParamId)i;
+
+        assert_eq(
+            (int)expected.get_param_controller_id_atomic(param_id),
+            (int)actual.get_param_controller_id_atomic(param_id),
+            "param=%s",
+            expected.get_param_name(param_id).c_str()
+        );
+
+        if (expected.get_param_controller_id_atomic(param_id) == Synth::ControllerId::NONE) {
+            assert_eq(
+                expected.get_param_ratio_atomic(param_id),
+                actual.get_param_ratio_atomic(param_id),
+                DOUBLE_DELTA,
+                "param=%s",
+                expected.get_param_name(param_id).c_str()
+            );
+        }
+    }
+}
+
+
+TEST(binary_patch_can_be_imported, {
+    Synth expected;
+    Synth actual;
+
+    set_up_binary_patch_test_synth(expected);
+
+    std::string const patch = Serializer::serialize_binary(expected);
+
+    assert_true(Serializer::is_binary(patch));
+    assert_false(Serializer::is_binary(Serializer::serialize(expected)));
+    assert_lt((int)patch.length(), (int)Serializer::MAX_SIZE);
+
+    actual.process_message(
+        Synth::MessageType::SET_PARAM, Synth::ParamId::AM, 0.42, 0
+    );
+    Serializer::import_patch_in_audio_thread(actual, patch);
+
+    assert_same_params(expected, actual);
+})
+
+
+TEST(when_param_layout_of_binary_patch_is_different_then_params_are_looked_up_by_name, {
+    Synth expected;
+    Synth actual;
+
+    set_up_binary_patch_test_synth(expected);
+
+    std::string patch = Serializer::serialize_binary(expected);
+
+    /* Corrupt the layout hash which is stored right before program_count. */
+    patch[Serializer::BINARY_HEADER_SIZE - sizeof(uint32_t) - 1] ^= 0x55;
+
+    Serializer::import_patch_in_audio_thread(actual, patch);
+
+    assert_same_params(expected, actual);
+})
+
+
+TEST(binary_patch_contains_only_the_compiled_params, {
+    Synth synth;
+    Serializer::Messages messages;
+    Serializer::BinaryPrograms programs;
+
+    set_up_binary_patch_test_synth(synth);
+    Serializer::compile_patch(synth, messages);
+
+    std::string const patch = Serializer::serialize_binary(synth, "Named", messages);
+
+    assert_true(Serializer::parse_binary(synth, patch, programs));
+    assert_eq(1, (int)programs.size());
+    assert_eq("Named", programs[0].name);
+    assert_eq((int)messages.size(), (int)programs[0].messages.size());
+
+    for (size_t i = 0; i != messages.size(); ++i) {
+        Synth::Message const& message = programs[0].messages[i];
+
+        assert_eq((int)messages[i].type, (int)message.type, "i=%d", (int)i);
+        assert_eq((int)messages[i].param_id, (int)message.param_id, "i=%d", (int)i);
+        assert_eq(messages[i].number_param, message.number_param, DOUBLE_DELTA, "i=%d", (int)i);
+        assert_eq((int)messages[i].byte_param, (int)message.byte_param, "i=%d", (int)i);
+    }
+
+    assert_true(Serializer::parse_binary_names(patch, programs));
+    assert_eq(1, (int)programs.size());
+    assert_eq("Named", programs[0].name);
+    assert_eq(0, (int)programs[0].messages.size());
+})
+
+
+void assert_damaged_binary_patch_is_ignored(std::string const& patch)
+{
+    Synth synth;
+    Serializer::Messages messages;
+
+    synth.process_message(
+        Synth::MessageType::SET_PARAM, Synth::ParamId::AM, 0.42, 0
+    );
+
+    assert_true(Serializer::is_binary(patch));
+    assert_false(Serializer::compile_patch(synth, patch, messages));
+    assert_eq(0, (int)messages.size());
+
+    Serializer::import_patch_in_audio_thread(synth, patch);
+
+    assert_eq(0.42, synth.get_param_ratio_atomic(Synth::ParamId::AM), DOUBLE_DELTA);
+}
+
+
+TEST(when_binary_patch_is_truncated_then_it_is_ignored, {
+    Synth synth;
+
+    set_up_binary_patch_test_synth(synth);
+
+    std::string patch = Serializer::serialize_binary(synth);
+
+    patch.resize(patch.length() - 1);
+
+    assert_damaged_binary_patch_is_ignored(patch);
+})
+
+
+TEST(when_binary_patch_has_unknown_version_then_it_is_ignored, {
+    Synth synth;
+
+    set_up_binary_patch_test_synth(synth);
+
+    std::string patch = Serializer::serialize_binary(synth);
+
+    patch[sizeof(Serializer::BINARY_MAGIC)] = (char)(Serializer::BINARY_VERSION + 1);
+
+    assert_damaged_binary_patch_is_ignored(patch);
+})
+
+
 TEST(param_names_are_parsed_case_insensitively_and_converted_to_upper_case, {
     Synth synth;
     std::string const patch = (
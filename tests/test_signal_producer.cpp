@@ -1059,6 +1059,60 @@ TEST(event_scheduling_is_relative_to_current_time, {
 })
 
 
+class QuantizingEventTestSignalProducer : public EventTestSignalProducer
+{
+    friend class SignalProducer;
+
+    public:
+        static constexpr Event::Type CRITICAL_SET_VALUE = 2;
+
+        void schedule_critical(Seconds const time_offset, Number const param) noexcept
+        {
+            SignalProducer::schedule(CRITICAL_SET_VALUE, time_offset, 0, param, param);
+        }
+
+    protected:
+        bool is_event_time_critical(Event::Type const type) const noexcept
+        {
+            return type == CRITICAL_SET_VALUE;
+        }
+
+        void handle_event(Event const& event) noexcept
+        {
+            value = event.number_param_1;
+        }
+};
+
+
+TEST(non_critical_events_may_be_postponed_to_the_next_grid_point, {
+    constexpr Integer block_size = 16;
+    constexpr Sample expected_samples[] = {
+        0.0, 0.0, 0.0, 0.0,
+        1.0, 1.0, 3.0, 3.0,
+        3.0, 3.0, 3.0, 3.0,
+        4.0, 4.0, 4.0, 4.0,
+    };
+    QuantizingEventTestSignalProducer signal_producer;
+    Sample const* const* rendered;
+
+    signal_producer.set_sample_rate(10.0);
+    signal_producer.set_block_size(block_size);
+    signal_producer.set_event_grid(4);
+
+    signal_producer.schedule(0.1, 1.0);
+    signal_producer.schedule(0.5, 2.0);
+    signal_producer.schedule_critical(0.6, 3.0);
+    signal_producer.schedule(0.9, 4.0);
+
+    rendered = SignalProducer::produce<QuantizingEventTestSignalProducer>(
+        signal_producer, 1, block_size
+    );
+
+    assert_eq(expected_samples, rendered[0], block_size, DOUBLE_DELTA);
+    assert_eq(4, signal_producer.render_calls);
+})
+
+
 TEST(can_tell_if_the_last_buffer_was_silent, {
     constexpr Integer block_size = 1024;
     constexpr Frequency sample_rate = 48000.0;
@@ -154,3 +154,83 @@ TEST(queue_can_be_filled_and_emptied_multiple_times, {
 
     }
 })
+
+
+TEST(capacity_does_not_need_to_be_a_power_of_two, {
+    constexpr size_t size = 5;
+
+    SPSCQueue<std::string> q(size);
+    std::string str("a");
+
+    for (int i = 0; i != 10; ++i) {
+        char c = 'a';
+
+        for (size_t j = 0; j != size; ++j, ++c) {
+            str[0] = c;
+            assert_true(q.push(str));
+        }
+
+        assert_false(q.push("x"));
+        assert_eq((int)size, (int)q.length());
+
+        c = 'a';
+
+        for (size_t j = 0; j != size; ++j, ++c) {
+            assert_true(q.pop(str));
+            assert_eq(c, str[0]);
+        }
+
+        assert_true(q.is_empty());
+    }
+})
+
+
+TEST(items_can_be_pushed_and_popped_in_bulk, {
+    SPSCQueue<std::string> q(5);
+    std::string const items[] = {"a", "b", "c", "d", "e", "f", "g"};
+    std::string popped[7];
+
+    assert_eq(0, (int)q.pop_bulk(popped, 7));
+
+    assert_eq(3, (int)q.push_bulk(items, 3));
+    assert_eq(3, (int)q.length());
+
+    assert_eq(2, (int)q.pop_bulk(popped, 2));
+    assert_eq("a", popped[0]);
+    assert_eq("b", popped[1]);
+
+    assert_eq(4, (int)q.push_bulk(&items[3], 4));
+    assert_eq(5, (int)q.length());
+    assert_eq(0, (int)q.push_bulk(items, 1));
+    assert_false(q.push("x"));
+
+    assert_eq(5, (int)q.pop_bulk(popped, 7));
+    assert_eq("c", popped[0]);
+    assert_eq("d", popped[1]);
+    assert_eq("e", popped[2]);
+    assert_eq("f", popped[3]);
+    assert_eq("g", popped[4]);
+    assert_true(q.is_empty());
+})
+
+
+TEST(bulk_and_single_item_operations_can_be_mixed, {
+    SPSCQueue<std::string> q(4);
+    std::string const items[] = {"b", "c"};
+    std::string popped[4];
+    std::string item;
+
+    for (int i = 0; i != 10; ++i) {
+        assert_true(q.push("a"));
+        assert_eq(2, (int)q.push_bulk(items, 2));
+        assert_true(q.push("d"));
+
+        assert_true(q.pop(item));
+        assert_eq("a", item);
+        assert_eq(3, (int)q.pop_bulk(popped, 4));
+        assert_eq("b", popped[0]);
+        assert_eq("c", popped[1]);
+        assert_eq("d", popped[2]);
+        assert_false(q.pop(item));
+    }
+})
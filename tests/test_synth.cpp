@@ -52,6 +52,7 @@ constexpr Synth::MessageType SET_PARAM = Synth::MessageType::SET_PARAM;
 constexpr Synth::MessageType REFRESH_PARAM = Synth::MessageType::REFRESH_PARAM;
 constexpr Synth::MessageType ASSIGN_CONTROLLER = Synth::MessageType::ASSIGN_CONTROLLER;
 constexpr Synth::MessageType CLEAR = Synth::MessageType::CLEAR;
+constexpr Synth::MessageType SET_EVENT_GRID = Synth::MessageType::SET_EVENT_GRID;
 
 
 constexpr Integer PEAK_CTL_TEST_BLOCK_SIZE = 8192;
@@ -60,6 +61,16 @@ constexpr Number PEAK_CTL_TEST_OSC_2_VOL = 0.6;
 constexpr Number PEAK_CTL_TEST_FILTER_1_GAIN = -6.0;
 constexpr Number PEAK_CTL_TEST_REVERB_DRY = 0.1;
 
+/*
+The 1 Hz high-shelf filter of the peak controller test is ill-conditioned with
+single precision coefficients.
+*/
+#ifdef JS80P_FLOAT_SAMPLES
+constexpr Number PEAK_CTL_TEST_TOLERANCE = 0.01;
+#else
+constexpr Number PEAK_CTL_TEST_TOLERANCE = 0.005;
+#endif
+
 
 TEST(communication_with_the_gui_is_lock_free, {
     Synth synth;
@@ -133,6 +144,119 @@ void assign_controller(
 }
 
 
+void set_up_multi_threaded_rendering_test(Synth& synth)
+{
+    synth.set_sample_rate(22050.0);
+    synth.set_block_size(256);
+    synth.resume();
+
+    set_param(synth, Synth::ParamId::MF1FRQ, 0.6);
+    set_param(synth, Synth::ParamId::CF2FRQ, 0.5);
+    set_param(synth, Synth::ParamId::CF2Q, 0.4);
+    set_param(synth, Synth::ParamId::M1IN, 0.7);
+    set_param(synth, Synth::ParamId::N1DYN, 1.0);
+
+    assign_controller(synth, Synth::ParamId::MF1FRQ, Synth::ControllerId::LFO_1);
+    assign_controller(synth, Synth::ParamId::CF2Q, Synth::ControllerId::MACRO_1);
+    assign_controller(synth, Synth::ParamId::CF1FRQ, Synth::ControllerId::ENVELOPE_1);
+
+    synth.process_messages();
+
+    synth.note_on(0.001, 1, Midi::NOTE_A_3, 100);
+    synth.note_on(0.002, 1, Midi::NOTE_C_4, 110);
+    synth.note_on(0.003, 1, Midi::NOTE_E_4, 120);
+    synth.note_on(0.004, 1, Midi::NOTE_G_4, 127);
+    synth.note_on(0.005, 1, Midi::NOTE_B_4, 90);
+    synth.note_off(0.5, 1, Midi::NOTE_C_4, 64);
+    synth.note_off(0.6, 1, Midi::NOTE_G_4, 64);
+}
+
+
+TEST(when_voices_are_rendered_on_multiple_threads_then_output_is_the_same_as_when_rendered_on_a_single_thread, {
+    constexpr Integer block_size = 256;
+    constexpr Integer rounds = 80;
+    constexpr Integer buffer_size = block_size * rounds;
+
+    Synth synth_1;
+    Synth synth_2;
+    Buffer buffer_1(buffer_size, Synth::OUT_CHANNELS);
+    Buffer buffer_2(buffer_size, Synth::OUT_CHANNELS);
+
+    synth_2.set_voice_rendering_threads(3);
+    assert_eq(3, (int)synth_2.get_voice_rendering_threads());
+
+    set_up_multi_threaded_rendering_test(synth_1);
+    set_up_multi_threaded_rendering_test(synth_2);
+
+    render_rounds<Synth>(synth_1, buffer_1, rounds, block_size);
+    render_rounds<Synth>(synth_2, buffer_2, rounds, block_size);
+
+    for (Integer c = 0; c != Synth::OUT_CHANNELS; ++c) {
+        assert_eq(buffer_1.samples[c], buffer_2.samples[c], buffer_size, 0.0);
+    }
+
+    synth_2.set_voice_rendering_threads(Synth::MAX_VOICE_RENDERING_THREADS + 5);
+    assert_eq(
+        (int)Synth::MAX_VOICE_RENDERING_THREADS,
+        (int)synth_2.get_voice_rendering_threads()
+    );
+
+    synth_2.set_voice_rendering_threads(0);
+    assert_eq(0, (int)synth_2.get_voice_rendering_threads());
+})
+
+
+TEST(shared_envelopes_are_brought_up_to_date_before_the_voices_are_rendered, {
+    Synth synth;
+    Integer const change_index = synth.envelopes[0]->get_change_index();
+
+    synth.set_voice_rendering_threads(2);
+    set_param(synth, Synth::ParamId::N1ATK, 0.5);
+    synth.generate_samples(1, 128);
+
+    assert_neq((int)change_index, (int)synth.envelopes[0]->get_change_index());
+    assert_eq(
+        synth.envelopes[0]->delay_time.get_value()
+            + synth.envelopes[0]->attack_time.get_value()
+            + synth.envelopes[0]->hold_time.get_value()
+            + synth.envelopes[0]->decay_time.get_value(),
+        synth.envelopes[0]->get_dahd_length(),
+        DOUBLE_DELTA
+    );
+
+    synth.set_voice_rendering_threads(0);
+})
+
+
+TEST(default_number_of_voice_rendering_threads_is_within_limits, {
+    Integer const threads = Synth::get_default_voice_rendering_threads();
+
+    assert_gte((int)threads, 0);
+    assert_lte((int)threads, (int)Synth::MAX_VOICE_RENDERING_THREADS);
+})
+
+
+TEST(event_grid_is_set_for_each_synth_separately, {
+    Synth synth_1;
+    Synth synth_2;
+
+    synth_1.process_message(SET_EVENT_GRID, Synth::ParamId::MAX_PARAM_ID, 8.0, 0);
+
+    assert_eq(8, (int)synth_1.get_event_grid());
+    assert_eq(8, (int)synth_1.modulator_params.volume.get_event_grid());
+    assert_eq(8, (int)synth_1.effects.reverb.dry.get_event_grid());
+
+    assert_eq(1, (int)synth_2.get_event_grid());
+    assert_eq(1, (int)synth_2.modulator_params.volume.get_event_grid());
+    assert_eq(1, (int)synth_2.effects.reverb.dry.get_event_grid());
+
+    synth_1.process_message(SET_EVENT_GRID, Synth::ParamId::MAX_PARAM_ID, 0.0, 0);
+
+    assert_eq(1, (int)synth_1.get_event_grid());
+    assert_eq(1, (int)synth_1.modulator_params.volume.get_event_grid());
+})
+
+
 TEST(messages_get_processed_during_rendering, {
     Synth synth;
     Synth::Message message(SET_PARAM, Synth::ParamId::PM, 0.123, 0);
@@ -239,6 +363,91 @@ TEST(midi_controller_changes_can_affect_parameters, {
 })
 
 
+TEST(param_states_are_published_for_polling_without_messages, {
+    constexpr Integer block_size = 128;
+
+    Synth synth;
+    Synth::ParamStateChanges changes;
+    Synth::ControllerId controller_id;
+    Number ratio;
+
+    synth.resume();
+    synth.set_block_size(block_size);
+
+    synth.collect_param_state_changes(changes);
+    assert_true(changes.is_changed(Synth::ParamId::MIX));
+
+    synth.collect_param_state_changes(changes);
+    assert_true(changes.is_empty());
+
+    assign_controller(synth, Synth::ParamId::PM, Synth::ControllerId::VOLUME);
+    synth.push_message(SET_PARAM, Synth::ParamId::MIX, 0.42, 0);
+    SignalProducer::produce<Synth>(synth, 1);
+
+    synth.collect_param_state_changes(changes);
+    assert_true(changes.is_changed(Synth::ParamId::PM));
+    assert_true(changes.is_changed(Synth::ParamId::MIX));
+    assert_false(changes.is_changed(Synth::ParamId::FM));
+
+    synth.get_param_state_atomic(Synth::ParamId::MIX, ratio, controller_id);
+    assert_eq(0.42, ratio, DOUBLE_DELTA);
+    assert_eq(Synth::ControllerId::NONE, controller_id);
+
+    SignalProducer::produce<Synth>(synth, 2);
+    synth.collect_param_state_changes(changes);
+    assert_true(changes.is_empty());
+
+    synth.control_change(0.0, 1, Midi::VOLUME, 53);
+    SignalProducer::produce<Synth>(synth, 3);
+
+    synth.collect_param_state_changes(changes);
+    assert_true(changes.is_changed(Synth::ParamId::PM));
+    assert_false(changes.is_changed(Synth::ParamId::MIX));
+
+    synth.get_param_state_atomic(Synth::ParamId::PM, ratio, controller_id);
+    assert_eq(53.0 / 127.0, ratio, DOUBLE_DELTA);
+    assert_eq(Synth::ControllerId::VOLUME, controller_id);
+
+    assign_controller(synth, Synth::ParamId::PM, Synth::ControllerId::NONE);
+    SignalProducer::produce<Synth>(synth, 4);
+    synth.collect_param_state_changes(changes);
+    assert_true(changes.is_changed(Synth::ParamId::PM));
+    assert_eq(
+        Synth::ControllerId::NONE,
+        synth.get_param_controller_id_atomic(Synth::ParamId::PM)
+    );
+})
+
+
+TEST(when_a_controller_is_removed_from_a_leader_then_the_leader_is_still_rendered_until_it_settles, {
+    constexpr Integer block_size = 128;
+
+    Synth synth;
+    Integer round = 0;
+
+    synth.resume();
+    synth.set_block_size(block_size);
+
+    assign_controller(synth, Synth::ParamId::PM, Synth::ControllerId::VOLUME);
+    synth.process_messages();
+
+    synth.note_on(0.0, 1, Midi::NOTE_A_4, 114);
+    synth.control_change(0.0, 1, Midi::VOLUME, 127);
+    SignalProducer::produce<Synth>(synth, ++round);
+
+    assert_true(synth.phase_modulation_level.has_events_after(0.0));
+
+    assign_controller(synth, Synth::ParamId::PM, Synth::ControllerId::NONE);
+
+    for (Integer i = 0; i != 100; ++i) {
+        SignalProducer::produce<Synth>(synth, ++round);
+    }
+
+    assert_false(synth.phase_modulation_level.has_events_after(0.0));
+    assert_eq(1.0, synth.phase_modulation_level.get_ratio(), DOUBLE_DELTA);
+})
+
+
 TEST(can_look_up_param_id_by_name, {
     Synth synth;
     Integer max_collisions;
@@ -406,8 +615,8 @@ TEST(all_notes_off_message_turns_off_all_notes_at_the_specified_time, {
         expected_samples[i] = i < half_a_second ? sines[0][i] : 0.0;
     }
 
-    assert_eq(expected_samples, rendered_samples[0], block_size, DOUBLE_DELTA);
-    assert_eq(expected_samples, rendered_samples[1], block_size, DOUBLE_DELTA);
+    assert_eq(expected_samples, rendered_samples[0], block_size, SAMPLE_DELTA);
+    assert_eq(expected_samples, rendered_samples[1], block_size, SAMPLE_DELTA);
 
     delete[] expected_samples;
 })
@@ -535,6 +744,28 @@ TEST(when_the_same_controller_message_is_received_over_multiple_channels_then_on
 })
 
 
+TEST(dense_controller_automation_is_coalesced_into_linear_segments, {
+    Synth synth;
+
+    for (Integer i = 0; i != 64; ++i) {
+        synth.control_change(0.001 * (Seconds)i, 1, Midi::VOLUME, (Midi::Byte)i);
+        synth.pitch_wheel_change(0.001 * (Seconds)i, 1, (Midi::Word)(8192 + 64 * i));
+    }
+
+    for (Integer i = 0; i != 63; ++i) {
+        synth.control_change(0.064 + 0.001 * (Seconds)i, 1, Midi::VOLUME, (Midi::Byte)(62 - i));
+    }
+
+    assert_eq(3, synth.midi_controllers[Midi::VOLUME]->events.length());
+    assert_eq(2, synth.pitch_wheel.events.length());
+    assert_eq(
+        0.0,
+        synth.midi_controllers[Midi::VOLUME]->events.back().number_param_1,
+        DOUBLE_DELTA
+    );
+})
+
+
 TEST(when_synth_state_is_cleared_then_lfos_are_started_again, {
     Synth synth;
 
@@ -1044,7 +1275,7 @@ void test_peak_controller(
         default: break;
     }
 
-    assert_eq(expected_value, controller->get_value(), 0.005);
+    assert_eq(expected_value, controller->get_value(), PEAK_CTL_TEST_TOLERANCE);
 }
 
 
@@ -1064,3 +1295,128 @@ TEST(peak_controllers_are_updated_when_in_use, {
     test_peak_controller(Synth::ControllerId::VOL_2_PEAK, vol_2_expected);
     test_peak_controller(Synth::ControllerId::VOL_3_PEAK, vol_3_expected);
 })
+
+
+void set_up_long_release_for_amplitude(Synth& synth)
+{
+    set_param(synth, Synth::ParamId::N1DYN, 0.0);
+    set_param(synth, Synth::ParamId::N1AMT, 1.0);
+    set_param(synth, Synth::ParamId::N1INI, 0.0);
+    set_param(synth, Synth::ParamId::N1DEL, 0.0);
+    set_param(synth, Synth::ParamId::N1ATK, 0.0);
+    set_param(synth, Synth::ParamId::N1PK, 1.0);
+    set_param(synth, Synth::ParamId::N1HLD, 0.0);
+    set_param(synth, Synth::ParamId::N1DEC, 0.0);
+    set_param(synth, Synth::ParamId::N1SUS, 1.0);
+    set_param(synth, Synth::ParamId::N1REL, 1.0);
+    set_param(synth, Synth::ParamId::N1FIN, 0.0);
+
+    assign_controller(synth, Synth::ParamId::MAMP, Synth::ControllerId::ENVELOPE_1);
+    assign_controller(synth, Synth::ParamId::CAMP, Synth::ControllerId::ENVELOPE_1);
+}
+
+
+void render_released_note(
+        Synth& synth,
+        Integer const rounds,
+        Seconds const culling_window = 0.02,
+        Seconds const note_off_time_offset = 0.0
+) {
+    synth.set_sample_rate(22050.0);
+    synth.set_block_size(256);
+    synth.set_voice_culling_window(culling_window);
+    synth.process_messages();
+
+    synth.note_on(0.0, 1, Midi::NOTE_A_3, 100);
+    SignalProducer::produce<Synth>(synth, 1);
+    SignalProducer::produce<Synth>(synth, 2);
+
+    synth.note_off(note_off_time_offset, 1, Midi::NOTE_A_3, 100);
+
+    for (Integer round = 3; round != rounds + 3; ++round) {
+        SignalProducer::produce<Synth>(synth, round);
+    }
+}
+
+
+TEST(released_voices_which_stay_silent_are_culled, {
+    Synth synth;
+    Integer culled_voices;
+    Integer culled_voice_blocks;
+
+    set_param(synth, Synth::ParamId::MVOL, 0.0);
+    set_param(synth, Synth::ParamId::CVOL, 0.0);
+    set_up_long_release_for_amplitude(synth);
+
+    render_released_note(synth, 10);
+
+    synth.get_voice_culling_statistics(culled_voices, culled_voice_blocks);
+    assert_eq(2, culled_voices);
+    assert_gt(culled_voice_blocks, 2 * 100);
+})
+
+
+void assert_no_voices_were_culled(Synth const& synth)
+{
+    Integer culled_voices;
+    Integer culled_voice_blocks;
+
+    synth.get_voice_culling_statistics(culled_voices, culled_voice_blocks);
+    assert_eq(0, culled_voices);
+    assert_eq(0, culled_voice_blocks);
+}
+
+
+TEST(voices_are_not_culled_by_default, {
+    Synth synth;
+
+    set_param(synth, Synth::ParamId::MVOL, 0.0);
+    set_param(synth, Synth::ParamId::CVOL, 0.0);
+    set_up_long_release_for_amplitude(synth);
+
+    render_released_note(synth, 10, 0.0);
+
+    assert_no_voices_were_culled(synth);
+})
+
+
+TEST(silent_voices_are_not_culled_before_their_release_begins, {
+    Synth synth;
+
+    set_param(synth, Synth::ParamId::MVOL, 0.0);
+    set_param(synth, Synth::ParamId::CVOL, 0.0);
+    set_up_long_release_for_amplitude(synth);
+
+    render_released_note(synth, 10, 0.02, 1.0);
+
+    assert_no_voices_were_culled(synth);
+})
+
+
+TEST(silent_voices_are_not_culled_when_their_envelope_does_not_end_in_silence, {
+    Synth synth;
+
+    set_param(synth, Synth::ParamId::MVOL, 0.0);
+    set_param(synth, Synth::ParamId::CVOL, 0.0);
+    set_up_long_release_for_amplitude(synth);
+    set_param(synth, Synth::ParamId::N1FIN, 0.5);
+
+    render_released_note(synth, 10);
+
+    assert_no_voices_were_culled(synth);
+})
+
+
+TEST(released_voices_which_are_audible_are_not_culled, {
+    Synth synth;
+    Integer culled_voices;
+    Integer culled_voice_blocks;
+
+    set_up_long_release_for_amplitude(synth);
+
+    render_released_note(synth, 10);
+
+    synth.get_voice_culling_statistics(culled_voices, culled_voice_blocks);
+    assert_eq(0, culled_voices);
+    assert_eq(0, culled_voice_blocks);
+})
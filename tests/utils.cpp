@@ -32,6 +32,16 @@ namespace JS80P
 constexpr float FLOAT_DELTA = 0.000001f;
 constexpr double DOUBLE_DELTA = 0.000001;
 
+/*
+Long recursive signal chains (e.g. filters) accumulate more rounding error
+with single precision samples.
+*/
+#ifdef JS80P_FLOAT_SAMPLES
+constexpr double SAMPLE_DELTA = 0.00001;
+#else
+constexpr double SAMPLE_DELTA = DOUBLE_DELTA;
+#endif
+
 
 class Buffer
 {